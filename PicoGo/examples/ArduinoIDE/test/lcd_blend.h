@@ -0,0 +1,42 @@
+// Alpha blending and anti-aliased primitives.
+//
+// Every call here mixes its color into what the framebuffer already holds.
+// Blending is done in RGB565 whatever LCD_COLOR_DEPTH is: a pixel is spread
+// into one 32-bit word with gaps between the channels, so a single multiply
+// scales red, green and blue together. Alpha is reduced to 33 levels
+// (0-32) for that. With the RGB332 framebuffer the result is rounded back
+// to 332, so soft edges and fades come out in coarse steps; use
+// LCD_COLOR_DEPTH 16 where they matter.
+//
+// Alpha masks for lcd_blit_alpha, row-major:
+//   LCD_ALPHA_A8  one byte per pixel, 0 transparent to 255 opaque
+//   LCD_ALPHA_A4  two pixels per byte, the left one in the high nibble,
+//                 0 transparent to 15 opaque; each row starts on a new byte
+#pragma once
+
+#include <stdint.h>
+#include "lcd.h"
+
+#define LCD_ALPHA_A8 0
+#define LCD_ALPHA_A4 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Mix color into a rectangle, alpha 0 (no change) to 255 (lcd_fill_rect)
+    void lcd_fill_rect_blend(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color, uint8_t alpha);
+
+    // Draw color through an alpha mask, e.g. an anti-aliased icon or glyph.
+    // Clipped to the screen; the mask is referenced in tiled mode.
+    void lcd_blit_alpha(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *alpha, uint8_t format,
+                        uint16_t color);
+
+    // Anti-aliased outlines one pixel wide and a filled disc with a soft edge
+    void lcd_draw_line_aa(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void lcd_draw_circle_aa(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color);
+    void lcd_fill_circle_aa(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,1222 @@
+#include "lcd_internal.h"
+#include "lcd_memset.h"
+#include "lcd_glyph.h"
+#include <string.h>
+#include <math.h>
+
+#if !LCD_TILED
+lcd_pixel_t lcd_framebuffer[LCD_WIDTH * LCD_HEIGHT];
+#endif
+
+static FontTable *current_font = NULL;
+
+static dirty_area_t dirty_areas[LCD_MAX_DIRTY_AREAS];
+static uint8_t dirty_count = 0;
+
+/******************************************************************************
+function: Add a region to the dirty list flushed by the next lcd_swap
+parameter:
+    x0, y0 : Top-left corner (inclusive, may lie off-screen)
+    x1, y1 : Bottom-right corner (inclusive, may lie off-screen)
+returns: none
+note: The region is clipped and aligned to LCD_DIRTY_ALIGN. Overlapping or
+      touching regions are merged; when the list is full the region is
+      merged into the entry whose bounding box grows the least.
+******************************************************************************/
+void lcd_dirty_add(int x0, int y0, int x1, int y1)
+{
+    // Every drawing call passes through here first, so a background fill
+    // is finished before anything else touches the framebuffer
+    lcd_memset_wait();
+
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 >= LCD_VIEW_WIDTH)
+        x1 = LCD_VIEW_WIDTH - 1;
+    if (y1 >= LCD_VIEW_HEIGHT)
+        y1 = LCD_VIEW_HEIGHT - 1;
+#if LCD_TILED
+    // The clipped area is what the drawing call records, and while the
+    // display list is replayed the dirty list belongs to the next frame
+    if (!lcd_tile_set_box(x0, y0, x1, y1))
+        return;
+#endif
+    if (x0 > x1 || y0 > y1)
+        return; // nothing on screen
+    LCD_PROFILE_PIXELS((uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1));
+
+    // Some controllers only accept windows on even boundaries
+    x0 &= ~(LCD_DIRTY_ALIGN - 1);
+    y0 &= ~(LCD_DIRTY_ALIGN - 1);
+    x1 |= LCD_DIRTY_ALIGN - 1;
+    y1 |= LCD_DIRTY_ALIGN - 1;
+
+    while (true)
+    {
+        int hit = -1;
+        for (uint8_t i = 0; i < dirty_count; i++)
+        {
+            const dirty_area_t *area = &dirty_areas[i];
+            if (x0 <= area->x1 + 1 && x1 + 1 >= area->x0 && y0 <= area->y1 + 1 && y1 + 1 >= area->y0)
+            {
+                hit = i;
+                break;
+            }
+        }
+
+        if (hit < 0 && dirty_count == LCD_MAX_DIRTY_AREAS)
+        {
+            // List is full, pick the merge that adds the fewest pixels
+            uint32_t best_growth = UINT32_MAX;
+            for (uint8_t i = 0; i < dirty_count; i++)
+            {
+                const dirty_area_t *area = &dirty_areas[i];
+                int ux0 = x0 < area->x0 ? x0 : area->x0;
+                int uy0 = y0 < area->y0 ? y0 : area->y0;
+                int ux1 = x1 > area->x1 ? x1 : area->x1;
+                int uy1 = y1 > area->y1 ? y1 : area->y1;
+                uint32_t growth = (uint32_t)(ux1 - ux0 + 1) * (uy1 - uy0 + 1) -
+                                  (uint32_t)(area->x1 - area->x0 + 1) * (area->y1 - area->y0 + 1);
+                if (growth < best_growth)
+                {
+                    best_growth = growth;
+                    hit = i;
+                }
+            }
+        }
+
+        if (hit < 0)
+            break;
+
+        // Absorb the entry and retry, the grown box may now touch another one
+        const dirty_area_t *area = &dirty_areas[hit];
+        if (area->x0 < x0)
+            x0 = area->x0;
+        if (area->y0 < y0)
+            y0 = area->y0;
+        if (area->x1 > x1)
+            x1 = area->x1;
+        if (area->y1 > y1)
+            y1 = area->y1;
+        dirty_areas[hit] = dirty_areas[--dirty_count];
+    }
+
+    dirty_areas[dirty_count].x0 = x0;
+    dirty_areas[dirty_count].y0 = y0;
+    dirty_areas[dirty_count].x1 = x1;
+    dirty_areas[dirty_count].y1 = y1;
+    dirty_count++;
+}
+
+/******************************************************************************
+function: Move the dirty list into a caller buffer and clear it
+parameter:
+    areas : Destination array with room for LCD_MAX_DIRTY_AREAS entries
+returns: Number of regions copied
+******************************************************************************/
+uint8_t lcd_dirty_take(dirty_area_t *areas)
+{
+    lcd_memset_wait();
+    uint8_t count = dirty_count;
+    memcpy(areas, dirty_areas, count * sizeof(dirty_area_t));
+    dirty_count = 0;
+    return count;
+}
+
+/******************************************************************************
+function: Mark a framebuffer region as changed
+parameter:
+    x      : Top-left X coordinate
+    y      : Top-left Y coordinate
+    width  : Width of the region
+    height : Height of the region
+returns: none
+note: The drawing functions do this themselves. Only needed when the
+      framebuffer is modified by other means.
+******************************************************************************/
+void lcd_mark_dirty(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+    if (width == 0 || height == 0)
+        return;
+    lcd_dirty_add(x, y, x + width - 1, y + height - 1);
+}
+
+/******************************************************************************
+function: Mark the whole screen as changed
+parameter: none
+returns: none
+note: The next lcd_swap sends the full framebuffer
+******************************************************************************/
+void lcd_invalidate(void)
+{
+    dirty_count = 0;
+    lcd_dirty_add(0, 0, LCD_VIEW_WIDTH - 1, LCD_VIEW_HEIGHT - 1);
+}
+
+/******************************************************************************
+function: Get the framebuffer for writing pixels directly
+parameter: none
+returns: lcd_get_width() x lcd_get_height() pixels row by row, each one
+         lcd_framebuffer_color of its color; NULL with LCD_TILED
+note: Direct writes are not tracked, mark them with lcd_mark_dirty or
+      lcd_invalidate before the next swap. A background lcd_fill must be
+      finished first, see lcd_fill_wait.
+******************************************************************************/
+void *lcd_get_framebuffer(void)
+{
+#if LCD_TILED
+    return NULL;
+#else
+    return lcd_framebuffer;
+#endif
+}
+
+/******************************************************************************
+function: Convert a color to the value stored in the framebuffer
+parameter:
+    color : RGB565 color value
+returns: RGB332 byte, or RGB565 in panel byte order with LCD_COLOR_DEPTH 16
+******************************************************************************/
+uint16_t lcd_framebuffer_color(uint16_t color)
+{
+    return lcd_color_to_pixel(color);
+}
+
+/******************************************************************************
+function: Draw a single pixel to the framebuffer
+parameter:
+    X     : X coordinate (0 to lcd_get_width()-1)
+    Y     : Y coordinate (0 to lcd_get_height()-1)
+    color : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_draw_pixel(uint16_t x, uint16_t y, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    if (x >= LCD_VIEW_WIDTH || y >= LCD_VIEW_HEIGHT)
+    {
+        return; // bounds check
+    }
+    lcd_dirty_add(x, y, x, y);
+    if (LCD_TILE_RECORD(LCD_TILE_PIXEL, NULL, 0, x, y, color))
+        return;
+    // Convert to 8-bit and store
+    *LCD_PIXEL_AT(x, y) = lcd_color_to_pixel(color);
+}
+
+/******************************************************************************
+function: Draw a line between two points using Bresenham's algorithm
+parameter:
+    x1    : Starting X coordinate
+    y1    : Starting Y coordinate
+    x2    : Ending X coordinate
+    y2    : Ending Y coordinate
+    color : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    int dx = abs((int)x2 - (int)x1);
+    int dy = abs((int)y2 - (int)y1);
+    int sx = (x1 < x2) ? 1 : -1;
+    int sy = (y1 < y2) ? 1 : -1;
+    int err = dx - dy;
+    const lcd_pixel_t pixel = lcd_color_to_pixel(color);
+    lcd_dirty_add(x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2, x1 > x2 ? x1 : x2, y1 > y2 ? y1 : y2);
+    if (LCD_TILE_RECORD(LCD_TILE_LINE, NULL, 0, x1, y1, x2, y2, color))
+        return;
+    while (true)
+    {
+        // Draw pixel if within bounds
+        if (x1 < LCD_VIEW_WIDTH && lcd_row_visible(y1))
+        {
+            *LCD_PIXEL_AT(x1, y1) = pixel;
+        }
+
+        // Check if we've reached the end point
+        if (x1 == x2 && y1 == y2)
+            break;
+
+        int e2 = 2 * err;
+        if (e2 > -dy)
+        {
+            err -= dy;
+            x1 += sx;
+        }
+        if (e2 < dx)
+        {
+            err += dx;
+            y1 += sy;
+        }
+    }
+}
+
+/******************************************************************************
+function: Draw a rectangle outline to the framebuffer
+parameter:
+    x      : Top-left X coordinate
+    y      : Top-left Y coordinate
+    width  : Width of rectangle
+    height : Height of rectangle
+    color  : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    // Draw four lines to form rectangle
+    lcd_draw_line(x, y, x + width - 1, y, color);                           // Top
+    lcd_draw_line(x, y + height - 1, x + width - 1, y + height - 1, color); // Bottom
+    lcd_draw_line(x, y, x, y + height - 1, color);                          // Left
+    lcd_draw_line(x + width - 1, y, x + width - 1, y + height - 1, color);  // Right
+}
+
+/******************************************************************************
+function: Repeat a framebuffer pixel across a 32-bit word
+parameter:
+    pixel : Framebuffer pixel value
+returns: Fill pattern for lcd_memset_rows_start
+******************************************************************************/
+static inline uint32_t lcd_pixel_pattern(lcd_pixel_t pixel)
+{
+    return sizeof(lcd_pixel_t) == 1 ? pixel * 0x01010101u : pixel * 0x00010001u;
+}
+
+/******************************************************************************
+function: Draw a filled rectangle to the framebuffer
+parameter:
+    x      : Top-left X coordinate
+    y      : Top-left Y coordinate
+    width  : Width of rectangle
+    height : Height of rectangle
+    color  : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_FILL);
+    // Bounds clipping
+    if (x >= LCD_VIEW_WIDTH || y >= LCD_VIEW_HEIGHT)
+        return;
+
+    if (x + width > LCD_VIEW_WIDTH)
+        width = LCD_VIEW_WIDTH - x;
+    if (y + height > LCD_VIEW_HEIGHT)
+        height = LCD_VIEW_HEIGHT - y;
+
+    const lcd_pixel_t pixel = lcd_color_to_pixel(color);
+    lcd_dirty_add(x, y, x + width - 1, y + height - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_FILL_RECT, NULL, 0, x, y, width, height, color))
+        return;
+
+#if LCD_TILED
+    // Rows of the band, filled by the CPU: the band is rendered from the
+    // panel DMA interrupt, where the DMA fill engine cannot be waited for
+    int y0 = y > LCD_ROWS_BEGIN ? y : LCD_ROWS_BEGIN;
+    int y1 = y + height < LCD_ROWS_END ? y + height : LCD_ROWS_END;
+    for (int row = y0; row < y1; row++)
+        lcd_memset32(LCD_PIXEL_AT(x, row), lcd_pixel_pattern(pixel), width * sizeof(lcd_pixel_t));
+#else
+    // One DMA transfer per row, or a single one when the rows are contiguous
+    lcd_pixel_t *start = &lcd_framebuffer[y * LCD_VIEW_WIDTH + x];
+    if (width == LCD_VIEW_WIDTH)
+        lcd_memset_rows_start(start, 0, (size_t)height * LCD_VIEW_WIDTH * sizeof(lcd_pixel_t), 1, lcd_pixel_pattern(pixel));
+    else
+        lcd_memset_rows_start(start, LCD_VIEW_WIDTH * sizeof(lcd_pixel_t), width * sizeof(lcd_pixel_t), height, lcd_pixel_pattern(pixel));
+#endif
+}
+
+/******************************************************************************
+function: Draw a glyph of the current font with a converted pixel value
+parameter:
+    x, y  : Top-left corner, clipped to the screen (or the band)
+    c     : Character to draw
+    pixel : Framebuffer pixel value
+returns: none
+note: Does not mark anything dirty, the caller does
+******************************************************************************/
+static inline void lcd_draw_glyph(int x, int y, char c, lcd_pixel_t pixel)
+{
+    lcd_pixel_t *rows = LCD_PIXEL_AT(0, LCD_ROWS_BEGIN);
+#if LCD_COLOR_DEPTH == 16
+    lcd_glyph_draw16(rows, LCD_VIEW_WIDTH, LCD_ROWS_END - LCD_ROWS_BEGIN, x, y - LCD_ROWS_BEGIN, current_font, c, pixel);
+#else
+    lcd_glyph_draw8(rows, LCD_VIEW_WIDTH, LCD_ROWS_END - LCD_ROWS_BEGIN, x, y - LCD_ROWS_BEGIN, current_font, c, pixel);
+#endif
+}
+
+/******************************************************************************
+function: Draw a single character to the framebuffer
+parameter:
+    x     : Top-left X coordinate
+    y     : Top-left Y coordinate
+    c     : Character to draw
+    color : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_draw_char(uint16_t x, uint16_t y, char c, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_TEXT);
+    if (current_font == NULL || c < 32 || c > 126)
+        return; // invalid font or character
+
+    lcd_dirty_add(x, y, x + current_font->width - 1, y + current_font->height - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_CHAR, NULL, 0, x, y, c, color, (intptr_t)current_font))
+        return;
+    lcd_draw_glyph(x, y, c, lcd_color_to_pixel(color));
+}
+
+/******************************************************************************
+function: Fill a horizontal run of pixels, clipped to the screen
+parameter:
+    y      : Row
+    x0, x1 : First and last column (inclusive, may lie off-screen)
+    pixel  : Framebuffer pixel value
+returns: none
+note: Does not mark anything dirty, the caller does
+******************************************************************************/
+static inline void lcd_span(int y, int x0, int x1, lcd_pixel_t pixel)
+{
+    if (y < LCD_ROWS_BEGIN || y >= LCD_ROWS_END)
+        return;
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 >= LCD_VIEW_WIDTH)
+        x1 = LCD_VIEW_WIDTH - 1;
+    if (x0 > x1)
+        return;
+
+    lcd_pixel_t *p = LCD_PIXEL_AT(x0, y);
+    int count = x1 - x0 + 1;
+#if LCD_COLOR_DEPTH != 16
+    if (count > 16)
+    {
+        memset(p, pixel, count);
+        return;
+    }
+#endif
+    // Outlines are mostly runs of one or two pixels, not worth a call
+    while (count--)
+        *p++ = pixel;
+}
+
+// Angular sector of an arc, as two half-planes through the center. A point
+// (dx, dy) relative to the center is inside when both n0 and n1 give a
+// non-negative dot product, or, for an inverted sector, when not both do.
+typedef struct
+{
+    float n0x, n0y;
+    float n1x, n1y;
+    bool inverted;
+} arc_sector_t;
+
+/******************************************************************************
+function: Build the sector of an arc
+parameter:
+    sector      : Sector to fill in
+    start_angle : Start angle in degrees, clockwise from 12 o'clock
+    end_angle   : End angle in degrees, clockwise from 12 o'clock
+returns: false when the arc covers the whole circle (no sector needed)
+******************************************************************************/
+static bool lcd_arc_sector(arc_sector_t *sector, int start_angle, int end_angle)
+{
+    int sweep = end_angle - start_angle;
+    if (sweep >= 360 || sweep <= -360)
+        return false;
+    sweep = (sweep % 360 + 360) % 360;
+
+    // Sweeps over 180 degrees are drawn as everything except the gap
+    sector->inverted = sweep > 180;
+    if (sector->inverted)
+    {
+        int gap_start = start_angle + sweep;
+        start_angle = gap_start;
+        end_angle = gap_start + (360 - sweep);
+    }
+    else
+    {
+        end_angle = start_angle + sweep;
+    }
+
+    // Direction of an angle on screen (y down) is (sin, -cos); the normals
+    // point into the sector from the start and end edges
+    const float deg = 3.14159265f / 180.0f;
+    float sx = sinf(start_angle * deg), sy = -cosf(start_angle * deg);
+    float ex = sinf(end_angle * deg), ey = -cosf(end_angle * deg);
+    sector->n0x = -sy;
+    sector->n0y = sx;
+    sector->n1x = ey;
+    sector->n1y = -ex;
+    return true;
+}
+
+/******************************************************************************
+function: Columns of one row that satisfy a half-plane
+parameter:
+    nx, ny : Half-plane normal, inside when nx * dx + ny * dy >= 0
+    dy     : Row relative to the center
+    lo, hi : In/out column range relative to the center, narrowed in place
+returns: none
+******************************************************************************/
+static inline void lcd_half_plane_clip(float nx, float ny, int dy, int *lo, int *hi)
+{
+    float c = -ny * dy;
+    if (nx > 1e-6f)
+    {
+        int bound = (int)ceilf(c / nx - 1e-4f);
+        if (bound > *lo)
+            *lo = bound;
+    }
+    else if (nx < -1e-6f)
+    {
+        int bound = (int)floorf(c / nx + 1e-4f);
+        if (bound < *hi)
+            *hi = bound;
+    }
+    else if (c > 0)
+    {
+        *hi = *lo - 1; // row entirely outside
+    }
+}
+
+/******************************************************************************
+function: Fill the part of a span that lies inside an arc sector
+parameter:
+    sector    : Sector, NULL for no restriction
+    cx, cy    : Center of the arc
+    dy        : Row relative to the center
+    dx0, dx1  : Span relative to the center (inclusive)
+    pixel     : Framebuffer pixel value
+returns: none
+******************************************************************************/
+static inline void lcd_sector_span(const arc_sector_t *sector, int cx, int cy, int dy, int dx0, int dx1, lcd_pixel_t pixel)
+{
+    if (dx0 > dx1)
+        return;
+    if (sector == NULL)
+    {
+        lcd_span(cy + dy, cx + dx0, cx + dx1, pixel);
+        return;
+    }
+
+    if (!sector->inverted)
+    {
+        int lo = dx0, hi = dx1;
+        lcd_half_plane_clip(sector->n0x, sector->n0y, dy, &lo, &hi);
+        lcd_half_plane_clip(sector->n1x, sector->n1y, dy, &lo, &hi);
+        if (lo <= hi)
+            lcd_span(cy + dy, cx + lo, cx + hi, pixel);
+        return;
+    }
+
+    // Inverted: the normals describe the gap, which is at most one interval
+    // per row. Draw the span minus that interval.
+    int lo = dx0, hi = dx1;
+    lcd_half_plane_clip(sector->n0x, sector->n0y, dy, &lo, &hi);
+    lcd_half_plane_clip(sector->n1x, sector->n1y, dy, &lo, &hi);
+    if (lo > hi)
+    {
+        lcd_span(cy + dy, cx + dx0, cx + dx1, pixel);
+        return;
+    }
+    if (lo > dx0)
+        lcd_span(cy + dy, cx + dx0, cx + lo - 1, pixel);
+    if (hi < dx1)
+        lcd_span(cy + dy, cx + hi + 1, cx + dx1, pixel);
+}
+
+/******************************************************************************
+function: Rasterize a disc, ring or circle outline as horizontal spans
+parameter:
+    cx, cy        : Center
+    outer_radius  : Outer radius in pixels
+    inner_radius  : Radius of the hole; -1 for a filled disc, equal to
+                    outer_radius for a one pixel outline
+    sector        : Arc sector to restrict to, NULL for the whole circle
+    pixel         : Framebuffer pixel value
+returns: none
+note: Covers the pixels with dx*dx + dy*dy <= outer_radius^2 that are not
+      inside the hole. The outer boundary is always kept connected, so thin
+      rings have no gaps on the diagonals. The extent of each row is found
+      incrementally, one pass from the middle row outwards.
+******************************************************************************/
+static void lcd_circle_spans(int cx, int cy, int outer_radius, int inner_radius, const arc_sector_t *sector, lcd_pixel_t pixel)
+{
+    const uint32_t outer_squared = (uint32_t)outer_radius * outer_radius;
+    const uint32_t inner_squared = inner_radius >= 0 ? (uint32_t)inner_radius * inner_radius : 0;
+    int outer = outer_radius; // outer half-width of the current row
+    int hole = inner_radius;  // hole half-width of the current row
+
+    for (int dy = 0; dy <= outer_radius; dy++)
+    {
+        uint32_t dy_squared = (uint32_t)dy * dy;
+
+        // Outer half-width of the next row, which becomes the current one
+        // on the following iteration
+        int next_outer = -1;
+        if (dy < outer_radius)
+        {
+            uint32_t next_squared = (uint32_t)(dy + 1) * (dy + 1);
+            next_outer = outer;
+            while ((uint32_t)next_outer * next_outer + next_squared > outer_squared)
+                next_outer--;
+        }
+
+        // Columns [start, outer] on each side of the center are drawn
+        int start = 0;
+        if (inner_radius >= 0 && dy <= inner_radius)
+        {
+            while (hole >= 0 && (uint32_t)hole * hole + dy_squared > inner_squared)
+                hole--;
+            // The first outline pixel of this row, where it meets the next row
+            int edge = next_outer + 1 < outer ? next_outer + 1 : outer;
+            start = hole + 1 < edge ? hole + 1 : edge;
+        }
+
+        if (start == 0)
+        {
+            lcd_sector_span(sector, cx, cy, dy, -outer, outer, pixel);
+            if (dy != 0)
+                lcd_sector_span(sector, cx, cy, -dy, -outer, outer, pixel);
+        }
+        else
+        {
+            lcd_sector_span(sector, cx, cy, dy, -outer, -start, pixel);
+            lcd_sector_span(sector, cx, cy, dy, start, outer, pixel);
+            if (dy != 0)
+            {
+                lcd_sector_span(sector, cx, cy, -dy, -outer, -start, pixel);
+                lcd_sector_span(sector, cx, cy, -dy, start, outer, pixel);
+            }
+        }
+        outer = next_outer;
+    }
+}
+
+/******************************************************************************
+function: Draw a circle outline to the framebuffer
+parameter:
+    center_x : Center X coordinate
+    center_y : Center Y coordinate
+    radius   : Radius in pixels
+    color    : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_draw_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    if (radius == 0)
+        return;
+
+    lcd_dirty_add(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+    if (LCD_TILE_RECORD(LCD_TILE_CIRCLE, NULL, 0, center_x, center_y, radius, color))
+        return;
+    lcd_circle_spans(center_x, center_y, radius, radius, NULL, lcd_color_to_pixel(color));
+}
+
+/******************************************************************************
+function: Draw a string with the current font, wrapping at the screen edge
+parameter:
+    x     : Top-left X coordinate, also the start of wrapped lines
+    y     : Top-left Y coordinate
+    text  : Null-terminated string, '\n' starts a new line
+    color : RGB565 color value
+returns: none
+note: The color is converted and the dirty region recorded once per string
+******************************************************************************/
+void lcd_draw_text(uint16_t x, uint16_t y, const char *text, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_TEXT);
+    if (current_font == NULL)
+        return; // invalid font
+
+    const char *start = text;
+    uint16_t cursor_x = x;
+    uint16_t cursor_y = y;
+    const lcd_pixel_t pixel = lcd_color_to_pixel(color);
+    int dirty_x0 = LCD_VIEW_WIDTH, dirty_y0 = LCD_VIEW_HEIGHT, dirty_x1 = -1, dirty_y1 = -1;
+
+    lcd_memset_wait(); // the glyphs are written before the region is marked dirty
+
+    while (*text)
+    {
+        char ch = *text;
+
+        if (ch == '\n')
+        {
+            cursor_x = x;                     // Reset to start of line
+            cursor_y += current_font->height; // Move down one line
+        }
+        else if (ch == ' ')
+        {
+            // Handle space - just advance position without drawing
+            cursor_x += current_font->width;
+        }
+        else
+        {
+            // Check if character would exceed screen width
+            if (cursor_x + current_font->width > LCD_VIEW_WIDTH)
+            {
+                // Wrap to next line
+                cursor_x = x;
+                cursor_y += current_font->height;
+            }
+
+            // Check if we're still within screen height
+            if (cursor_y + current_font->height <= LCD_VIEW_HEIGHT)
+            {
+                if (!lcd_tile_recording())
+                    lcd_draw_glyph(cursor_x, cursor_y, ch, pixel);
+                if (cursor_x < dirty_x0)
+                    dirty_x0 = cursor_x;
+                if (cursor_y < dirty_y0)
+                    dirty_y0 = cursor_y;
+                if (cursor_x + current_font->width - 1 > dirty_x1)
+                    dirty_x1 = cursor_x + current_font->width - 1;
+                if (cursor_y + current_font->height - 1 > dirty_y1)
+                    dirty_y1 = cursor_y + current_font->height - 1;
+            }
+
+            cursor_x += current_font->width;
+        }
+        text++;
+    }
+
+    // One region for the whole string. In tiled mode the glyphs were
+    // skipped above and are drawn when the list is replayed.
+    if (dirty_x1 >= 0)
+    {
+        lcd_dirty_add(dirty_x0, dirty_y0, dirty_x1, dirty_y1);
+        (void)LCD_TILE_RECORD(LCD_TILE_TEXT, start, text - start + 1, x, y, color, (intptr_t)current_font);
+    }
+}
+
+/******************************************************************************
+function: Draw a filled circle to the framebuffer
+parameter:
+    center_x : Center X coordinate
+    center_y : Center Y coordinate
+    radius   : Radius in pixels
+    color    : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_fill_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    if (radius == 0)
+        return;
+
+    lcd_dirty_add(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+    if (LCD_TILE_RECORD(LCD_TILE_FILL_CIRCLE, NULL, 0, center_x, center_y, radius, color))
+        return;
+    lcd_circle_spans(center_x, center_y, radius, -1, NULL, lcd_color_to_pixel(color));
+}
+
+/******************************************************************************
+function: Draw a ring (thick circle outline) to the framebuffer
+parameter:
+    center_x  : Center X coordinate
+    center_y  : Center Y coordinate
+    radius    : Outer radius in pixels
+    thickness : Width of the ring in pixels, grows inwards
+    color     : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_draw_ring(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t thickness, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    if (radius == 0 || thickness == 0)
+        return;
+
+    lcd_dirty_add(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+    if (LCD_TILE_RECORD(LCD_TILE_RING, NULL, 0, center_x, center_y, radius, thickness, color))
+        return;
+    lcd_circle_spans(center_x, center_y, radius, thickness >= radius ? -1 : radius - thickness, NULL,
+                     lcd_color_to_pixel(color));
+}
+
+/******************************************************************************
+function: Draw an arc of a ring to the framebuffer
+parameter:
+    center_x    : Center X coordinate
+    center_y    : Center Y coordinate
+    radius      : Outer radius in pixels
+    thickness   : Width of the arc in pixels, grows inwards
+    start_angle : Start angle in degrees, clockwise from 12 o'clock
+    end_angle   : End angle in degrees, clockwise from 12 o'clock
+    color       : RGB565 color value
+returns: none
+note: The arc runs clockwise from start_angle to end_angle and has square
+      (radial) ends. A sweep of 360 degrees or more draws the whole ring,
+      equal angles draw nothing. Angles may be negative or above 360.
+******************************************************************************/
+void lcd_draw_arc(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t thickness,
+                  int16_t start_angle, int16_t end_angle, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    if (radius == 0 || thickness == 0 || start_angle == end_angle)
+        return;
+
+    lcd_dirty_add(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+    if (LCD_TILE_RECORD(LCD_TILE_ARC, NULL, 0, center_x, center_y, radius, thickness, start_angle, end_angle, color))
+        return;
+
+    arc_sector_t sector;
+    bool partial = lcd_arc_sector(&sector, start_angle, end_angle);
+    lcd_circle_spans(center_x, center_y, radius, thickness >= radius ? -1 : radius - thickness,
+                     partial ? &sector : NULL, lcd_color_to_pixel(color));
+}
+
+// Polygon edge for scanline walking. Positions are 16.16 fixed point with
+// pixel (x, y) covering [x, x + 1) x [y, y + 1); rows are sampled at their
+// centers, y + 0.5.
+typedef struct
+{
+    int32_t x;    // X where the edge crosses the center of row y_start
+    int32_t step; // X change per row
+    int y_start;  // First row whose center is on the edge
+    int y_end;    // First row past the edge
+} raster_edge_t;
+
+#define LCD_FIXED(v) ((int32_t)(v) * 65536)
+
+// First pixel whose center is at or right of a 16.16 position, ceil(v - 0.5).
+// Used for rows and columns alike, this is the top-left fill rule: a pixel
+// center exactly on a left or top edge is inside, one on a right or bottom
+// edge is not, so shapes sharing an edge never overlap or leave a gap.
+#define LCD_FIXED_CENTER_CEIL(v) (((v) + 0x7FFF) >> 16)
+
+/******************************************************************************
+function: Set up an edge for walking down the rows it crosses
+parameter:
+    edge   : Edge to fill in
+    xa, ya : First end point, 16.16 fixed point
+    xb, yb : Second end point, 16.16 fixed point
+returns: false when the edge crosses no row center
+******************************************************************************/
+static bool lcd_edge_setup(raster_edge_t *edge, int32_t xa, int32_t ya, int32_t xb, int32_t yb)
+{
+    if (ya > yb)
+    {
+        int32_t t = xa;
+        xa = xb;
+        xb = t;
+        t = ya;
+        ya = yb;
+        yb = t;
+    }
+
+    edge->y_start = LCD_FIXED_CENTER_CEIL(ya);
+    edge->y_end = LCD_FIXED_CENTER_CEIL(yb);
+    if (edge->y_start >= edge->y_end)
+        return false; // horizontal, or between two row centers
+
+    // The only division, the rows below just add the step
+    edge->step = (int32_t)(((int64_t)(xb - xa) * 65536) / (yb - ya));
+    int32_t first_center = LCD_FIXED(edge->y_start) + 0x8000;
+    edge->x = xa + (int32_t)(((int64_t)(first_center - ya) * edge->step) / 65536);
+    return true;
+}
+
+/******************************************************************************
+function: Move an edge forward to a later row
+parameter:
+    edge : Edge set up by lcd_edge_setup
+    y    : Row to start from, at or after edge->y_start
+returns: none
+******************************************************************************/
+static inline void lcd_edge_skip_to(raster_edge_t *edge, int y)
+{
+    if (y > edge->y_start)
+    {
+        edge->x += (int32_t)((int64_t)(y - edge->y_start) * edge->step);
+        edge->y_start = y;
+    }
+}
+
+/******************************************************************************
+function: Fill the pixels whose centers lie between two edges on one row range
+parameter:
+    left, right : Edges bounding the span on the left and right
+    y0, y1      : Rows to fill, [y0, y1), already clipped to the screen
+    pixel       : Framebuffer pixel value
+returns: none
+******************************************************************************/
+static void lcd_edge_pair_fill(raster_edge_t *left, raster_edge_t *right, int y0, int y1, lcd_pixel_t pixel)
+{
+    if (y0 >= y1)
+        return;
+    lcd_edge_skip_to(left, y0);
+    lcd_edge_skip_to(right, y0);
+
+    int32_t xl = left->x, xr = right->x;
+    for (int y = y0; y < y1; y++)
+    {
+        lcd_span(y, LCD_FIXED_CENTER_CEIL(xl), LCD_FIXED_CENTER_CEIL(xr) - 1, pixel);
+        xl += left->step;
+        xr += right->step;
+    }
+    left->x = xl;
+    left->y_start = y1;
+    right->x = xr;
+    right->y_start = y1;
+}
+
+/******************************************************************************
+function: Rasterize a triangle with 16.16 fixed-point vertices
+parameter:
+    x0..y2 : Vertex coordinates, 16.16 fixed point, any winding
+    pixel  : Framebuffer pixel value
+returns: none
+note: Rows and columns are clipped to the screen; vertices may lie anywhere
+      in the int16_t range.
+******************************************************************************/
+static void lcd_raster_triangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2,
+                                lcd_pixel_t pixel)
+{
+    // Sort vertices by Y (y0 <= y1 <= y2)
+    int32_t t;
+    if (y0 > y1)
+    {
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+    if (y1 > y2)
+    {
+        t = x1, x1 = x2, x2 = t;
+        t = y1, y1 = y2, y2 = t;
+    }
+    if (y0 > y1)
+    {
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+
+    // Which side of the long edge v0-v2 the middle vertex is on
+    int64_t cross = (int64_t)(x1 - x0) * (y2 - y0) - (int64_t)(y1 - y0) * (x2 - x0);
+    if (cross == 0)
+        return; // no area
+
+    raster_edge_t long_edge, upper, lower;
+    if (!lcd_edge_setup(&long_edge, x0, y0, x2, y2))
+        return;
+
+    int top = long_edge.y_start < LCD_ROWS_BEGIN ? LCD_ROWS_BEGIN : long_edge.y_start;
+    int bottom = long_edge.y_end > LCD_ROWS_END ? LCD_ROWS_END : long_edge.y_end;
+    bool long_left = cross > 0;
+
+    if (lcd_edge_setup(&upper, x0, y0, x1, y1))
+    {
+        int y_end = upper.y_end < bottom ? upper.y_end : bottom;
+        if (long_left)
+            lcd_edge_pair_fill(&long_edge, &upper, top, y_end, pixel);
+        else
+            lcd_edge_pair_fill(&upper, &long_edge, top, y_end, pixel);
+    }
+    if (lcd_edge_setup(&lower, x1, y1, x2, y2))
+    {
+        int y_start = lower.y_start > top ? lower.y_start : top;
+        if (long_left)
+            lcd_edge_pair_fill(&long_edge, &lower, y_start, bottom, pixel);
+        else
+            lcd_edge_pair_fill(&lower, &long_edge, y_start, bottom, pixel);
+    }
+}
+
+/******************************************************************************
+function: Rasterize a polygon with 16.16 fixed-point vertices
+parameter:
+    xs, ys : Vertex coordinates, 16.16 fixed point
+    count  : Number of vertices, at most LCD_POLYGON_MAX_POINTS
+    pixel  : Framebuffer pixel value
+returns: none
+note: Uses the even-odd rule, so self-intersecting outlines leave holes where
+      they overlap. Convex, concave and self-intersecting polygons all work.
+******************************************************************************/
+static void lcd_raster_polygon(const int32_t *xs, const int32_t *ys, int count, lcd_pixel_t pixel)
+{
+    raster_edge_t edges[LCD_POLYGON_MAX_POINTS];
+    int edge_count = 0;
+    int top = LCD_VIEW_HEIGHT, bottom = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        int j = i + 1 == count ? 0 : i + 1;
+        raster_edge_t *edge = &edges[edge_count];
+        if (!lcd_edge_setup(edge, xs[i], ys[i], xs[j], ys[j]))
+            continue;
+        if (edge->y_start < top)
+            top = edge->y_start;
+        if (edge->y_end > bottom)
+            bottom = edge->y_end;
+        edge_count++;
+    }
+    if (top < LCD_ROWS_BEGIN)
+        top = LCD_ROWS_BEGIN;
+    if (bottom > LCD_ROWS_END)
+        bottom = LCD_ROWS_END;
+
+    for (int i = 0; i < edge_count; i++)
+        lcd_edge_skip_to(&edges[i], top);
+
+    for (int y = top; y < bottom; y++)
+    {
+        // Crossings of this row's center, kept sorted by insertion
+        int32_t crossings[LCD_POLYGON_MAX_POINTS];
+        int crossing_count = 0;
+        for (int i = 0; i < edge_count; i++)
+        {
+            raster_edge_t *edge = &edges[i];
+            if (y < edge->y_start || y >= edge->y_end)
+                continue;
+            int32_t x = edge->x;
+            edge->x += edge->step;
+
+            int k = crossing_count++;
+            while (k > 0 && crossings[k - 1] > x)
+            {
+                crossings[k] = crossings[k - 1];
+                k--;
+            }
+            crossings[k] = x;
+        }
+
+        for (int k = 0; k + 1 < crossing_count; k += 2)
+            lcd_span(y, LCD_FIXED_CENTER_CEIL(crossings[k]), LCD_FIXED_CENTER_CEIL(crossings[k + 1]) - 1, pixel);
+    }
+}
+
+/******************************************************************************
+function: Draw a filled triangle to the framebuffer
+parameter:
+    x1, y1 : First vertex coordinates
+    x2, y2 : Second vertex coordinates
+    x3, y3 : Third vertex coordinates
+    color  : RGB565 color value
+returns: none
+note: Vertices are pixel corners and pixels are filled when their center is
+      inside, with the top-left rule for centers exactly on an edge. A
+      triangle therefore covers its right and bottom edges one pixel short,
+      and triangles sharing an edge fit together without overlap. Vertices
+      may lie off-screen.
+******************************************************************************/
+void lcd_fill_triangle(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    int min_x = x1 < x2 ? (x1 < x3 ? x1 : x3) : (x2 < x3 ? x2 : x3);
+    int max_x = x1 > x2 ? (x1 > x3 ? x1 : x3) : (x2 > x3 ? x2 : x3);
+    int min_y = y1 < y2 ? (y1 < y3 ? y1 : y3) : (y2 < y3 ? y2 : y3);
+    int max_y = y1 > y2 ? (y1 > y3 ? y1 : y3) : (y2 > y3 ? y2 : y3);
+    if (min_x < 0)
+        min_x = 0;
+    if (min_y < 0)
+        min_y = 0;
+    if (max_x > LCD_VIEW_WIDTH)
+        max_x = LCD_VIEW_WIDTH;
+    if (max_y > LCD_VIEW_HEIGHT)
+        max_y = LCD_VIEW_HEIGHT;
+    if (min_x >= max_x || min_y >= max_y)
+        return; // no area on screen
+    lcd_dirty_add(min_x, min_y, max_x - 1, max_y - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_TRIANGLE, NULL, 0, x1, y1, x2, y2, x3, y3, color))
+        return;
+
+    lcd_raster_triangle(LCD_FIXED(x1), LCD_FIXED(y1), LCD_FIXED(x2), LCD_FIXED(y2), LCD_FIXED(x3), LCD_FIXED(y3),
+                        lcd_color_to_pixel(color));
+}
+
+/******************************************************************************
+function: Draw a filled polygon to the framebuffer
+parameter:
+    points : Vertices in drawing order, may lie off-screen
+    count  : Number of vertices, 3 to LCD_POLYGON_MAX_POINTS
+    color  : RGB565 color value
+returns: none
+note: Filled with the even-odd rule and the same pixel-center and top-left
+      conventions as lcd_fill_triangle. Extra vertices past
+      LCD_POLYGON_MAX_POINTS are ignored.
+******************************************************************************/
+void lcd_fill_polygon(const LcdPoint *points, uint8_t count, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    if (count < 3)
+        return;
+    if (count > LCD_POLYGON_MAX_POINTS)
+        count = LCD_POLYGON_MAX_POINTS;
+
+    int32_t xs[LCD_POLYGON_MAX_POINTS], ys[LCD_POLYGON_MAX_POINTS];
+    int min_x = points[0].x, max_x = points[0].x, min_y = points[0].y, max_y = points[0].y;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        xs[i] = LCD_FIXED(points[i].x);
+        ys[i] = LCD_FIXED(points[i].y);
+        if (points[i].x < min_x)
+            min_x = points[i].x;
+        if (points[i].x > max_x)
+            max_x = points[i].x;
+        if (points[i].y < min_y)
+            min_y = points[i].y;
+        if (points[i].y > max_y)
+            max_y = points[i].y;
+    }
+    if (min_x == max_x || min_y == max_y)
+        return; // no area
+    lcd_dirty_add(min_x, min_y, max_x - 1, max_y - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_POLYGON, points, count * sizeof(LcdPoint), count, color))
+        return;
+
+    lcd_raster_polygon(xs, ys, count, lcd_color_to_pixel(color));
+}
+
+/******************************************************************************
+function: Draw a line of a given width to the framebuffer
+parameter:
+    x1, y1 : Start point, may lie off-screen
+    x2, y2 : End point, may lie off-screen
+    width  : Line width in pixels
+    color  : RGB565 color value
+returns: none
+note: The line is a rectangle centered on the segment between the two pixel
+      centers, with flat ends, filled as two triangles at sub-pixel
+      precision. Use lcd_draw_line for 1-pixel lines, it is cheaper.
+******************************************************************************/
+void lcd_draw_thick_line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t width, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    float dx = x2 - x1, dy = y2 - y1;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (width == 0 || length == 0.0f)
+        return;
+
+    // Half-width normal, in 16.16 fixed point
+    float scale = width * 0.5f * 65536.0f / length;
+    int32_t nx = (int32_t)lroundf(-dy * scale);
+    int32_t ny = (int32_t)lroundf(dx * scale);
+
+    // Start and end at the pixel centers
+    int32_t ax = LCD_FIXED(x1) + 0x8000, ay = LCD_FIXED(y1) + 0x8000;
+    int32_t bx = LCD_FIXED(x2) + 0x8000, by = LCD_FIXED(y2) + 0x8000;
+
+    int pad = width / 2 + 1;
+    int min_x = (x1 < x2 ? x1 : x2) - pad, max_x = (x1 > x2 ? x1 : x2) + pad;
+    int min_y = (y1 < y2 ? y1 : y2) - pad, max_y = (y1 > y2 ? y1 : y2) + pad;
+    lcd_dirty_add(min_x, min_y, max_x, max_y);
+    if (LCD_TILE_RECORD(LCD_TILE_THICK_LINE, NULL, 0, x1, y1, x2, y2, width, color))
+        return;
+
+    // The shared diagonal is filled exactly once under the top-left rule
+    const lcd_pixel_t pixel = lcd_color_to_pixel(color);
+    lcd_raster_triangle(ax + nx, ay + ny, bx + nx, by + ny, bx - nx, by - ny, pixel);
+    lcd_raster_triangle(ax + nx, ay + ny, bx - nx, by - ny, ax - nx, ay - ny, pixel);
+}
+
+/******************************************************************************
+function: Fill the entire framebuffer with a solid color
+parameter:
+    color : RGB565 color value to fill with
+returns: none
+note: The fill runs on DMA and may still be in progress on return. The next
+      drawing call or swap waits for it; see lcd_fill_wait.
+******************************************************************************/
+void lcd_fill(uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_FILL);
+#if LCD_TILED
+    lcd_tile_clear(color); // the new background, nothing recorded before it can show
+#else
+    lcd_invalidate();
+    lcd_memset_rows_start(lcd_framebuffer, 0, sizeof(lcd_framebuffer), 1, lcd_pixel_pattern(lcd_color_to_pixel(color)));
+#endif
+}
+
+/******************************************************************************
+function: Wait for a background lcd_fill or lcd_fill_rect to complete
+parameter: none
+returns: none
+note: Only needed before touching the framebuffer directly
+******************************************************************************/
+void lcd_fill_wait(void)
+{
+    lcd_memset_wait();
+}
+
+/******************************************************************************
+function: Check whether a background fill is still running
+parameter: none
+returns: true while DMA is still writing the framebuffer
+******************************************************************************/
+bool lcd_fill_busy(void)
+{
+    return lcd_memset_busy();
+}
+
+/********************************************************************************
+function: Get the current font height
+parameter: none
+returns: Font height in pixels
+********************************************************************************/
+uint8_t lcd_get_font_height(void)
+{
+    if (current_font != NULL)
+    {
+        return current_font->height;
+    }
+    return 0;
+}
+
+/********************************************************************************
+function: Get the current font width
+parameter: none
+returns: Font width in pixels
+********************************************************************************/
+uint8_t lcd_get_font_width(void)
+{
+    if (current_font != NULL)
+    {
+        return current_font->width;
+    }
+    return 0;
+}
+
+void lcd_set_font(FontSize size)
+{
+    switch (size)
+    {
+    case FONT_XTRA_SMALL:
+        current_font = (FontTable *)&Font8;
+        break;
+    case FONT_SMALL:
+        current_font = (FontTable *)&Font12;
+        break;
+    case FONT_MEDIUM:
+        current_font = (FontTable *)&Font16;
+        break;
+    case FONT_LARGE:
+        current_font = (FontTable *)&Font20;
+        break;
+    case FONT_XTRA_LARGE:
+        current_font = (FontTable *)&Font24;
+        break;
+    default:
+        current_font = (FontTable *)&Font16; // Default to medium if invalid size
+        break;
+    }
+}
+
+#if LCD_TILED
+/******************************************************************************
+function: Make a font current while the display list is replayed
+parameter:
+    font : Font recorded with a text command
+returns: The font that was current before
+******************************************************************************/
+FontTable *lcd_font_select(FontTable *font)
+{
+    FontTable *previous = current_font;
+    current_font = font;
+    return previous;
+}
+#endif
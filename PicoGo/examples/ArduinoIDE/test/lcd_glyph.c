@@ -0,0 +1,219 @@
+#include "lcd_glyph.h"
+#include <string.h>
+
+#ifdef LCD_HOST_BUILD
+#define __not_in_flash_func(func_name) func_name
+#else
+#include "pico/platform.h"
+#endif
+
+#define GLYPH_FIRST 32 // ' '
+#define GLYPH_LAST 126 // '~'
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)
+
+#if LCD_GLYPH_CACHE
+typedef struct
+{
+    const FontTable *font;
+    uint32_t *rows;                         // GLYPH_COUNT * font->height masks
+    uint8_t decoded[(GLYPH_COUNT + 7) / 8]; // one bit per glyph
+} glyph_cache_t;
+
+static uint32_t glyph_rows8[GLYPH_COUNT * 8];
+static uint32_t glyph_rows12[GLYPH_COUNT * 12];
+static uint32_t glyph_rows16[GLYPH_COUNT * 16];
+static uint32_t glyph_rows20[GLYPH_COUNT * 20];
+static uint32_t glyph_rows24[GLYPH_COUNT * 24];
+
+static glyph_cache_t glyph_cache[] = {
+    {&Font8, glyph_rows8, {0}},
+    {&Font12, glyph_rows12, {0}},
+    {&Font16, glyph_rows16, {0}},
+    {&Font20, glyph_rows20, {0}},
+    {&Font24, glyph_rows24, {0}},
+};
+#endif
+
+/******************************************************************************
+function: Decode one glyph of a font table into row masks
+parameter:
+    font : Font table
+    c    : Printable ASCII character
+    rows : Destination, font->height entries
+returns: none
+******************************************************************************/
+static void lcd_glyph_decode(const FontTable *font, char c, uint32_t *rows)
+{
+    uint8_t bytes_per_row = (font->width + 7) / 8;
+    const uint8_t *data = &font->table[(c - GLYPH_FIRST) * font->height * bytes_per_row];
+
+    for (uint8_t row = 0; row < font->height; row++)
+    {
+        uint32_t mask = 0;
+        for (uint8_t i = 0; i < bytes_per_row; i++)
+            mask |= (uint32_t)*data++ << (24 - 8 * i);
+        rows[row] = mask;
+    }
+}
+
+/******************************************************************************
+function: Get the row masks of a glyph
+parameter:
+    font    : Font table
+    c       : Character to look up
+    scratch : Buffer of LCD_GLYPH_MAX_HEIGHT entries used when not cached
+returns: font->height row masks, bit 31 is the leftmost column; NULL when
+         the character is not printable or the font is too large
+note: With LCD_GLYPH_CACHE the Font8 to Font24 glyphs are decoded the first
+      time they are drawn and served from RAM afterwards.
+******************************************************************************/
+const uint32_t *__not_in_flash_func(lcd_glyph_rows)(const FontTable *font, char c, uint32_t *scratch)
+{
+    if (font == NULL || c < GLYPH_FIRST || c > GLYPH_LAST)
+        return NULL;
+    if (font->width > LCD_GLYPH_MAX_WIDTH || font->height > LCD_GLYPH_MAX_HEIGHT)
+        return NULL;
+
+#if LCD_GLYPH_CACHE
+    for (uint8_t i = 0; i < sizeof(glyph_cache) / sizeof(glyph_cache[0]); i++)
+    {
+        glyph_cache_t *cache = &glyph_cache[i];
+        if (cache->font != font)
+            continue;
+
+        uint8_t index = c - GLYPH_FIRST;
+        uint32_t *rows = &cache->rows[index * font->height];
+        if (!(cache->decoded[index >> 3] & (1 << (index & 7))))
+        {
+            lcd_glyph_decode(font, c, rows);
+            cache->decoded[index >> 3] |= 1 << (index & 7);
+        }
+        return rows;
+    }
+#endif
+
+    lcd_glyph_decode(font, c, scratch);
+    return scratch;
+}
+
+/******************************************************************************
+function: Clip a glyph against the destination once
+parameter:
+    font, c        : Glyph to draw
+    x, y           : Top-left corner of the glyph in the destination
+    width, height  : Destination size
+    scratch        : See lcd_glyph_rows
+    row_first      : First visible glyph row
+    row_end        : One past the last visible glyph row
+    col_mask       : Mask of the visible glyph columns
+returns: Row masks of the glyph, NULL when nothing is visible
+******************************************************************************/
+static inline const uint32_t *lcd_glyph_clip(const FontTable *font, char c, int x, int y,
+                                             uint16_t width, uint16_t height, uint32_t *scratch,
+                                             int *row_first, int *row_end, uint32_t *col_mask)
+{
+    if (font == NULL)
+        return NULL;
+
+    int col0 = x < 0 ? -x : 0;
+    int col1 = x + font->width > width ? width - x : font->width;
+    int row0 = y < 0 ? -y : 0;
+    int row1 = y + font->height > height ? height - y : font->height;
+    if (col0 >= col1 || row0 >= row1)
+        return NULL;
+
+    *row_first = row0;
+    *row_end = row1;
+    *col_mask = (0xFFFFFFFFu >> col0) & ~(col1 < 32 ? 0xFFFFFFFFu >> col1 : 0);
+    return lcd_glyph_rows(font, c, scratch);
+}
+
+/******************************************************************************
+function: Length of the run of set bits at the top of a row mask
+parameter:
+    mask : Row mask with bit 31 set
+returns: Number of consecutive set bits from bit 31 down
+******************************************************************************/
+static inline int lcd_glyph_run(uint32_t mask)
+{
+    return ~mask ? __builtin_clz(~mask) : 32;
+}
+
+/******************************************************************************
+function: Draw a glyph into an 8-bit pixel buffer
+parameter:
+    dst           : Pixel buffer, width * height entries
+    width, height : Size of the buffer
+    x, y          : Top-left corner of the glyph, may be negative
+    font, c       : Glyph to draw
+    pixel         : Pixel value for the set bits
+returns: none
+note: Each row is written as runs of consecutive set bits
+******************************************************************************/
+void __not_in_flash_func(lcd_glyph_draw8)(uint8_t *dst, uint16_t width, uint16_t height, int x, int y,
+                                          const FontTable *font, char c, uint8_t pixel)
+{
+    uint32_t scratch[LCD_GLYPH_MAX_HEIGHT];
+    int row0, row1;
+    uint32_t col_mask;
+    const uint32_t *rows = lcd_glyph_clip(font, c, x, y, width, height, scratch, &row0, &row1, &col_mask);
+    if (rows == NULL)
+        return;
+
+    for (int row = row0; row < row1; row++)
+    {
+        uint32_t mask = rows[row] & col_mask;
+        uint8_t *line = &dst[(y + row) * width];
+        int col = x;
+        while (mask)
+        {
+            int skip = __builtin_clz(mask);
+            col += skip;
+            mask <<= skip;
+            int run = lcd_glyph_run(mask);
+            memset(&line[col], pixel, run);
+            col += run;
+            mask = run < 32 ? mask << run : 0;
+        }
+    }
+}
+
+/******************************************************************************
+function: Draw a glyph into a 16-bit pixel buffer
+parameter:
+    dst           : Pixel buffer, width * height entries
+    width, height : Size of the buffer
+    x, y          : Top-left corner of the glyph, may be negative
+    font, c       : Glyph to draw
+    pixel         : Pixel value for the set bits
+returns: none
+note: Each row is written as runs of consecutive set bits
+******************************************************************************/
+void __not_in_flash_func(lcd_glyph_draw16)(uint16_t *dst, uint16_t width, uint16_t height, int x, int y,
+                                           const FontTable *font, char c, uint16_t pixel)
+{
+    uint32_t scratch[LCD_GLYPH_MAX_HEIGHT];
+    int row0, row1;
+    uint32_t col_mask;
+    const uint32_t *rows = lcd_glyph_clip(font, c, x, y, width, height, scratch, &row0, &row1, &col_mask);
+    if (rows == NULL)
+        return;
+
+    for (int row = row0; row < row1; row++)
+    {
+        uint32_t mask = rows[row] & col_mask;
+        uint16_t *line = &dst[(y + row) * width];
+        int col = x;
+        while (mask)
+        {
+            int skip = __builtin_clz(mask);
+            col += skip;
+            mask <<= skip;
+            int run = lcd_glyph_run(mask);
+            for (uint16_t *p = &line[col], *end = p + run; p < end; p++)
+                *p = pixel;
+            col += run;
+            mask = run < 32 ? mask << run : 0;
+        }
+    }
+}
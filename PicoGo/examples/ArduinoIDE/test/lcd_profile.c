@@ -0,0 +1,275 @@
+#include "lcd_profile.h"
+#include <string.h>
+
+#ifdef LCD_HOST_BUILD
+#include <time.h>
+#define __not_in_flash_func(func_name) func_name
+#else
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#endif
+
+static const char *const profile_names[LCD_PROFILE_KINDS] = {
+    "fill", "shape", "text", "blit", "swap_convert", "swap_transfer",
+};
+
+#if LCD_PROFILE
+// Cortex-M33 cycle counter, one per core at the same addresses
+#define DEMCR (*(volatile uint32_t *)0xE000EDFCu)
+#define DEMCR_TRCENA (1u << 24)
+#define DWT_CTRL (*(volatile uint32_t *)0xE0001000u)
+#define DWT_CTRL_CYCCNTENA (1u << 0)
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)
+
+#ifdef LCD_HOST_BUILD
+#define PROFILE_CORES 1
+#define PROFILE_CORE 0
+#define save_and_disable_interrupts() 0
+#define restore_interrupts(status) ((void)(status))
+#else
+#define PROFILE_CORES NUM_CORES
+#define PROFILE_CORE get_core_num()
+#endif
+
+// What lcd_profile_end does with a scope
+enum
+{
+    SCOPE_IDLE,   // nothing, a drawing call replayed inside a charge
+    SCOPE_NESTED, // leave a drawing call made by another one
+    SCOPE_DRAW,   // count an outermost drawing call
+    SCOPE_CHARGE, // count work done for another kind
+};
+
+uint32_t lcd_profile_pixel_count = 0;
+
+static LcdProfileCounter counters[LCD_PROFILE_KINDS];
+static uint64_t start_us = 0;
+static uint8_t draw_depth = 0;                       // drawing calls in progress
+static volatile uint8_t charge_depth[PROFILE_CORES]; // charges in progress, per core
+static volatile uint32_t charged[PROFILE_CORES];     // cycles charged so far, per core
+
+static uint64_t profile_time_us(void)
+{
+#ifdef LCD_HOST_BUILD
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+#else
+    return time_us_64();
+#endif
+}
+
+static uint32_t profile_clock_hz(void)
+{
+#if defined(LCD_HOST_BUILD)
+    return 1000000000u;
+#elif defined(__arm__)
+    return clock_get_hz(clk_sys);
+#else
+    return 1000000u;
+#endif
+}
+
+/******************************************************************************
+function: Read the profiling clock
+parameter: none
+returns: Ticks of LcdProfile.clock_hz, wrapping at 32 bits
+******************************************************************************/
+uint32_t __not_in_flash_func(lcd_profile_now)(void)
+{
+#if defined(LCD_HOST_BUILD)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+#elif defined(__arm__)
+    return DWT_CYCCNT;
+#else
+    return time_us_32();
+#endif
+}
+
+/******************************************************************************
+function: Enter a drawing call
+parameter:
+    kind : LcdProfileKind of the call
+returns: Scope for lcd_profile_end
+note: Calls made by another drawing call are part of it. Calls replayed
+      while a charge runs on this core (tiled band rendering) are part of
+      the charge.
+******************************************************************************/
+lcd_profile_scope_t __not_in_flash_func(lcd_profile_begin_draw)(uint8_t kind)
+{
+    lcd_profile_scope_t scope = {.mode = SCOPE_IDLE};
+    const unsigned core = PROFILE_CORE;
+    if (charge_depth[core] > 0)
+        return scope;
+    if (draw_depth++ > 0)
+    {
+        scope.mode = SCOPE_NESTED;
+        return scope;
+    }
+
+    scope.mode = SCOPE_DRAW;
+    scope.kind = kind;
+    scope.pixels = lcd_profile_pixel_count;
+    scope.charged = charged[core];
+    scope.start = lcd_profile_now();
+    return scope;
+}
+
+/******************************************************************************
+function: Enter work done for another kind than the running drawing call
+parameter:
+    kind   : LcdProfileKind the work belongs to
+    pixels : Pixels processed, counted as a call when not 0
+returns: Scope for lcd_profile_end
+note: Used for frame conversion, which runs from interrupts, and for
+      waiting on the fill DMA. The time is taken out of any drawing call it
+      interrupted on the same core.
+******************************************************************************/
+lcd_profile_scope_t __not_in_flash_func(lcd_profile_begin_charge)(uint8_t kind, uint32_t pixels)
+{
+    const unsigned core = PROFILE_CORE;
+    charge_depth[core]++;
+    return (lcd_profile_scope_t){
+        .mode = SCOPE_CHARGE,
+        .kind = kind,
+        .pixels = pixels,
+        .charged = charged[core],
+        .start = lcd_profile_now(),
+    };
+}
+
+/******************************************************************************
+function: Leave a scope and count it
+parameter:
+    scope : Returned by lcd_profile_begin_draw or lcd_profile_begin_charge
+returns: none
+note: Run by the cleanup attribute of LCD_PROFILE_DRAW and
+      LCD_PROFILE_CHARGE at the end of the block
+******************************************************************************/
+void __not_in_flash_func(lcd_profile_end)(lcd_profile_scope_t *scope)
+{
+    if (scope->mode == SCOPE_IDLE)
+        return;
+    if (scope->mode == SCOPE_NESTED)
+    {
+        draw_depth--;
+        return;
+    }
+
+    const unsigned core = PROFILE_CORE;
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t elapsed = lcd_profile_now() - scope->start;
+    uint32_t elsewhere = charged[core] - scope->charged;
+    uint32_t cycles = elapsed > elsewhere ? elapsed - elsewhere : 0;
+    LcdProfileCounter *counter = &counters[scope->kind];
+    counter->cycles += cycles;
+
+    if (scope->mode == SCOPE_DRAW)
+    {
+        draw_depth--;
+        counter->calls++;
+        counter->pixels += lcd_profile_pixel_count - scope->pixels;
+    }
+    else
+    {
+        charge_depth[core]--;
+        charged[core] += cycles;
+        if (scope->pixels > 0)
+        {
+            counter->calls++;
+            counter->pixels += scope->pixels;
+        }
+    }
+    restore_interrupts(status);
+}
+
+/******************************************************************************
+function: Count one finished operation
+parameter:
+    kind   : LcdProfileKind of the operation
+    cycles : Time it took, in profiling clock ticks
+    pixels : Pixels it processed
+returns: none
+note: For work that is not CPU time, like a frame transfer
+******************************************************************************/
+void __not_in_flash_func(lcd_profile_count)(uint8_t kind, uint32_t cycles, uint32_t pixels)
+{
+    uint32_t status = save_and_disable_interrupts();
+    counters[kind].calls++;
+    counters[kind].cycles += cycles;
+    counters[kind].pixels += pixels;
+    restore_interrupts(status);
+}
+#endif
+
+/******************************************************************************
+function: Read the profile
+parameter:
+    profile : Receives the counters since lcd_init or lcd_reset_profile
+returns: none
+note: All zero when the driver is built without LCD_PROFILE
+******************************************************************************/
+void lcd_get_profile(LcdProfile *profile)
+{
+    memset(profile, 0, sizeof(*profile));
+#if LCD_PROFILE
+    uint32_t status = save_and_disable_interrupts();
+    memcpy(profile->counters, counters, sizeof(counters));
+    restore_interrupts(status);
+
+    profile->frames = profile->counters[LCD_PROFILE_SWAP_TRANSFER].calls;
+    profile->elapsed_us = profile_time_us() - start_us;
+    if (profile->elapsed_us > 0)
+        profile->fps = (float)profile->frames * 1000000.0f / (float)profile->elapsed_us;
+    profile->clock_hz = profile_clock_hz();
+#endif
+}
+
+/******************************************************************************
+function: Start the profiling clock on the calling core
+parameter: none
+returns: none
+note: Called by lcd_init, and on core1 by drivers that convert frames there.
+      The first call also starts the profile.
+******************************************************************************/
+void lcd_profile_init(void)
+{
+#if LCD_PROFILE
+#if defined(__arm__) && !defined(LCD_HOST_BUILD)
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif
+    if (start_us == 0)
+        lcd_reset_profile();
+#endif
+}
+
+/******************************************************************************
+function: Clear the profile and start measuring again
+parameter: none
+returns: none
+note: Calls and frames in progress are counted when they end
+******************************************************************************/
+void lcd_reset_profile(void)
+{
+#if LCD_PROFILE
+    uint32_t status = save_and_disable_interrupts();
+    memset(counters, 0, sizeof(counters));
+    start_us = profile_time_us();
+    restore_interrupts(status);
+#endif
+}
+
+/******************************************************************************
+function: Get the name of a profile counter
+parameter:
+    kind : LcdProfileKind
+returns: Lowercase name, "" for an unknown kind
+******************************************************************************/
+const char *lcd_profile_name(LcdProfileKind kind)
+{
+    return (unsigned)kind < LCD_PROFILE_KINDS ? profile_names[kind] : "";
+}
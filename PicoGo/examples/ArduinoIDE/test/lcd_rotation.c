@@ -0,0 +1,175 @@
+#include "lcd_internal.h"
+
+#ifdef LCD_HOST_BUILD
+#define __not_in_flash_func(func_name) func_name
+#else
+#include "pico/platform.h"
+#endif
+
+uint8_t lcd_transform = 0;
+#if LCD_WIDTH != LCD_HEIGHT
+uint16_t lcd_view_width = LCD_WIDTH;
+uint16_t lcd_view_height = LCD_HEIGHT;
+#endif
+
+static uint16_t rotation = 0;
+static bool mirrored = false;
+
+/******************************************************************************
+function: Apply a new orientation
+parameter:
+    degrees : 0, 90, 180 or 270, clockwise
+    mirror  : true to flip the picture left to right after rotating it
+returns: false when the orientation is not valid or the panel driver
+         cannot show it, the old one then stays
+note: The framebuffer keeps its contents; they are laid out for the old
+      orientation, so clear and redraw after a change. The whole screen is
+      sent with the next lcd_swap.
+******************************************************************************/
+static bool orientation_set(uint16_t degrees, bool mirror)
+{
+    // LCD_SWAP_XY, LCD_FLIP_X and LCD_FLIP_Y per quarter turn, plain and mirrored
+    static const uint8_t transforms[4][2] = {
+        {0, LCD_FLIP_X},
+        {LCD_SWAP_XY | LCD_FLIP_X, LCD_SWAP_XY | LCD_FLIP_X | LCD_FLIP_Y},
+        {LCD_FLIP_X | LCD_FLIP_Y, LCD_FLIP_Y},
+        {LCD_SWAP_XY | LCD_FLIP_Y, LCD_SWAP_XY},
+    };
+    if (degrees % 90 != 0 || degrees >= 360)
+        return false;
+
+    const uint8_t transform = transforms[degrees / 90][mirror];
+    lcd_swap_wait(); // the frame in flight still uses the old layout
+    if (!lcd_panel_orient(transform))
+        return false;
+
+    lcd_transform = transform;
+    rotation = degrees;
+    mirrored = mirror;
+#if LCD_WIDTH != LCD_HEIGHT
+    lcd_view_width = (transform & LCD_SWAP_XY) ? LCD_HEIGHT : LCD_WIDTH;
+    lcd_view_height = (transform & LCD_SWAP_XY) ? LCD_WIDTH : LCD_HEIGHT;
+#endif
+    lcd_invalidate();
+    return true;
+}
+
+/******************************************************************************
+function: Rotate the display
+parameter:
+    degrees : 0, 90, 180 or 270, clockwise
+returns: false when the panel driver cannot show the rotation
+note: Everything is drawn in the rotated coordinates from then on, with
+      lcd_get_width() x lcd_get_height() pixels. Keeps the mirroring set by
+      lcd_set_mirror. See orientation_set.
+******************************************************************************/
+bool lcd_set_rotation(uint16_t degrees)
+{
+    return orientation_set(degrees, mirrored);
+}
+
+/******************************************************************************
+function: Mirror the display left to right
+parameter:
+    mirror : true to flip the picture, false for the normal view
+returns: false when the panel driver cannot show it
+note: Applied after the rotation, so left and right are those of the
+      rotated picture. See orientation_set.
+******************************************************************************/
+bool lcd_set_mirror(bool mirror)
+{
+    return orientation_set(rotation, mirror);
+}
+
+/******************************************************************************
+function: Get the current rotation
+parameter: none
+returns: 0, 90, 180 or 270 degrees clockwise
+******************************************************************************/
+uint16_t lcd_get_rotation(void)
+{
+    return rotation;
+}
+
+/******************************************************************************
+function: Get the width of the drawing area
+parameter: none
+returns: Pixels, LCD_HEIGHT when rotated by 90 or 270 degrees
+******************************************************************************/
+uint16_t lcd_get_width(void)
+{
+    return LCD_VIEW_WIDTH;
+}
+
+/******************************************************************************
+function: Get the height of the drawing area
+parameter: none
+returns: Pixels, LCD_WIDTH when rotated by 90 or 270 degrees
+******************************************************************************/
+uint16_t lcd_get_height(void)
+{
+    return LCD_VIEW_HEIGHT;
+}
+
+/******************************************************************************
+function: Convert a panel position to drawing coordinates
+parameter:
+    x, y : Position in the unrotated panel frame, as the touch driver reads
+           it; replaced by the same spot in the current orientation
+returns: none
+note: Positions past the panel edge are clamped to it first.
+******************************************************************************/
+void lcd_panel_to_screen(uint16_t *x, uint16_t *y)
+{
+    int u = *x < LCD_WIDTH ? *x : LCD_WIDTH - 1;
+    int v = *y < LCD_HEIGHT ? *y : LCD_HEIGHT - 1;
+    if (lcd_transform & LCD_FLIP_X)
+        u = LCD_WIDTH - 1 - u;
+    if (lcd_transform & LCD_FLIP_Y)
+        v = LCD_HEIGHT - 1 - v;
+    *x = (lcd_transform & LCD_SWAP_XY) ? v : u;
+    *y = (lcd_transform & LCD_SWAP_XY) ? u : v;
+}
+
+/******************************************************************************
+function: Find where a framebuffer region lands on the panel
+parameter:
+    view  : Region in drawing coordinates (inclusive bounds)
+    panel : Receives the same region in the panel frame
+returns: none
+******************************************************************************/
+void lcd_transform_area(const dirty_area_t *view, dirty_area_t *panel)
+{
+    const bool swap = lcd_transform & LCD_SWAP_XY;
+    int u0 = swap ? view->y0 : view->x0, u1 = swap ? view->y1 : view->x1;
+    int v0 = swap ? view->x0 : view->y0, v1 = swap ? view->x1 : view->y1;
+    panel->x0 = (lcd_transform & LCD_FLIP_X) ? LCD_WIDTH - 1 - u1 : u0;
+    panel->x1 = (lcd_transform & LCD_FLIP_X) ? LCD_WIDTH - 1 - u0 : u1;
+    panel->y0 = (lcd_transform & LCD_FLIP_Y) ? LCD_HEIGHT - 1 - v1 : v0;
+    panel->y1 = (lcd_transform & LCD_FLIP_Y) ? LCD_HEIGHT - 1 - v0 : v1;
+}
+
+/******************************************************************************
+function: Locate a run of panel pixels in the framebuffer
+parameter:
+    px, py : Panel position of the first pixel of the run
+    step   : Receives the distance in pixels between framebuffer entries
+             of consecutive panel pixels, +-1 or +-LCD_VIEW_WIDTH
+returns: Framebuffer (or band) address of the first pixel
+note: A panel row is a framebuffer row or column, walked in either
+      direction, so panel drivers that rotate in software gather each row
+      with lcd_expand_rgb332_step or lcd_copy_rgb565_step.
+******************************************************************************/
+const lcd_pixel_t *__not_in_flash_func(lcd_transform_row)(int px, int py, int *step)
+{
+    int u = (lcd_transform & LCD_FLIP_X) ? LCD_WIDTH - 1 - px : px;
+    int v = (lcd_transform & LCD_FLIP_Y) ? LCD_HEIGHT - 1 - py : py;
+    int du = (lcd_transform & LCD_FLIP_X) ? -1 : 1;
+    if (lcd_transform & LCD_SWAP_XY)
+    {
+        *step = du * LCD_VIEW_WIDTH;
+        return LCD_PIXEL_AT(v, u);
+    }
+    *step = du;
+    return LCD_PIXEL_AT(u, v);
+}
@@ -0,0 +1,541 @@
+#include "lcd_sprite.h"
+#include "lcd_internal.h"
+#include <string.h>
+
+typedef struct
+{
+    const uint8_t *image; // NULL for a free entry
+    uint16_t width;
+    uint16_t height;
+    int16_t x;
+    int16_t y;
+    uint8_t flags;
+    bool visible;
+} sprite_t;
+
+static sprite_t sprites[LCD_MAX_SPRITES];
+static uint16_t background_color = COLOR_BLACK;
+static LcdTilemap *tilemap = NULL;
+static int32_t scroll_x = 0, scroll_y = 0; // kept within the map size
+
+static dirty_area_t damage[LCD_SPRITE_MAX_DAMAGE]; // regions to redraw, same bounds as the dirty list
+static uint8_t damage_count = 0;
+
+// Whole drawing area, which depends on the rotation
+static inline dirty_area_t screen_rect(void)
+{
+    return (dirty_area_t){0, 0, LCD_VIEW_WIDTH - 1, LCD_VIEW_HEIGHT - 1};
+}
+
+/******************************************************************************
+function: Copy a clipped image into the framebuffer
+parameter:
+    image  : RGB332 pixels, width * height, row-major
+    width  : Image width
+    height : Image height
+    x, y   : Screen position of the top-left pixel, may be negative
+    flags  : LCD_BLIT_* flags
+    clip   : Screen rectangle to stay inside
+returns: none
+note: Clips once per call and then copies whole rows. Does not mark anything
+      dirty.
+******************************************************************************/
+static void sprite_blit(const uint8_t *image, int width, int height, int x, int y, uint8_t flags,
+                        const dirty_area_t *clip)
+{
+    int x0 = x > clip->x0 ? x : clip->x0;
+    int y0 = y > clip->y0 ? y : clip->y0;
+    int x1 = x + width - 1 < clip->x1 ? x + width - 1 : clip->x1;
+    int y1 = y + height - 1 < clip->y1 ? y + height - 1 : clip->y1;
+    if (y0 < LCD_ROWS_BEGIN)
+        y0 = LCD_ROWS_BEGIN;
+    if (y1 >= LCD_ROWS_END)
+        y1 = LCD_ROWS_END - 1;
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    const int count = x1 - x0 + 1;
+    const bool flip_x = flags & LCD_BLIT_FLIP_X;
+    const bool transparent = flags & LCD_BLIT_TRANSPARENT;
+
+    for (int row = y0; row <= y1; row++)
+    {
+        int src_row = row - y;
+        if (flags & LCD_BLIT_FLIP_Y)
+            src_row = height - 1 - src_row;
+        lcd_pixel_t *dst = LCD_PIXEL_AT(x0, row);
+
+        if (!flip_x)
+        {
+            const uint8_t *src = &image[src_row * width + (x0 - x)];
+            if (!transparent)
+            {
+#if LCD_COLOR_DEPTH == 16
+                for (int n = 0; n < count; n++)
+                    dst[n] = lcd_pixel_from_332(src[n]);
+#else
+                memcpy(dst, src, count);
+#endif
+                continue;
+            }
+            for (int n = 0; n < count; n++)
+            {
+                if (src[n] != LCD_TRANSPARENT_332)
+                    dst[n] = lcd_pixel_from_332(src[n]);
+            }
+        }
+        else
+        {
+            // Walk the source row backwards from the mirrored first column
+            const uint8_t *src = &image[src_row * width + (width - 1 - (x0 - x))];
+            for (int n = 0; n < count; n++)
+            {
+                uint8_t value = src[-n];
+                if (!transparent || value != LCD_TRANSPARENT_332)
+                    dst[n] = lcd_pixel_from_332(value);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+function: Copy an external image buffer into the framebuffer at specified position
+parameter:
+    x      : Top-left X coordinate
+    y      : Top-left Y coordinate
+    width  : Width of the buffer to blit
+    height : Height of the buffer to blit
+    buffer : Pointer to RGB332 pixel data array (8-bit per pixel)
+returns: none
+******************************************************************************/
+void lcd_blit(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *buffer)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_BLIT);
+    if (width == 0 || height == 0)
+        return;
+    lcd_dirty_add(x, y, x + width - 1, y + height - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_BLIT, NULL, 0, x, y, width, height, (intptr_t)buffer, 0))
+        return;
+    const dirty_area_t screen = screen_rect();
+    sprite_blit(buffer, width, height, x, y, 0, &screen);
+}
+
+/******************************************************************************
+function: Copy an image into the framebuffer with transparency and mirroring
+parameter:
+    x      : Top-left X coordinate, may be negative
+    y      : Top-left Y coordinate, may be negative
+    width  : Width of the buffer to blit
+    height : Height of the buffer to blit
+    buffer : Pointer to RGB332 pixel data array (8-bit per pixel)
+    flags  : LCD_BLIT_TRANSPARENT, LCD_BLIT_FLIP_X, LCD_BLIT_FLIP_Y
+returns: none
+note: With LCD_BLIT_TRANSPARENT, pixels equal to COLOR_TRANSPARENT in RGB332
+      (LCD_TRANSPARENT_332) leave the framebuffer unchanged.
+******************************************************************************/
+void lcd_blit_ex(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *buffer, uint8_t flags)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_BLIT);
+    if (width == 0 || height == 0)
+        return;
+    lcd_dirty_add(x, y, x + width - 1, y + height - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_BLIT, NULL, 0, x, y, width, height, (intptr_t)buffer, flags))
+        return;
+    const dirty_area_t screen = screen_rect();
+    sprite_blit(buffer, width, height, x, y, flags, &screen);
+}
+
+/******************************************************************************
+function: Add a screen region to the list redrawn by lcd_sprite_update
+parameter:
+    x0, y0 : Top-left corner (inclusive, may lie off-screen)
+    x1, y1 : Bottom-right corner (inclusive, may lie off-screen)
+returns: none
+note: Touching regions are merged. When the list is full the region is
+      merged into the entry whose bounding box grows the least.
+******************************************************************************/
+static void sprite_damage_add(int x0, int y0, int x1, int y1)
+{
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 >= LCD_VIEW_WIDTH)
+        x1 = LCD_VIEW_WIDTH - 1;
+    if (y1 >= LCD_VIEW_HEIGHT)
+        y1 = LCD_VIEW_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    while (true)
+    {
+        int hit = -1;
+        for (uint8_t i = 0; i < damage_count; i++)
+        {
+            const dirty_area_t *rect = &damage[i];
+            if (x0 <= rect->x1 + 1 && x1 + 1 >= rect->x0 && y0 <= rect->y1 + 1 && y1 + 1 >= rect->y0)
+            {
+                hit = i;
+                break;
+            }
+        }
+
+        if (hit < 0 && damage_count == LCD_SPRITE_MAX_DAMAGE)
+        {
+            uint32_t best_growth = UINT32_MAX;
+            for (uint8_t i = 0; i < damage_count; i++)
+            {
+                const dirty_area_t *rect = &damage[i];
+                int ux0 = x0 < rect->x0 ? x0 : rect->x0;
+                int uy0 = y0 < rect->y0 ? y0 : rect->y0;
+                int ux1 = x1 > rect->x1 ? x1 : rect->x1;
+                int uy1 = y1 > rect->y1 ? y1 : rect->y1;
+                uint32_t growth = (uint32_t)(ux1 - ux0 + 1) * (uy1 - uy0 + 1) -
+                                  (uint32_t)(rect->x1 - rect->x0 + 1) * (rect->y1 - rect->y0 + 1);
+                if (growth < best_growth)
+                {
+                    best_growth = growth;
+                    hit = i;
+                }
+            }
+        }
+
+        if (hit < 0)
+            break;
+
+        const dirty_area_t *rect = &damage[hit];
+        if (rect->x0 < x0)
+            x0 = rect->x0;
+        if (rect->y0 < y0)
+            y0 = rect->y0;
+        if (rect->x1 > x1)
+            x1 = rect->x1;
+        if (rect->y1 > y1)
+            y1 = rect->y1;
+        damage[hit] = damage[--damage_count];
+    }
+
+    damage[damage_count].x0 = x0;
+    damage[damage_count].y0 = y0;
+    damage[damage_count].x1 = x1;
+    damage[damage_count].y1 = y1;
+    damage_count++;
+}
+
+// Damage the area a sprite currently covers, if it is on show
+static void sprite_damage(const sprite_t *sprite)
+{
+    if (sprite->image != NULL && sprite->visible)
+        sprite_damage_add(sprite->x, sprite->y, sprite->x + sprite->width - 1, sprite->y + sprite->height - 1);
+}
+
+static sprite_t *sprite_get(int8_t id)
+{
+    if (id < 0 || id >= LCD_MAX_SPRITES || sprites[id].image == NULL)
+        return NULL;
+    return &sprites[id];
+}
+
+/******************************************************************************
+function: Register a sprite in the sprite table
+parameter:
+    image  : RGB332 pixels, width * height, row-major; referenced, not copied
+    width  : Sprite width
+    height : Sprite height
+    flags  : LCD_BLIT_* flags
+returns: Sprite id, or -1 when the table is full
+note: The sprite starts visible at (0, 0). Sprites are drawn in id order, so
+      later ones appear on top.
+******************************************************************************/
+int8_t lcd_sprite_add(const uint8_t *image, uint16_t width, uint16_t height, uint8_t flags)
+{
+    if (image == NULL || width == 0 || height == 0)
+        return -1;
+
+    for (int8_t id = 0; id < LCD_MAX_SPRITES; id++)
+    {
+        sprite_t *sprite = &sprites[id];
+        if (sprite->image != NULL)
+            continue;
+        sprite->image = image;
+        sprite->width = width;
+        sprite->height = height;
+        sprite->x = 0;
+        sprite->y = 0;
+        sprite->flags = flags;
+        sprite->visible = true;
+        sprite_damage(sprite);
+        return id;
+    }
+    return -1;
+}
+
+/******************************************************************************
+function: Remove a sprite from the sprite table
+parameter:
+    id : Sprite id from lcd_sprite_add
+returns: none
+******************************************************************************/
+void lcd_sprite_remove(int8_t id)
+{
+    sprite_t *sprite = sprite_get(id);
+    if (sprite == NULL)
+        return;
+    sprite_damage(sprite);
+    sprite->image = NULL;
+}
+
+/******************************************************************************
+function: Move a sprite
+parameter:
+    id   : Sprite id from lcd_sprite_add
+    x, y : New top-left position, may be partly or fully off-screen
+returns: none
+******************************************************************************/
+void lcd_sprite_move(int8_t id, int16_t x, int16_t y)
+{
+    sprite_t *sprite = sprite_get(id);
+    if (sprite == NULL || (sprite->x == x && sprite->y == y))
+        return;
+    sprite_damage(sprite);
+    sprite->x = x;
+    sprite->y = y;
+    sprite_damage(sprite);
+}
+
+/******************************************************************************
+function: Change the image of a sprite
+parameter:
+    id    : Sprite id from lcd_sprite_add
+    image : RGB332 pixels of the same size as the current image
+returns: none
+******************************************************************************/
+void lcd_sprite_set_image(int8_t id, const uint8_t *image)
+{
+    sprite_t *sprite = sprite_get(id);
+    if (sprite == NULL || image == NULL || sprite->image == image)
+        return;
+    sprite->image = image;
+    sprite_damage(sprite);
+}
+
+/******************************************************************************
+function: Change the blit flags of a sprite
+parameter:
+    id    : Sprite id from lcd_sprite_add
+    flags : LCD_BLIT_* flags
+returns: none
+******************************************************************************/
+void lcd_sprite_set_flags(int8_t id, uint8_t flags)
+{
+    sprite_t *sprite = sprite_get(id);
+    if (sprite == NULL || sprite->flags == flags)
+        return;
+    sprite->flags = flags;
+    sprite_damage(sprite);
+}
+
+/******************************************************************************
+function: Show or hide a sprite
+parameter:
+    id      : Sprite id from lcd_sprite_add
+    visible : true to draw the sprite
+returns: none
+******************************************************************************/
+void lcd_sprite_set_visible(int8_t id, bool visible)
+{
+    sprite_t *sprite = sprite_get(id);
+    if (sprite == NULL || sprite->visible == visible)
+        return;
+    sprite_damage(sprite); // no-op while hidden
+    sprite->visible = visible;
+    sprite_damage(sprite);
+}
+
+/******************************************************************************
+function: Set the solid background color behind the sprites
+parameter:
+    color : RGB565 color value
+returns: none
+note: Only used while no tilemap is set.
+******************************************************************************/
+void lcd_sprite_set_background(uint16_t color)
+{
+    background_color = color;
+    if (tilemap == NULL)
+        lcd_sprite_invalidate();
+}
+
+/******************************************************************************
+function: Use a tilemap as the background behind the sprites
+parameter:
+    map : Tilemap, referenced, not copied; NULL for the solid background
+returns: none
+note: The scroll position is reset to (0, 0).
+******************************************************************************/
+void lcd_tilemap_set(LcdTilemap *map)
+{
+    if (map != NULL && (map->map_width == 0 || map->map_height == 0 || map->tile_width == 0 || map->tile_height == 0))
+        map = NULL;
+    tilemap = map;
+    scroll_x = 0;
+    scroll_y = 0;
+    lcd_sprite_invalidate();
+}
+
+/******************************************************************************
+function: Scroll the tilemap
+parameter:
+    x, y : Map pixel shown at the top-left corner of the screen
+returns: none
+note: The map wraps around in both directions, so any value is valid.
+      Scrolling redraws the whole screen.
+******************************************************************************/
+void lcd_tilemap_scroll(int16_t x, int16_t y)
+{
+    if (tilemap == NULL)
+        return;
+
+    int32_t map_pixel_width = (int32_t)tilemap->map_width * tilemap->tile_width;
+    int32_t map_pixel_height = (int32_t)tilemap->map_height * tilemap->tile_height;
+    int32_t sx = x % map_pixel_width, sy = y % map_pixel_height;
+    if (sx < 0)
+        sx += map_pixel_width;
+    if (sy < 0)
+        sy += map_pixel_height;
+    if (sx == scroll_x && sy == scroll_y)
+        return;
+    scroll_x = sx;
+    scroll_y = sy;
+    lcd_sprite_invalidate();
+}
+
+/******************************************************************************
+function: Change one tile of the tilemap
+parameter:
+    column : Map column
+    row    : Map row
+    tile   : New tile number
+returns: none
+note: Only the screen area showing that tile is redrawn, including its
+      repeats when the map is smaller than the screen.
+******************************************************************************/
+void lcd_tilemap_set_tile(uint16_t column, uint16_t row, uint8_t tile)
+{
+    if (tilemap == NULL || column >= tilemap->map_width || row >= tilemap->map_height)
+        return;
+    uint8_t *cell = &tilemap->map[row * tilemap->map_width + column];
+    if (*cell == tile)
+        return;
+    *cell = tile;
+
+    const int tw = tilemap->tile_width, th = tilemap->tile_height;
+    const int map_pixel_width = tilemap->map_width * tw;
+    const int map_pixel_height = tilemap->map_height * th;
+
+    // First on-screen repeat of the tile, then every map size after it
+    int first_x = column * tw - scroll_x;
+    int first_y = row * th - scroll_y;
+    while (first_x + tw > 0)
+        first_x -= map_pixel_width;
+    while (first_y + th > 0)
+        first_y -= map_pixel_height;
+    for (int y = first_y + map_pixel_height; y < LCD_VIEW_HEIGHT; y += map_pixel_height)
+    {
+        for (int x = first_x + map_pixel_width; x < LCD_VIEW_WIDTH; x += map_pixel_width)
+            sprite_damage_add(x, y, x + tw - 1, y + th - 1);
+    }
+}
+
+/******************************************************************************
+function: Redraw the whole screen on the next lcd_sprite_update
+parameter: none
+returns: none
+note: Needed after drawing over the sprite layer by other means, such as
+      lcd_fill.
+******************************************************************************/
+void lcd_sprite_invalidate(void)
+{
+    damage[0] = screen_rect();
+    damage_count = 1;
+}
+
+/******************************************************************************
+function: Draw the tilemap into a screen rectangle
+parameter:
+    clip : Screen rectangle to redraw
+returns: none
+******************************************************************************/
+static void tilemap_draw(const dirty_area_t *clip)
+{
+    const int tw = tilemap->tile_width, th = tilemap->tile_height;
+    const int tile_bytes = tw * th;
+
+    // Map coordinates are non-negative since the scroll position is
+    int first_column = (clip->x0 + scroll_x) / tw;
+    int last_column = (clip->x1 + scroll_x) / tw;
+    int first_row = (clip->y0 + scroll_y) / th;
+    int last_row = (clip->y1 + scroll_y) / th;
+
+    for (int r = first_row; r <= last_row; r++)
+    {
+        const uint8_t *map_row = &tilemap->map[(r % tilemap->map_height) * tilemap->map_width];
+        int y = r * th - scroll_y;
+        for (int c = first_column; c <= last_column; c++)
+        {
+            const uint8_t *tile = &tilemap->tiles[map_row[c % tilemap->map_width] * tile_bytes];
+            sprite_blit(tile, tw, th, c * tw - scroll_x, y, 0, clip);
+        }
+    }
+}
+
+/******************************************************************************
+function: Redraw one region of the sprite layer
+parameter:
+    rect : Screen rectangle, inside the screen
+returns: none
+note: The background is redrawn, then every visible sprite overlapping the
+      region in id order. In tiled mode this runs for each band the region
+      covers, from the sprite table as it is when the frame is sent.
+******************************************************************************/
+void lcd_sprite_draw_rect(const dirty_area_t *rect)
+{
+    if (tilemap == NULL)
+        lcd_fill_rect(rect->x0, rect->y0, rect->x1 - rect->x0 + 1, rect->y1 - rect->y0 + 1, background_color);
+
+    // Also waits for the fill above before the CPU writes on top of it
+    lcd_dirty_add(rect->x0, rect->y0, rect->x1, rect->y1);
+
+    if (tilemap != NULL)
+        tilemap_draw(rect);
+
+    for (int id = 0; id < LCD_MAX_SPRITES; id++)
+    {
+        const sprite_t *sprite = &sprites[id];
+        if (sprite->image != NULL && sprite->visible)
+            sprite_blit(sprite->image, sprite->width, sprite->height, sprite->x, sprite->y, sprite->flags, rect);
+    }
+}
+
+/******************************************************************************
+function: Redraw the changed regions of the sprite layer
+parameter: none
+returns: none
+note: Each region changed since the previous call is redrawn and marked
+      dirty for the next lcd_swap.
+******************************************************************************/
+void lcd_sprite_update(void)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_BLIT);
+    for (uint8_t i = 0; i < damage_count; i++)
+    {
+        const dirty_area_t *rect = &damage[i];
+#if LCD_TILED
+        lcd_dirty_add(rect->x0, rect->y0, rect->x1, rect->y1);
+        if (LCD_TILE_RECORD(LCD_TILE_SPRITES, NULL, 0, rect->x0, rect->y0, rect->x1, rect->y1))
+            continue;
+#endif
+        lcd_sprite_draw_rect(rect);
+    }
+    damage_count = 0;
+}
@@ -0,0 +1,68 @@
+// Tiled rendering: a display list instead of a full-size framebuffer.
+//
+// With LCD_TILED set to 1 the drawing functions do not touch pixels. Each
+// call is recorded into a command list together with the screen area it
+// covers. lcd_swap hands the list to the panel driver, which rasterizes the
+// changed regions band by band into a buffer of LCD_TILE_LINES rows and
+// streams each band out while the next one is rendered. The list is copied
+// at the swap, so the next frame can be recorded while one is being sent.
+//
+// The list holds everything drawn since the last lcd_fill, so any region
+// rendered again comes out as the framebuffer would hold it. lcd_fill
+// empties the list, and a solid lcd_fill_rect, an image or blit without
+// transparency, or a sprite layer update drops the commands it completely
+// covers. Frames that are not started with lcd_fill stay bounded as long
+// as what they update is cleared first, e.g. a label's box before its text.
+//
+// Differences from the framebuffer mode:
+//   - Buffers passed to lcd_blit, lcd_blit_ex, lcd_blit_alpha,
+//     lcd_draw_image, the sprite images and lcd_draw_text_font fonts are
+//     referenced, not copied. They must stay valid and unchanged while
+//     commands that use them are in the list.
+//   - The sprite layer is drawn from the sprite table as it is when the
+//     frame is sent.
+//   - LZ images read back pixels that are no longer there and are refused
+//     (lcd_draw_image returns false). Use raw or RLE images.
+//   - A command that does not fit into the list is dropped and counted in
+//     LcdTileStats.dropped. Increase LCD_TILE_LIST_BYTES, or lcd_fill more
+//     often, if that happens.
+//   - There is no framebuffer to read back or to modify directly.
+//
+// RAM: the band (LCD_WIDTH * LCD_TILE_LINES pixels) and two command lists of
+// LCD_TILE_LIST_BYTES, instead of LCD_WIDTH * LCD_HEIGHT pixels.
+#pragma once
+
+#include <stdint.h>
+#include "lcd.h"
+
+// 1 = display list and band renderer, 0 = full-size framebuffer
+#ifndef LCD_TILED
+#define LCD_TILED 0
+#endif
+
+#ifndef LCD_TILE_LINES
+#define LCD_TILE_LINES LCD_CHUNK_LINES // Rows per band, one DMA chunk
+#endif
+
+#ifndef LCD_TILE_LIST_BYTES
+#define LCD_TILE_LIST_BYTES 8192 // Size of each of the two command lists
+#endif
+
+typedef struct
+{
+    uint32_t list_bytes;      // Bytes of commands in the last frame sent
+    uint32_t list_peak_bytes; // Largest list since lcd_init
+    uint32_t dropped;         // Commands dropped because the list was full, since lcd_init
+    uint32_t bands;           // Bands rendered for the last frame
+} LcdTileStats;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Command list usage, all zero when LCD_TILED is 0
+    void lcd_get_tile_stats(LcdTileStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -39,7 +39,9 @@ static inline pio_sm_config st7789_lcd_program_get_default_config(uint offset)
 
 // For optimal use of DMA bandwidth we would use an autopull threshold of 32,
 // but we are using a threshold of 8 here (consume 1 byte from each FIFO entry
-// and discard the remainder) to make things easier for software on the other side
+// and discard the remainder) to make things easier for software on the other side.
+// The pixel stream switches to 16 with st7789_lcd_set_pull_threshold so DMA can
+// push one RGB565 value per FIFO entry.
 static inline void st7789_lcd_program_init(PIO pio, uint sm, uint offset, uint data_pin, uint clk_pin, float clk_div)
 {
     pio_gpio_init(pio, data_pin);
@@ -63,6 +65,16 @@ static inline void st7789_lcd_put(PIO pio, uint sm, uint8_t x)
         ;
     *(volatile uint8_t *)&pio->txf[sm] = x;
 }
+// Change the autopull threshold (8 for command bytes, 16 for RGB565 pixels).
+// Only call this while the SM is idle. The restart clears the output shift
+// counter so the next OUT pulls a fresh word with the new threshold.
+static inline void st7789_lcd_set_pull_threshold(PIO pio, uint sm, uint bits)
+{
+    hw_write_masked(&pio->sm[sm].shiftctrl,
+                    (bits & 0x1fu) << PIO_SM0_SHIFTCTRL_PULL_THRESH_LSB,
+                    PIO_SM0_SHIFTCTRL_PULL_THRESH_BITS);
+    pio_sm_restart(pio, sm);
+}
 // SM is done when it stalls on an empty FIFO
 static inline void st7789_lcd_wait_idle(PIO pio, uint sm)
 {
@@ -1,13 +1,16 @@
-# Create a C module for Waveshare bluetooth extension
+# Create a C module for Waveshare bluetooth extension, built on
+# the driver in src/SDK/bluetooth
+set(WAVESHARE_BLUETOOTH_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/bluetooth)
 add_library(usermod_waveshare_bluetooth INTERFACE)
 
 target_sources(usermod_waveshare_bluetooth INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_bluetooth.c
-    ${CMAKE_CURRENT_LIST_DIR}/bluetooth.c
+    ${WAVESHARE_BLUETOOTH_DRIVER_DIR}/bluetooth.c
 )
 
 target_include_directories(usermod_waveshare_bluetooth INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_BLUETOOTH_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_bluetooth INTERFACE
@@ -1,7 +1,9 @@
 WAVESHARE_BLUETOOTH_MOD_DIR := $(USERMOD_DIR)
+WAVESHARE_BLUETOOTH_DRIVER_DIR := $(USERMOD_DIR)/../../SDK/bluetooth
 
 # Add all C files to SRC_USERMOD.
 SRC_USERMOD += $(WAVESHARE_BLUETOOTH_MOD_DIR)/waveshare_bluetooth.c
-SRC_USERMOD += $(WAVESHARE_BLUETOOTH_MOD_DIR)/bluetooth.c
+SRC_USERMOD += $(WAVESHARE_BLUETOOTH_DRIVER_DIR)/bluetooth.c
 # We can add our module folder to include paths if needed
-CFLAGS_USERMOD += -I$(WAVESHARE_BLUETOOTH_MOD_DIR)
\ No newline at end of file
+CFLAGS_USERMOD += -I$(WAVESHARE_BLUETOOTH_MOD_DIR)
+CFLAGS_USERMOD += -I$(WAVESHARE_BLUETOOTH_DRIVER_DIR)
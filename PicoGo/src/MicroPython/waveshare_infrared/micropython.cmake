@@ -1,13 +1,16 @@
-# Create a C module for Waveshare infrared extension
+# Create a C module for Waveshare infrared extension, built on
+# the driver in src/SDK/infrared
+set(WAVESHARE_INFRARED_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/infrared)
 add_library(usermod_waveshare_infrared INTERFACE)
 
 target_sources(usermod_waveshare_infrared INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_infrared.c
-    ${CMAKE_CURRENT_LIST_DIR}/infrared.c
+    ${WAVESHARE_INFRARED_DRIVER_DIR}/infrared.c
 )
 
 target_include_directories(usermod_waveshare_infrared INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_INFRARED_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_infrared INTERFACE
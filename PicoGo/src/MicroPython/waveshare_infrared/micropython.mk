@@ -1,7 +1,9 @@
 WAVESHARE_INFRARED_MOD_DIR := $(USERMOD_DIR)
+WAVESHARE_INFRARED_DRIVER_DIR := $(USERMOD_DIR)/../../SDK/infrared
 
 # Add all C files to SRC_USERMOD.
 SRC_USERMOD += $(WAVESHARE_INFRARED_MOD_DIR)/waveshare_infrared.c
-SRC_USERMOD += $(WAVESHARE_INFRARED_MOD_DIR)/infrared.c
+SRC_USERMOD += $(WAVESHARE_INFRARED_DRIVER_DIR)/infrared.c
 # We can add our module folder to include paths if needed
-CFLAGS_USERMOD += -I$(WAVESHARE_INFRARED_MOD_DIR)
\ No newline at end of file
+CFLAGS_USERMOD += -I$(WAVESHARE_INFRARED_MOD_DIR)
+CFLAGS_USERMOD += -I$(WAVESHARE_INFRARED_DRIVER_DIR)
@@ -1,76 +0,0 @@
-/**
- ******************************************************************************
- * @file    fonts.h
- * @author  MCD Application Team
- * @version V1.0.0
- * @date    18-February-2014
- * @brief   Header for fonts.c file
- ******************************************************************************
- * @attention
- *
- * <h2><center>&copy; COPYRIGHT(c) 2014 STMicroelectronics</center></h2>
- *
- * Redistribution and use in source and binary forms, with or without modification,
- * are permitted provided that the following conditions are met:
- *   1. Redistributions of source code must retain the above copyright notice,
- *      this list of conditions and the following disclaimer.
- *   2. Redistributions in binary form must reproduce the above copyright notice,
- *      this list of conditions and the following disclaimer in the documentation
- *      and/or other materials provided with the distribution.
- *   3. Neither the name of STMicroelectronics nor the names of its contributors
- *      may be used to endorse or promote products derived from this software
- *      without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
- * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
- * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
- * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
- * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
- * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
- * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
- * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- *
- ******************************************************************************
- */
-
-#pragma once
-
-#include <stdlib.h>
-#include <stdint.h>
-#include "pico/stdlib.h"
-
-typedef enum
-{
-  FONT_XTRA_SMALL = 0, // Extra small (English)
-  FONT_SMALL = 1,      // Small (English)
-  FONT_MEDIUM = 2,     // Medium (English)
-  FONT_LARGE = 3,      // Large (English)
-  FONT_XTRA_LARGE = 4, // Extra large (English)
-} FontSize;
-
-// ASCII
-typedef struct
-{
-  const uint8_t *table;
-  uint8_t width;
-  uint8_t height;
-} FontTable;
-
-#ifdef __cplusplus
-extern "C"
-{
-#endif
-
-  extern const FontTable Font8;
-  extern const FontTable Font12;
-  extern const FontTable Font16;
-  extern const FontTable Font20;
-  extern const FontTable Font24;
-
-#ifdef __cplusplus
-}
-#endif
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
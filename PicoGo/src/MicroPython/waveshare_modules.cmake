@@ -1,53 +1,24 @@
 # Combined Waveshare Modules for MicroPython
 
-# Include waveshare_lcd module
-add_library(usermod_waveshare_lcd INTERFACE)
+# Include waveshare_lcd module, kept in its own file as it also pulls in the
+# fonts and profiling counters shared through common/lcd
+include(${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/micropython.cmake)
 
-# Generate PIO header from .pio file
-pico_generate_pio_header(usermod_waveshare_lcd
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/st7789_lcd.pio
-)
-
-target_sources(usermod_waveshare_lcd INTERFACE
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/waveshare_lcd.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/lcd.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font8.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font12.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font16.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font20.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font24.c
-)
-
-target_include_directories(usermod_waveshare_lcd INTERFACE
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd
-)
-
-target_compile_definitions(usermod_waveshare_lcd INTERFACE
-    MODULE_WAVESHARE_LCD_ENABLED=1
-)
-
-target_link_libraries(usermod INTERFACE usermod_waveshare_lcd)
-
-# Link against the required Pico SDK libraries for LCD
-target_link_libraries(usermod_waveshare_lcd INTERFACE
-    pico_stdlib
-    pico_printf
-    pico_float
-    hardware_gpio
-    hardware_spi
-    hardware_pwm
-)
+# The other modules build their driver from src/SDK, the module folders only
+# hold the Python bindings
+set(WAVESHARE_SDK_DIR ${CMAKE_CURRENT_LIST_DIR}/../SDK)
 
 # Include waveshare_battery module
 add_library(usermod_waveshare_battery INTERFACE)
 
 target_sources(usermod_waveshare_battery INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_battery/waveshare_battery.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_battery/battery.c
+    ${WAVESHARE_SDK_DIR}/battery/battery.c
 )
 
 target_include_directories(usermod_waveshare_battery INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_battery
+    ${WAVESHARE_SDK_DIR}/battery
 )
 
 target_compile_definitions(usermod_waveshare_battery INTERFACE
@@ -71,11 +42,12 @@ add_library(usermod_waveshare_bluetooth INTERFACE)
 
 target_sources(usermod_waveshare_bluetooth INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_bluetooth/waveshare_bluetooth.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_bluetooth/bluetooth.c
+    ${WAVESHARE_SDK_DIR}/bluetooth/bluetooth.c
 )
 
 target_include_directories(usermod_waveshare_bluetooth INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_bluetooth
+    ${WAVESHARE_SDK_DIR}/bluetooth
 )
 
 target_compile_definitions(usermod_waveshare_bluetooth INTERFACE
@@ -100,11 +72,12 @@ add_library(usermod_waveshare_infrared INTERFACE)
 
 target_sources(usermod_waveshare_infrared INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_infrared/waveshare_infrared.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_infrared/infrared.c
+    ${WAVESHARE_SDK_DIR}/infrared/infrared.c
 )
 
 target_include_directories(usermod_waveshare_infrared INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_infrared
+    ${WAVESHARE_SDK_DIR}/infrared
 )
 
 target_compile_definitions(usermod_waveshare_infrared INTERFACE
@@ -124,11 +97,12 @@ add_library(usermod_waveshare_motor INTERFACE)
 
 target_sources(usermod_waveshare_motor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_motor/waveshare_motor.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_motor/motor.c
+    ${WAVESHARE_SDK_DIR}/motor/motor.c
 )
 
 target_include_directories(usermod_waveshare_motor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_motor
+    ${WAVESHARE_SDK_DIR}/motor
 )
 
 target_compile_definitions(usermod_waveshare_motor INTERFACE
@@ -153,16 +127,17 @@ add_library(usermod_waveshare_tracking_sensor INTERFACE)
 
 # Generate PIO header from .pio file
 pico_generate_pio_header(usermod_waveshare_tracking_sensor
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_tracking_sensor/spi.pio
+    ${WAVESHARE_SDK_DIR}/tracking_sensor/spi.pio
 )
 
 target_sources(usermod_waveshare_tracking_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_tracking_sensor/waveshare_tracking_sensor.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_tracking_sensor/tracking_sensor.c
+    ${WAVESHARE_SDK_DIR}/tracking_sensor/tracking_sensor.c
 )
 
 target_include_directories(usermod_waveshare_tracking_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_tracking_sensor
+    ${WAVESHARE_SDK_DIR}/tracking_sensor
 )
 
 target_compile_definitions(usermod_waveshare_tracking_sensor INTERFACE
@@ -187,11 +162,12 @@ add_library(usermod_waveshare_ultrasonic_sensor INTERFACE)
 
 target_sources(usermod_waveshare_ultrasonic_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_ultrasonic_sensor/waveshare_ultrasonic_sensor.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_ultrasonic_sensor/ultrasonic_sensor.c
+    ${WAVESHARE_SDK_DIR}/ultrasonic_sensor/ultrasonic_sensor.c
 )
 
 target_include_directories(usermod_waveshare_ultrasonic_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_ultrasonic_sensor
+    ${WAVESHARE_SDK_DIR}/ultrasonic_sensor
 )
 
 target_compile_definitions(usermod_waveshare_ultrasonic_sensor INTERFACE
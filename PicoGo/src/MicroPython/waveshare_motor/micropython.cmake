@@ -1,13 +1,16 @@
-# Create a C module for Waveshare motor extension
+# Create a C module for Waveshare motor extension, built on
+# the driver in src/SDK/motor
+set(WAVESHARE_MOTOR_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/motor)
 add_library(usermod_waveshare_motor INTERFACE)
 
 target_sources(usermod_waveshare_motor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_motor.c
-    ${CMAKE_CURRENT_LIST_DIR}/motor.c
+    ${WAVESHARE_MOTOR_DRIVER_DIR}/motor.c
 )
 
 target_include_directories(usermod_waveshare_motor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_MOTOR_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_motor INTERFACE
@@ -1,16 +1,19 @@
-# Create a C module for Waveshare tracking_sensor extension
+# Create a C module for Waveshare tracking_sensor extension, built on
+# the driver in src/SDK/tracking_sensor
+set(WAVESHARE_TRACKING_SENSOR_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/tracking_sensor)
 add_library(usermod_waveshare_tracking_sensor INTERFACE)
 
 # Generate PIO header from .pio file
-pico_generate_pio_header(usermod_waveshare_tracking_sensor ${CMAKE_CURRENT_LIST_DIR}/spi.pio)
+pico_generate_pio_header(usermod_waveshare_tracking_sensor ${WAVESHARE_TRACKING_SENSOR_DRIVER_DIR}/spi.pio)
 
 target_sources(usermod_waveshare_tracking_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_tracking_sensor.c
-    ${CMAKE_CURRENT_LIST_DIR}/tracking_sensor.c
+    ${WAVESHARE_TRACKING_SENSOR_DRIVER_DIR}/tracking_sensor.c
 )
 
 target_include_directories(usermod_waveshare_tracking_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_TRACKING_SENSOR_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_tracking_sensor INTERFACE
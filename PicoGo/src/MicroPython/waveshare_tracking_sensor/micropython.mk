@@ -1,7 +1,9 @@
 WAVESHARE_TRACKING_SENSOR_MOD_DIR := $(USERMOD_DIR)
+WAVESHARE_TRACKING_SENSOR_DRIVER_DIR := $(USERMOD_DIR)/../../SDK/tracking_sensor
 
 # Add all C files to SRC_USERMOD.
 SRC_USERMOD += $(WAVESHARE_TRACKING_SENSOR_MOD_DIR)/waveshare_tracking_sensor.c
-SRC_USERMOD += $(WAVESHARE_TRACKING_SENSOR_MOD_DIR)/tracking_sensor.c
+SRC_USERMOD += $(WAVESHARE_TRACKING_SENSOR_DRIVER_DIR)/tracking_sensor.c
 # We can add our module folder to include paths if needed
-CFLAGS_USERMOD += -I$(WAVESHARE_TRACKING_SENSOR_MOD_DIR)
\ No newline at end of file
+CFLAGS_USERMOD += -I$(WAVESHARE_TRACKING_SENSOR_MOD_DIR)
+CFLAGS_USERMOD += -I$(WAVESHARE_TRACKING_SENSOR_DRIVER_DIR)
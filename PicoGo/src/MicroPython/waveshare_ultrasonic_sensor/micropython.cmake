@@ -1,13 +1,16 @@
-# Create a C module for Waveshare ultrasonic_sensor extension
+# Create a C module for Waveshare ultrasonic_sensor extension, built on
+# the driver in src/SDK/ultrasonic_sensor
+set(WAVESHARE_ULTRASONIC_SENSOR_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/ultrasonic_sensor)
 add_library(usermod_waveshare_ultrasonic_sensor INTERFACE)
 
 target_sources(usermod_waveshare_ultrasonic_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_ultrasonic_sensor.c
-    ${CMAKE_CURRENT_LIST_DIR}/ultrasonic_sensor.c
+    ${WAVESHARE_ULTRASONIC_SENSOR_DRIVER_DIR}/ultrasonic_sensor.c
 )
 
 target_include_directories(usermod_waveshare_ultrasonic_sensor INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_ULTRASONIC_SENSOR_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_ultrasonic_sensor INTERFACE
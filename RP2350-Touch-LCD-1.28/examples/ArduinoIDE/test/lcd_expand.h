@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Expand RGB332 palette indices into RGB565 using a 256-entry lookup table.
+    // The table is stored in the byte order the panel expects, so its entries
+    // are copied out unchanged.
+    void lcd_expand_rgb332(uint16_t *dst, const uint8_t *src, size_t count, const uint16_t *palette);
+
+    // Same, reading every step-th index (step may be negative), to gather a
+    // framebuffer column or a reversed row for a rotated display.
+    void lcd_expand_rgb332_step(uint16_t *dst, const uint8_t *src, size_t count, ptrdiff_t step,
+                                const uint16_t *palette);
+
+    // Copy every step-th RGB565 pixel, for the same gathers at 16-bit depth.
+    void lcd_copy_rgb565_step(uint16_t *dst, const uint16_t *src, size_t count, ptrdiff_t step);
+
+#ifdef __cplusplus
+}
+#endif
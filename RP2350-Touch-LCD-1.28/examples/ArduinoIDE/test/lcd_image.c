@@ -0,0 +1,366 @@
+#include "lcd_image.h"
+#include "lcd_internal.h"
+#include <string.h>
+
+#ifdef LCD_HOST_BUILD
+#define __not_in_flash_func(func_name) func_name
+#else
+#include "pico/platform.h"
+#endif
+
+#define IMAGE_MAGIC_0 'L'
+#define IMAGE_MAGIC_1 'I'
+#define LZ_MIN_MATCH 3
+
+// Output position of a decode, in image pixels
+typedef struct
+{
+    int x, y;          // screen position of the image
+    int width, height; // image size
+    int col, row;      // next pixel to produce
+    bool transparent;  // skip LCD_TRANSPARENT_332 pixels
+} image_cursor_t;
+
+/******************************************************************************
+function: Work out how many pixels of a run stay on the current image row
+parameter:
+    cursor : Decode position
+    count  : Pixels left in the run
+    dst    : Set to the framebuffer address of the first visible pixel, or
+             NULL when nothing of the segment is on screen
+    skip   : Set to the number of pixels before the first visible one
+    visible: Set to the number of visible pixels
+returns: Pixels of the run on this row
+******************************************************************************/
+static inline int image_segment(const image_cursor_t *cursor, int count, lcd_pixel_t **dst, int *skip, int *visible)
+{
+    int segment = cursor->width - cursor->col;
+    if (segment > count)
+        segment = count;
+
+    *dst = NULL;
+    *skip = 0;
+    *visible = 0;
+    int sy = cursor->y + cursor->row;
+    if (sy < LCD_ROWS_BEGIN || sy >= LCD_ROWS_END)
+        return segment;
+
+    int sx0 = cursor->x + cursor->col, sx1 = sx0 + segment; // [sx0, sx1)
+    int cx0 = sx0 < 0 ? 0 : sx0;
+    int cx1 = sx1 > LCD_VIEW_WIDTH ? LCD_VIEW_WIDTH : sx1;
+    if (cx0 >= cx1)
+        return segment;
+
+    *dst = LCD_PIXEL_AT(cx0, sy);
+    *skip = cx0 - sx0;
+    *visible = cx1 - cx0;
+    return segment;
+}
+
+static inline void image_advance(image_cursor_t *cursor, int segment)
+{
+    cursor->col += segment;
+    if (cursor->col == cursor->width)
+    {
+        cursor->col = 0;
+        cursor->row++;
+    }
+}
+
+/******************************************************************************
+function: Write a run of one pixel value
+parameter:
+    cursor : Decode position, advanced past the run
+    value  : RGB332 pixel
+    count  : Run length, no more than the pixels left in the image
+returns: none
+******************************************************************************/
+static void __not_in_flash_func(image_put_run)(image_cursor_t *cursor, uint8_t value, int count)
+{
+    if (cursor->transparent && value == LCD_TRANSPARENT_332)
+    {
+        // Nothing to write, only move the cursor
+        int pos = cursor->col + count;
+        cursor->row += pos / cursor->width;
+        cursor->col = pos % cursor->width;
+        return;
+    }
+
+    const lcd_pixel_t pixel = lcd_pixel_from_332(value);
+    while (count > 0)
+    {
+        lcd_pixel_t *dst;
+        int skip, visible;
+        int segment = image_segment(cursor, count, &dst, &skip, &visible);
+        if (dst != NULL)
+        {
+#if LCD_COLOR_DEPTH == 16
+            for (int n = 0; n < visible; n++)
+                dst[n] = pixel;
+#else
+            memset(dst, pixel, visible);
+#endif
+        }
+        image_advance(cursor, segment);
+        count -= segment;
+    }
+}
+
+/******************************************************************************
+function: Write literal pixels
+parameter:
+    cursor : Decode position, advanced past the pixels
+    src    : RGB332 pixels
+    count  : Number of pixels, no more than the pixels left in the image
+returns: none
+******************************************************************************/
+static void __not_in_flash_func(image_put_literals)(image_cursor_t *cursor, const uint8_t *src, int count)
+{
+    while (count > 0)
+    {
+        lcd_pixel_t *dst;
+        int skip, visible;
+        int segment = image_segment(cursor, count, &dst, &skip, &visible);
+        if (dst != NULL)
+        {
+            const uint8_t *s = src + skip;
+            if (cursor->transparent)
+            {
+                for (int n = 0; n < visible; n++)
+                {
+                    if (s[n] != LCD_TRANSPARENT_332)
+                        dst[n] = lcd_pixel_from_332(s[n]);
+                }
+            }
+            else
+            {
+#if LCD_COLOR_DEPTH == 16
+                for (int n = 0; n < visible; n++)
+                    dst[n] = lcd_pixel_from_332(s[n]);
+#else
+                memcpy(dst, s, visible);
+#endif
+            }
+        }
+        image_advance(cursor, segment);
+        src += segment;
+        count -= segment;
+    }
+}
+
+/******************************************************************************
+function: Copy earlier decoded pixels back out of the framebuffer
+parameter:
+    cursor : Decode position, advanced past the match
+    offset : Distance back in pixels, 1 to the pixels produced so far
+    count  : Match length, no more than the pixels left in the image
+returns: none
+note: The whole image is on screen (checked by lcd_draw_image), so every
+      earlier pixel is still in the framebuffer. Copies in pieces that stay
+      on one row of both source and destination; a piece shorter than the
+      offset is a plain memcpy, a match overlapping its own output is copied
+      forward one pixel at a time.
+******************************************************************************/
+static void __not_in_flash_func(image_put_match)(image_cursor_t *cursor, int offset, int count)
+{
+    int src_index = cursor->row * cursor->width + cursor->col - offset;
+    int src_col = src_index % cursor->width;
+    lcd_pixel_t *src = LCD_PIXEL_AT(cursor->x + src_col, cursor->y + src_index / cursor->width);
+    lcd_pixel_t *dst = LCD_PIXEL_AT(cursor->x + cursor->col, cursor->y + cursor->row);
+    const int row_gap = LCD_VIEW_WIDTH - cursor->width;
+
+    while (count > 0)
+    {
+        int piece = cursor->width - cursor->col;
+        if (piece > cursor->width - src_col)
+            piece = cursor->width - src_col;
+        if (piece > count)
+            piece = count;
+
+        if (piece <= offset)
+            memcpy(dst, src, piece * sizeof(lcd_pixel_t));
+        else
+        {
+            for (int n = 0; n < piece; n++)
+                dst[n] = src[n];
+        }
+        src += piece;
+        dst += piece;
+        count -= piece;
+
+        src_col += piece;
+        if (src_col == cursor->width)
+        {
+            src_col = 0;
+            src += row_gap;
+        }
+        cursor->col += piece;
+        if (cursor->col == cursor->width)
+        {
+            cursor->col = 0;
+            cursor->row++;
+            dst += row_gap;
+        }
+    }
+}
+
+/******************************************************************************
+function: Read an LZ length extension
+parameter:
+    p     : Read position, advanced past the extension bytes
+    end   : End of the payload
+    value : Nibble value, 15 when extension bytes follow
+returns: Length, or -1 when the data ends early
+******************************************************************************/
+static inline int lz_length(const uint8_t **p, const uint8_t *end, int value)
+{
+    if (value != 15)
+        return value;
+    while (true)
+    {
+        if (*p >= end)
+            return -1;
+        uint8_t extra = *(*p)++;
+        value += extra;
+        if (extra != 255)
+            return value;
+    }
+}
+
+static bool image_decode_rle(image_cursor_t *cursor, const uint8_t *p, const uint8_t *end)
+{
+    int left = cursor->width * cursor->height;
+    while (left > 0)
+    {
+        if (p >= end)
+            return false;
+        uint8_t control = *p++;
+        if (control & 0x80)
+        {
+            int count = (control & 0x7F) + 2;
+            if (p >= end || count > left)
+                return false;
+            image_put_run(cursor, *p++, count);
+            left -= count;
+        }
+        else
+        {
+            int count = control + 1;
+            if (end - p < count || count > left)
+                return false;
+            image_put_literals(cursor, p, count);
+            p += count;
+            left -= count;
+        }
+    }
+    return true;
+}
+
+static bool image_decode_lz(image_cursor_t *cursor, const uint8_t *p, const uint8_t *end)
+{
+    int total = cursor->width * cursor->height;
+    int done = 0;
+    while (done < total)
+    {
+        if (p >= end)
+            return false;
+        uint8_t token = *p++;
+
+        int literals = lz_length(&p, end, token >> 4);
+        if (literals < 0 || end - p < literals || literals > total - done)
+            return false;
+        image_put_literals(cursor, p, literals);
+        p += literals;
+        done += literals;
+        if (done == total)
+            break;
+
+        int match = lz_length(&p, end, token & 0x0F);
+        if (match < 0 || end - p < 2)
+            return false;
+        match += LZ_MIN_MATCH;
+        int offset = p[0] | (p[1] << 8);
+        p += 2;
+        if (offset == 0 || offset > done || match > total - done)
+            return false;
+        image_put_match(cursor, offset, match);
+        done += match;
+    }
+    return true;
+}
+
+/******************************************************************************
+function: Read the size of an image
+parameter:
+    data   : Image container
+    size   : Size of data in bytes
+    width  : Set to the image width
+    height : Set to the image height
+returns: false when the header is missing or not valid
+******************************************************************************/
+bool lcd_image_info(const uint8_t *data, size_t size, uint16_t *width, uint16_t *height)
+{
+    if (data == NULL || size < LCD_IMAGE_HEADER_SIZE || data[0] != IMAGE_MAGIC_0 || data[1] != IMAGE_MAGIC_1 ||
+        data[2] > LCD_IMAGE_LZ)
+        return false;
+    *width = data[4] | (data[5] << 8);
+    *height = data[6] | (data[7] << 8);
+    return true;
+}
+
+/******************************************************************************
+function: Decode an image into the framebuffer
+parameter:
+    x     : Top-left X coordinate, may be negative
+    y     : Top-left Y coordinate, may be negative
+    data  : Image container
+    size  : Size of data in bytes
+    flags : LCD_BLIT_TRANSPARENT to skip COLOR_TRANSPARENT pixels (raw and
+            RLE images only)
+returns: false for invalid or truncated data, or an LZ image that does not
+         fit on screen, is drawn with transparency or in tiled mode
+note: Pixels go straight into the framebuffer, no buffer the size of the
+      image or of a row is used. Pixels decoded before an error stay drawn.
+******************************************************************************/
+bool lcd_draw_image(int16_t x, int16_t y, const uint8_t *data, size_t size, uint8_t flags)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_BLIT);
+    uint16_t width, height;
+    if (!lcd_image_info(data, size, &width, &height))
+        return false;
+    if (width == 0 || height == 0)
+        return true;
+
+    const uint8_t format = data[2];
+    if (format == LCD_IMAGE_LZ && (LCD_TILED || (flags & LCD_BLIT_TRANSPARENT) || x < 0 || y < 0 ||
+                                   x + width > LCD_VIEW_WIDTH || y + height > LCD_VIEW_HEIGHT))
+        return false; // matches read back pixels that would not be there
+
+    image_cursor_t cursor = {
+        .x = x,
+        .y = y,
+        .width = width,
+        .height = height,
+        .col = 0,
+        .row = 0,
+        .transparent = (flags & LCD_BLIT_TRANSPARENT) != 0,
+    };
+    lcd_dirty_add(x, y, x + width - 1, y + height - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_IMAGE, NULL, 0, x, y, (intptr_t)data, size, flags))
+        return true; // errors in the data show up when the frame is sent
+
+    const uint8_t *payload = data + LCD_IMAGE_HEADER_SIZE;
+    const uint8_t *end = data + size;
+    switch (format)
+    {
+    case LCD_IMAGE_RAW:
+        if ((size_t)(end - payload) < (size_t)width * height)
+            return false;
+        image_put_literals(&cursor, payload, width * height);
+        return true;
+    case LCD_IMAGE_RLE:
+        return image_decode_rle(&cursor, payload, end);
+    default:
+        return image_decode_lz(&cursor, payload, end);
+    }
+}
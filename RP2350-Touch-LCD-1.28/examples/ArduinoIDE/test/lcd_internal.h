@@ -0,0 +1,230 @@
+// Framebuffer state shared by the panel driver (lcd.c) and the drawing
+// code (lcd_draw.c). Not part of the public API.
+//
+// This core is the same for every board. The board's lcd.h describes its
+// panel: LCD_WIDTH, LCD_HEIGHT, LCD_DIRTY_ALIGN, LCD_CHUNK_LINES and
+// LCD_PIXEL_BYTE_SWAP, and its lcd.c drives the panel and the bus.
+#pragma once
+
+#include "lcd.h"
+#include "lcd_tile.h"
+#include "lcd_profile.h"
+
+#ifndef LCD_PIXEL_BYTE_SWAP
+#error "the board lcd.h must define LCD_PIXEL_BYTE_SWAP"
+#endif
+
+#if LCD_COLOR_DEPTH == 16
+typedef uint16_t lcd_pixel_t; // RGB565, stored in panel byte order
+#else
+typedef uint8_t lcd_pixel_t; // RGB332 palette index
+#endif
+
+// Framebuffer regions changed since the last lcd_swap (inclusive bounds)
+typedef struct
+{
+    int16_t x0, y0, x1, y1;
+} dirty_area_t;
+
+extern uint16_t lcd_palette[256]; // RGB332 -> RGB565 in panel byte order
+
+void lcd_palette_init(void); // panel driver: fill lcd_palette from lcd_init
+
+// Orientation set by lcd_set_rotation and lcd_set_mirror. The framebuffer
+// holds the picture as it is drawn, LCD_VIEW_WIDTH pixels per row; the panel
+// driver maps it to its own frame (LCD_WIDTH x LCD_HEIGHT) by taking view
+// (x, y) to (y, x) with LCD_SWAP_XY, then reversing the panel X and Y axes
+// with LCD_FLIP_X and LCD_FLIP_Y.
+#define LCD_SWAP_XY 0x01
+#define LCD_FLIP_X 0x02
+#define LCD_FLIP_Y 0x04
+
+extern uint8_t lcd_transform;
+#if LCD_WIDTH == LCD_HEIGHT
+#define LCD_VIEW_WIDTH LCD_WIDTH
+#define LCD_VIEW_HEIGHT LCD_HEIGHT
+#else
+extern uint16_t lcd_view_width, lcd_view_height;
+#define LCD_VIEW_WIDTH lcd_view_width
+#define LCD_VIEW_HEIGHT lcd_view_height
+#endif
+
+void lcd_dirty_add(int x0, int y0, int x1, int y1);
+uint8_t lcd_dirty_take(dirty_area_t *areas);
+
+bool lcd_panel_orient(uint8_t transform); // panel driver: apply, or false when unsupported
+void lcd_transform_area(const dirty_area_t *view, dirty_area_t *panel);
+const lcd_pixel_t *lcd_transform_row(int px, int py, int *step);
+
+void lcd_sprite_draw_rect(const dirty_area_t *rect); // one region of lcd_sprite_update
+void lcd_blend_mask(int x, int y, int width, int height, const uint8_t *mask, uint32_t stride_bits, uint8_t bpp,
+                    uint16_t color); // packed coverage, for lcd_blit_alpha and fonts
+
+#if LCD_TILED
+// Pixels are only written while lcd_tile_render rasterizes a band: screen
+// rows [lcd_band_top, lcd_band_bottom) are held in lcd_band. The drawing
+// code clips rows to LCD_ROWS_BEGIN/LCD_ROWS_END and addresses pixels with
+// LCD_PIXEL_AT, so the same rasterizers serve both modes.
+extern lcd_pixel_t lcd_band[LCD_WIDTH * LCD_TILE_LINES];
+extern int lcd_band_top, lcd_band_bottom;
+extern bool lcd_tile_replaying; // true while lcd_tile_render runs the display list
+
+#define LCD_ROWS_BEGIN lcd_band_top
+#define LCD_ROWS_END lcd_band_bottom
+#define LCD_PIXEL_AT(x, y) (&lcd_band[((y) - lcd_band_top) * LCD_VIEW_WIDTH + (x)])
+
+// True when unsigned row y lies in the rows being drawn
+static inline bool lcd_row_visible(uint16_t y)
+{
+    return y >= lcd_band_top && y < lcd_band_bottom;
+}
+
+// Display list commands, one per recorded drawing call
+enum
+{
+    LCD_TILE_PIXEL,           // x, y, color
+    LCD_TILE_LINE,            // x1, y1, x2, y2, color
+    LCD_TILE_FILL_RECT,       // x, y, width, height, color
+    LCD_TILE_CIRCLE,          // center_x, center_y, radius, color
+    LCD_TILE_FILL_CIRCLE,     // center_x, center_y, radius, color
+    LCD_TILE_RING,            // center_x, center_y, radius, thickness, color
+    LCD_TILE_ARC,             // center_x, center_y, radius, thickness, start_angle, end_angle, color
+    LCD_TILE_TRIANGLE,        // x1, y1, x2, y2, x3, y3, color
+    LCD_TILE_POLYGON,         // count, color; data: the LcdPoint array
+    LCD_TILE_THICK_LINE,      // x1, y1, x2, y2, width, color
+    LCD_TILE_CHAR,            // x, y, c, color, font
+    LCD_TILE_TEXT,            // x, y, color, font; data: the string
+    LCD_TILE_BLIT,            // x, y, width, height, buffer, flags
+    LCD_TILE_IMAGE,           // x, y, data, size, flags
+    LCD_TILE_SPRITES,         // x0, y0, x1, y1 of a sprite layer region
+    LCD_TILE_FILL_RECT_BLEND, // x, y, width, height, color, alpha
+    LCD_TILE_BLIT_ALPHA,      // x, y, width, height, alpha, format, color
+    LCD_TILE_LINE_AA,         // x1, y1, x2, y2, color
+    LCD_TILE_CIRCLE_AA,       // center_x, center_y, radius, color
+    LCD_TILE_FILL_CIRCLE_AA,  // center_x, center_y, radius, color
+    LCD_TILE_TEXT_FONT,       // x, y, color, font; data: the string
+};
+
+bool lcd_tile_set_box(int x0, int y0, int x1, int y1);
+bool lcd_tile_record(uint8_t op, const intptr_t *args, uint8_t arg_count, const void *data, size_t data_bytes);
+void lcd_tile_clear(uint16_t color);
+void lcd_tile_flip(void);
+void lcd_tile_render(int x0, int x1, int y, int lines);
+FontTable *lcd_font_select(FontTable *font);
+
+// Record a drawing call with the area of the preceding lcd_dirty_add.
+// Returns true when the call was recorded (or dropped) and must not draw,
+// false while the display list is being replayed into a band.
+#define LCD_TILE_RECORD(op, data, data_bytes, ...) \
+    lcd_tile_record(op, (const intptr_t[]){__VA_ARGS__}, \
+                    sizeof((const intptr_t[]){__VA_ARGS__}) / sizeof(intptr_t), data, data_bytes)
+
+static inline bool lcd_tile_recording(void)
+{
+    return !lcd_tile_replaying;
+}
+#else
+extern lcd_pixel_t lcd_framebuffer[LCD_WIDTH * LCD_HEIGHT];
+
+#define LCD_ROWS_BEGIN 0
+#define LCD_ROWS_END LCD_VIEW_HEIGHT
+#define LCD_PIXEL_AT(x, y) (&lcd_framebuffer[(y) * LCD_VIEW_WIDTH + (x)])
+
+static inline bool lcd_row_visible(uint16_t y)
+{
+    return y < LCD_VIEW_HEIGHT;
+}
+#define LCD_TILE_RECORD(op, data, data_bytes, ...) ((void)(data), false)
+
+static inline bool lcd_tile_recording(void)
+{
+    return false;
+}
+#endif
+
+#if LCD_COLOR_DEPTH != 16
+/******************************************************************************
+ * function: Convert a 16-bit RGB565 color to an 8-bit RGB332 color
+ * parameter:
+ *    color : 16-bit RGB565 color value
+ * returns: 8-bit RGB332 color value
+ ******************************************************************************/
+static inline uint8_t lcd_color565_to_332(uint16_t color)
+{
+    return ((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3);
+}
+#endif
+
+/******************************************************************************
+ * function: Convert 8-bit RGB332 components to a 16-bit RGB565 color
+ * parameter:
+ *    r : Red component (0-255)
+ *    g : Green component (0-255)
+ *    b : Blue component (0-255)
+ * returns: 16-bit RGB565 color value
+ ******************************************************************************/
+static inline uint16_t lcd_color332_to_565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+/******************************************************************************
+ * function: Convert a 16-bit RGB565 color to panel byte order
+ * parameter:
+ *    color : 16-bit RGB565 color value
+ * returns: The color byte-swapped with LCD_PIXEL_BYTE_SWAP, else as it is
+ * note: Also converts back, the swap is its own inverse
+ ******************************************************************************/
+static inline uint16_t lcd_color_to_panel(uint16_t color)
+{
+#if LCD_PIXEL_BYTE_SWAP
+    return (uint16_t)((color >> 8) | (color << 8));
+#else
+    return color;
+#endif
+}
+
+/******************************************************************************
+ * function: Convert a 16-bit RGB565 color to the framebuffer pixel format
+ * parameter:
+ *    color : 16-bit RGB565 color value
+ * returns: RGB332 index, or RGB565 in panel byte order with LCD_COLOR_DEPTH 16
+ ******************************************************************************/
+static inline lcd_pixel_t lcd_color_to_pixel(uint16_t color)
+{
+#if LCD_COLOR_DEPTH == 16
+    return lcd_color_to_panel(color);
+#else
+    return lcd_color565_to_332(color);
+#endif
+}
+
+/******************************************************************************
+ * function: Convert an RGB332 color to the framebuffer pixel format
+ * parameter:
+ *    index : 8-bit RGB332 color value
+ * returns: Framebuffer pixel value
+ ******************************************************************************/
+static inline lcd_pixel_t lcd_pixel_from_332(uint8_t index)
+{
+#if LCD_COLOR_DEPTH == 16
+    return lcd_palette[index];
+#else
+    return index;
+#endif
+}
+
+/******************************************************************************
+ * function: Convert a framebuffer pixel back to a 16-bit RGB565 color
+ * parameter:
+ *    pixel : Framebuffer pixel value
+ * returns: 16-bit RGB565 color value, for blending against the pixel
+ ******************************************************************************/
+static inline uint16_t lcd_pixel_to_color(lcd_pixel_t pixel)
+{
+#if LCD_COLOR_DEPTH == 16
+    return lcd_color_to_panel(pixel);
+#else
+    return lcd_color_to_panel(lcd_palette[pixel]);
+#endif
+}
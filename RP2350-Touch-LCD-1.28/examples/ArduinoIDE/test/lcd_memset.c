@@ -0,0 +1,233 @@
+#include "lcd_memset.h"
+#include "lcd_profile.h"
+
+#ifdef LCD_HOST_BUILD
+#define __not_in_flash_func(func_name) func_name
+#else
+#include "pico/platform.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#endif
+
+// Rows shorter than this are filled faster by the CPU than by setting up a transfer
+#define LCD_MEMSET_DMA_MIN_BYTES 64
+
+/******************************************************************************
+function: Fill memory with a repeating 32-bit pattern
+parameter:
+    dst     : Start address, any alignment
+    pattern : Memory image of one aligned 32-bit word
+    bytes   : Number of bytes to fill
+returns: none
+note: Unaligned head and tail bytes are taken from the pattern at the same
+      address phase, the rest is written with aligned 32-bit stores.
+******************************************************************************/
+void __not_in_flash_func(lcd_memset32)(void *dst, uint32_t pattern, size_t bytes)
+{
+    const uint8_t *pattern_bytes = (const uint8_t *)&pattern;
+    uint8_t *p = (uint8_t *)dst;
+
+    while (bytes > 0 && ((uintptr_t)p & 3))
+    {
+        *p = pattern_bytes[(uintptr_t)p & 3];
+        p++;
+        bytes--;
+    }
+
+    uint32_t *p32 = (uint32_t *)p;
+    size_t words = bytes >> 2;
+    while (words >= 4)
+    {
+        p32[0] = pattern;
+        p32[1] = pattern;
+        p32[2] = pattern;
+        p32[3] = pattern;
+        p32 += 4;
+        words -= 4;
+    }
+    while (words--)
+        *p32++ = pattern;
+
+    p = (uint8_t *)p32;
+    bytes &= 3;
+    while (bytes--)
+    {
+        *p = pattern_bytes[(uintptr_t)p & 3];
+        p++;
+    }
+}
+
+#ifdef LCD_HOST_BUILD
+
+void lcd_memset_init(void)
+{
+}
+
+void lcd_memset_rows_start(void *dst, size_t stride, size_t row_bytes, size_t rows, uint32_t pattern)
+{
+    uint8_t *row = (uint8_t *)dst;
+    while (rows--)
+    {
+        lcd_memset32(row, pattern, row_bytes);
+        row += stride;
+    }
+}
+
+void lcd_memset_wait(void)
+{
+}
+
+bool lcd_memset_busy(void)
+{
+    return false;
+}
+
+#else
+
+static int memset_dma = -1;               // DMA channel, -1 until lcd_memset_init
+static uint32_t memset_pattern;           // DMA read source, never incremented
+static volatile bool memset_busy = false; // true while rows are being filled
+static uint8_t *memset_next_row;
+static size_t memset_stride;
+static size_t memset_row_bytes;
+static size_t memset_rows_left;
+
+/******************************************************************************
+function: Start filling the next row
+parameter: none
+returns: none
+note: Head and tail bytes are written by the CPU right away, the aligned
+      middle of the row goes to DMA. Runs from the DMA IRQ after the first
+      row. Clears memset_busy once every row is done.
+******************************************************************************/
+static void __not_in_flash_func(lcd_memset_next_row)(void)
+{
+    while (memset_rows_left > 0)
+    {
+        uint8_t *row = memset_next_row;
+        memset_next_row += memset_stride;
+        memset_rows_left--;
+
+        size_t head = (4 - ((uintptr_t)row & 3)) & 3;
+        if (head > memset_row_bytes)
+            head = memset_row_bytes;
+        size_t words = (memset_row_bytes - head) >> 2;
+        size_t tail = memset_row_bytes - head - (words << 2);
+
+        lcd_memset32(row, memset_pattern, head);
+        lcd_memset32(row + head + (words << 2), memset_pattern, tail);
+
+        if (words > 0)
+        {
+            dma_channel_transfer_to_buffer_now(memset_dma, row + head, words);
+            return;
+        }
+    }
+    memset_busy = false;
+}
+
+/******************************************************************************
+function: DMA completion handler for the fill engine
+parameter: none
+returns: none
+******************************************************************************/
+static void __no_inline_not_in_flash_func(lcd_memset_irq_handler)(void)
+{
+    if (!dma_channel_get_irq1_status(memset_dma))
+        return;
+    dma_channel_acknowledge_irq1(memset_dma);
+
+    if (memset_busy)
+        lcd_memset_next_row();
+}
+
+/******************************************************************************
+function: Claim and configure the fill DMA channel
+parameter: none
+returns: none
+******************************************************************************/
+void lcd_memset_init(void)
+{
+    if (memset_dma >= 0)
+        return;
+
+    memset_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(memset_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    dma_channel_configure(memset_dma, &c, NULL, &memset_pattern, 0, false);
+
+    // DMA_IRQ_1 like the panel drivers, the MicroPython port owns DMA_IRQ_0
+    dma_channel_set_irq1_enabled(memset_dma, true);
+    irq_add_shared_handler(DMA_IRQ_1, lcd_memset_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+/******************************************************************************
+function: Start filling a block of rows with a repeating pattern
+parameter:
+    dst       : First byte of the first row
+    stride    : Distance between rows in bytes
+    row_bytes : Bytes to fill in each row
+    rows      : Number of rows
+    pattern   : Memory image of one aligned 32-bit word
+returns: none
+note: Returns as soon as the first row is handed to DMA; one transfer per
+      row is chained from the DMA IRQ. Contiguous blocks should be passed
+      as a single row. Short rows, or calls before lcd_memset_init, are
+      filled by the CPU before returning. Waits for a previous fill first.
+******************************************************************************/
+void lcd_memset_rows_start(void *dst, size_t stride, size_t row_bytes, size_t rows, uint32_t pattern)
+{
+    lcd_memset_wait();
+
+    if (rows == 0 || row_bytes == 0)
+        return;
+
+    if (memset_dma < 0 || row_bytes < LCD_MEMSET_DMA_MIN_BYTES)
+    {
+        uint8_t *row = (uint8_t *)dst;
+        while (rows--)
+        {
+            lcd_memset32(row, pattern, row_bytes);
+            row += stride;
+        }
+        return;
+    }
+
+    memset_pattern = pattern;
+    memset_next_row = (uint8_t *)dst;
+    memset_stride = stride;
+    memset_row_bytes = row_bytes;
+    memset_rows_left = rows;
+    memset_busy = true;
+    lcd_memset_next_row();
+}
+
+/******************************************************************************
+function: Wait for the fill engine to finish
+parameter: none
+returns: none
+******************************************************************************/
+void lcd_memset_wait(void)
+{
+    if (!memset_busy)
+        return;
+    // Fill time, not time of the drawing call that has to wait for it
+    LCD_PROFILE_CHARGE(LCD_PROFILE_FILL, 0);
+    while (memset_busy)
+        tight_loop_contents();
+}
+
+/******************************************************************************
+function: Check whether a fill is still running
+parameter: none
+returns: true while DMA is still writing rows
+******************************************************************************/
+bool lcd_memset_busy(void)
+{
+    return memset_busy;
+}
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Fill memory with a repeating 32-bit pattern. The pattern is the memory
+    // image of one aligned word, so any start address keeps the same phase.
+    void lcd_memset32(void *dst, uint32_t pattern, size_t bytes);
+
+    // DMA fill engine. Host builds (LCD_HOST_BUILD) run the CPU path instead.
+    void lcd_memset_init(void);
+    void lcd_memset_rows_start(void *dst, size_t stride, size_t row_bytes, size_t rows, uint32_t pattern);
+    void lcd_memset_wait(void);
+    bool lcd_memset_busy(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,96 @@
+// Opt-in profiling of the lcd driver: time and pixels per kind of drawing
+// call, and for the conversion and transfer of the frames sent by lcd_swap.
+//
+// Build the driver and the application with LCD_PROFILE=1 to turn it on.
+// Without it the hooks compile to nothing and lcd_get_profile reports zeros.
+// Times are in ticks of LcdProfile.clock_hz: CPU cycles on Arm, microseconds
+// on RISC-V, nanoseconds in host builds.
+//
+// Only the outermost drawing call is counted, so lcd_draw_text is one TEXT
+// call, not one per character. Conversion done from an interrupt (or by a
+// fill the call had to wait for) is taken out of the call it interrupted and
+// counted where it belongs.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef LCD_PROFILE
+#define LCD_PROFILE 0
+#endif
+
+typedef enum
+{
+    LCD_PROFILE_FILL,          // lcd_fill, lcd_fill_rect, lcd_fill_rect_blend, waits for the fill DMA
+    LCD_PROFILE_SHAPE,         // pixels, lines, outlines, circles, arcs, triangles, polygons
+    LCD_PROFILE_TEXT,          // characters and strings, fixed and proportional fonts
+    LCD_PROFILE_BLIT,          // blits, images, sprites and tilemaps
+    LCD_PROFILE_SWAP_CONVERT,  // framebuffer to panel format (or band rendering), per chunk
+    LCD_PROFILE_SWAP_TRANSFER, // first chunk started to last byte on the panel, per frame
+    LCD_PROFILE_KINDS
+} LcdProfileKind;
+
+typedef struct
+{
+    uint32_t calls;  // Drawing calls, chunks converted or frames sent
+    uint64_t cycles; // Time spent, in ticks of LcdProfile.clock_hz
+    uint64_t pixels; // Pixels drawn (dirty bounding boxes in the SDK driver), converted or sent
+} LcdProfileCounter;
+
+typedef struct
+{
+    LcdProfileCounter counters[LCD_PROFILE_KINDS];
+    uint32_t frames;     // Frames sent to the panel
+    float fps;           // Frames per second over elapsed_us
+    uint64_t elapsed_us; // Time since lcd_init or lcd_reset_profile
+    uint32_t clock_hz;   // Ticks per second of the cycles fields
+} LcdProfile;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    void lcd_get_profile(LcdProfile *profile);
+    void lcd_reset_profile(void);
+    const char *lcd_profile_name(LcdProfileKind kind); // "fill", "shape", "text", ...
+    void lcd_profile_init(void); // driver: start the cycle counter of the calling core
+
+#if LCD_PROFILE
+    // Hooks for the driver, through the macros below
+    typedef struct
+    {
+        uint32_t start;   // lcd_profile_now() when the scope was entered
+        uint32_t charged; // cycles charged elsewhere on this core by then
+        uint32_t pixels;  // lcd_profile_pixel_count by then, or the pixels of a charge
+        uint8_t kind;
+        uint8_t mode; // what lcd_profile_end does with it
+    } lcd_profile_scope_t;
+
+    extern uint32_t lcd_profile_pixel_count; // bumped by LCD_PROFILE_PIXELS
+
+    uint32_t lcd_profile_now(void);
+    lcd_profile_scope_t lcd_profile_begin_draw(uint8_t kind);
+    lcd_profile_scope_t lcd_profile_begin_charge(uint8_t kind, uint32_t pixels);
+    void lcd_profile_end(lcd_profile_scope_t *scope);
+    void lcd_profile_count(uint8_t kind, uint32_t cycles, uint32_t pixels);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#if LCD_PROFILE
+// Count the rest of the enclosing block as a drawing call of the given kind
+#define LCD_PROFILE_DRAW(kind) \
+    lcd_profile_scope_t lcd_profile_scope __attribute__((cleanup(lcd_profile_end))) = lcd_profile_begin_draw(kind)
+// Count the rest of the enclosing block as work for the given kind, also
+// when it interrupts a drawing call; a call is counted when pixels is not 0
+#define LCD_PROFILE_CHARGE(kind, pixels) \
+    lcd_profile_scope_t lcd_profile_scope __attribute__((cleanup(lcd_profile_end))) = lcd_profile_begin_charge(kind, pixels)
+// Add pixels to the drawing call in progress
+#define LCD_PROFILE_PIXELS(count) (lcd_profile_pixel_count += (count))
+#else
+#define LCD_PROFILE_DRAW(kind) ((void)0)
+#define LCD_PROFILE_CHARGE(kind, pixels) ((void)0)
+#define LCD_PROFILE_PIXELS(count) ((void)0)
+#endif
@@ -0,0 +1,104 @@
+// Chunk ring for the dual-core swap (LCD_DUAL_CORE in the board's lcd.h).
+//
+// Core1 is the producer: it expands the regions of the frame chunk by chunk,
+// each into the line buffer of a free slot, and publishes the slot. Core0 is
+// the consumer: its DMA IRQ sends the oldest published chunk and releases
+// the slot once DMA has read it, so core1 fills the next chunk while DMA
+// drains the previous one. One producer and one consumer, each index
+// written by one side only, so no lock is needed.
+//
+// A chunk carries the index of the region it belongs to. The driver
+// publishes one more slot with size 0 and the region count after the last
+// chunk, which tells the consumer the frame is complete.
+//
+// Slot n of the ring owns line buffer n of the driver, which has
+// LCD_RING_SLOTS of them in dual-core mode. A chunk sent straight from the
+// framebuffer leaves its line buffer unused.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef LCD_RING_SLOTS
+#define LCD_RING_SLOTS 4 // Chunks in flight between the cores, a power of two
+#endif
+
+#ifndef LCD_RING_WAIT
+#define LCD_RING_WAIT() ((void)0) // Body of the wait loops, each core spins on its own
+#endif
+
+typedef struct
+{
+    const void *data; // Chunk for DMA, in a line buffer or the framebuffer
+    size_t size;      // Its size in DMA transfers, 0 ends the frame
+    uint8_t area;     // Region of the frame the chunk belongs to
+} lcd_ring_slot_t;
+
+typedef struct
+{
+    lcd_ring_slot_t slots[LCD_RING_SLOTS];
+    volatile uint32_t head; // Slots published, written by the producer only
+    volatile uint32_t tail; // Slots released, written by the consumer only
+} lcd_ring_t;
+
+/******************************************************************************
+function: Wait for a free slot (producer)
+parameter:
+    ring : Chunk ring
+returns: Index of the slot, and of the line buffer to fill
+******************************************************************************/
+static inline uint32_t lcd_ring_acquire(lcd_ring_t *ring)
+{
+    while (ring->head - ring->tail == LCD_RING_SLOTS)
+        LCD_RING_WAIT(); // DMA still reads every slot
+    __sync_synchronize(); // done reading the line buffer before we overwrite it
+    return ring->head % LCD_RING_SLOTS;
+}
+
+/******************************************************************************
+function: Hand the acquired slot to the consumer (producer)
+parameter:
+    ring : Chunk ring
+    data : Chunk for DMA
+    size : Its size in DMA transfers, 0 for the end of the frame
+    area : Region the chunk belongs to, the region count at the end
+returns: none
+******************************************************************************/
+static inline void lcd_ring_publish(lcd_ring_t *ring, const void *data, size_t size, uint8_t area)
+{
+    lcd_ring_slot_t *slot = &ring->slots[ring->head % LCD_RING_SLOTS];
+    slot->data = data;
+    slot->size = size;
+    slot->area = area;
+    __sync_synchronize(); // chunk and slot written before the consumer sees them
+    ring->head++;
+}
+
+/******************************************************************************
+function: Wait for the oldest published slot (consumer)
+parameter:
+    ring : Chunk ring
+returns: The slot, which stays published until lcd_ring_release
+note: Called from the DMA IRQ. Core1 is normally a few chunks ahead, it only
+      waits here when expanding a chunk takes longer than sending one.
+******************************************************************************/
+static inline const lcd_ring_slot_t *lcd_ring_peek(lcd_ring_t *ring)
+{
+    while (ring->head == ring->tail)
+        LCD_RING_WAIT(); // core1 is still expanding the chunk
+    __sync_synchronize();
+    return &ring->slots[ring->tail % LCD_RING_SLOTS];
+}
+
+/******************************************************************************
+function: Give the oldest slot back to the producer (consumer)
+parameter:
+    ring : Chunk ring
+returns: none
+note: Only once DMA has read the chunk, its line buffer is refilled next
+******************************************************************************/
+static inline void lcd_ring_release(lcd_ring_t *ring)
+{
+    __sync_synchronize();
+    ring->tail++;
+}
@@ -0,0 +1,40 @@
+def main():
+    """Animate the screen from one asyncio task while another keeps counting"""
+
+    import asyncio
+    from time import ticks_ms, ticks_diff
+    from waveshare_lcd import COLOR_BLACK, COLOR_WHITE, LCD_WIDTH, LCD_HEIGHT
+    from lcd import LCD
+
+    lcd = LCD()
+    ticks = 0
+
+    async def counter():
+        nonlocal ticks
+        while True:
+            ticks += 1
+            await asyncio.sleep_ms(0)
+
+    async def animate(frames):
+        size = min(LCD_WIDTH, LCD_HEIGHT) // 4
+        start = ticks_ms()
+        for frame in range(frames):
+            x = frame * 4 % (LCD_WIDTH - size)
+            # The previous frame has been sent once swap_async returned, so
+            # the framebuffer is free to draw into
+            lcd.fill_screen(COLOR_BLACK)
+            lcd.fill_rect(x, (LCD_HEIGHT - size) // 2, size, size, COLOR_WHITE)
+            await lcd.swap_async()
+        ms = ticks_diff(ticks_ms(), start)
+        print(f"{frames * 1000 // ms} fps, counter ran {ticks} times meanwhile")
+
+    async def run():
+        task = asyncio.create_task(counter())
+        await animate(100)
+        task.cancel()
+
+    asyncio.run(run())
+
+
+if __name__ == "__main__":
+    main()
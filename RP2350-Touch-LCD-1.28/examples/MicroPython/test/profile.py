@@ -0,0 +1,39 @@
+def main():
+    """Draw a mixed scene for a while and print where the time went
+
+    Needs firmware built with LCD_PROFILE=1 (make LCD_PROFILE=1, or
+    CMAKE_ARGS=-DLCD_PROFILE=ON), otherwise every counter stays zero.
+    """
+
+    from waveshare_lcd import PROFILE, COLOR_BLACK, COLOR_WHITE, COLOR_RED, COLOR_GREEN, COLOR_BLUE
+    from waveshare_lcd import LCD_WIDTH, LCD_HEIGHT
+    from lcd import LCD
+
+    if not PROFILE:
+        print("built without LCD_PROFILE, nothing to report")
+        return
+
+    lcd = LCD()
+    lcd.profile_reset()
+    size = min(LCD_WIDTH, LCD_HEIGHT) // 4
+    for frame in range(100):
+        x = frame * 3 % (LCD_WIDTH - size)
+        lcd.fill_screen(COLOR_BLACK)
+        lcd.fill_rect(x, LCD_HEIGHT // 4, size, size, COLOR_RED)
+        lcd.fill_circle(LCD_WIDTH // 2, LCD_HEIGHT // 2, size // 2, COLOR_GREEN)
+        lcd.draw_line(0, 0, LCD_WIDTH - 1, frame * 2 % LCD_HEIGHT, COLOR_BLUE)
+        lcd.draw_text(x, LCD_HEIGHT * 3 // 4, "frame %d" % frame, COLOR_WHITE)
+        lcd.swap()
+
+    p = lcd.profile()
+    us_per_tick = 1_000_000 / p["clock_hz"]
+    print(f"{p['frames']} frames in {p['elapsed_us'] // 1000} ms, {p['fps']:.1f} fps")
+    print(f"{'kind':<14}{'calls':>8}{'us/call':>10}{'pixels/call':>13}")
+    for kind in ("fill", "shape", "text", "blit", "swap_convert", "swap_transfer"):
+        calls, ticks, pixels = p[kind]
+        if calls:
+            print(f"{kind:<14}{calls:>8}{ticks * us_per_tick / calls:>10.1f}{pixels // calls:>13}")
+
+
+if __name__ == "__main__":
+    main()
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
-#include "lcd/lcd.h"
+#include "lcd.h"
+#include "lcd_sprite.h"
+#include "lcd_profile.h"
 #include "touch/touch.h"
 #include "battery/battery.h"
 #include "qmi/qmi.h"
@@ -54,6 +56,77 @@ void touch_callback(uint gpio, uint32_t events)
     }
 }
 
+// Compare a full-screen update the way lcd_swap used to do it (one blocking
+// SPI call per pixel) with the DMA flush lcd_swap uses now, and show both
+// frame rates on screen and over USB.
+void swap_benchmark(void)
+{
+    const int frames = 30;
+    char text[32];
+
+    // Before: one spi_write_blocking call per pixel
+    uint32_t start_us = time_us_32();
+    for (int f = 0; f < frames; f++)
+    {
+        lcd_write_cmd(0x2A);
+        lcd_write_data(0);
+        lcd_write_data(0);
+        lcd_write_data((LCD_WIDTH - 1) >> 8);
+        lcd_write_data((LCD_WIDTH - 1) & 0xFF);
+        lcd_write_cmd(0x2B);
+        lcd_write_data(0);
+        lcd_write_data(0);
+        lcd_write_data((LCD_HEIGHT - 1) >> 8);
+        lcd_write_data((LCD_HEIGHT - 1) & 0xFF);
+        lcd_write_cmd(0x2C);
+
+        uint16_t color = (f & 1) ? COLOR_BLUE : COLOR_RED;
+        for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++)
+            lcd_write_data_16bit(color);
+    }
+    float per_pixel_fps = frames * 1000000.0f / (time_us_32() - start_us);
+
+    // After: full framebuffer through lcd_swap
+    start_us = time_us_32();
+    for (int f = 0; f < frames; f++)
+    {
+        lcd_fill((f & 1) ? COLOR_BLUE : COLOR_RED);
+        lcd_swap();
+    }
+    float dma_fps = frames * 1000000.0f / (time_us_32() - start_us);
+
+    printf("Full-screen swap: per-pixel SPI %.1f FPS, DMA %.1f FPS\r\n", per_pixel_fps, dma_fps);
+
+    lcd_fill(COLOR_BLACK);
+    snprintf(text, sizeof(text), "Per-pixel: %.1f FPS", per_pixel_fps);
+    lcd_draw_text(50, 100, text, COLOR_WHITE);
+    snprintf(text, sizeof(text), "DMA:       %.1f FPS", dma_fps);
+    lcd_draw_text(50, 130, text, COLOR_GREEN);
+    lcd_swap();
+
+    sleep_ms(3000);
+}
+
+#if LCD_PROFILE
+// Print the driver's counters over USB and start counting again. Built with
+// cmake -DLCD_PROFILE=ON only.
+void print_profile(const char *label)
+{
+    LcdProfile profile;
+    lcd_get_profile(&profile);
+    printf("%s: %lu frames, %.1f FPS\r\n", label, (unsigned long)profile.frames, profile.fps);
+    for (int k = 0; k < LCD_PROFILE_KINDS; k++)
+    {
+        const LcdProfileCounter *counter = &profile.counters[k];
+        if (counter->calls == 0)
+            continue;
+        printf("  %-13s %6lu calls %9.1f us %10llu pixels\r\n", lcd_profile_name(k), (unsigned long)counter->calls,
+               counter->cycles * 1e6 / profile.clock_hz, (unsigned long long)counter->pixels);
+    }
+    lcd_reset_profile();
+}
+#endif
+
 int main()
 {
     stdio_init_all();
@@ -84,20 +157,33 @@ int main()
 
     sleep_ms(5000); // Show static demo for 5 seconds
 
-    uint8_t frame = 0;
-    uint8_t rotations = 10;
-    while (rotations--)
+    swap_benchmark(); // Measure lcd_swap throughput
+
+    // Walk the sprite across the screen and back. Only the rectangles it
+    // leaves and enters are redrawn and sent.
+    const uint8_t *frames[3] = {frame_0, frame_1, frame_2};
+    lcd_fill(COLOR_BLACK);
+    lcd_sprite_set_background(COLOR_BLACK);
+    int8_t walker = lcd_sprite_add(frame_0, 16, 15, 0);
+    int16_t walker_x = 0, step = 2;
+    for (int tick = 0; tick < 300; tick++)
     {
-        frame = 0;
-        while (frame < 3)
+        walker_x += step;
+        if (walker_x <= 0 || walker_x >= LCD_WIDTH - 16)
         {
-            lcd_fill(COLOR_BLACK);
-            lcd_blit(110, 110, 16, 15, frame == 0 ? frame_0 : (frame == 1 ? frame_1 : frame_2));
-            lcd_swap();
-            sleep_ms(200);
-            frame++;
+            step = -step;
+            lcd_sprite_set_flags(walker, step < 0 ? LCD_BLIT_FLIP_X : 0);
         }
+        lcd_sprite_move(walker, walker_x, 110);
+        lcd_sprite_set_image(walker, frames[(tick / 4) % 3]);
+        lcd_sprite_update();
+        lcd_swap();
+        sleep_ms(20);
     }
+    lcd_sprite_remove(walker);
+#if LCD_PROFILE
+    print_profile("Sprite demo");
+#endif
     // Demo 2: Animation loop
     uint8_t angle = 0;
 
@@ -131,5 +217,9 @@ int main()
 
         // Update for next frame
         angle++;
+#if LCD_PROFILE
+        if (angle == 0)
+            print_profile("Animation");
+#endif
     }
 }
@@ -1,7 +1,9 @@
 WAVESHARE_BATTERY_MOD_DIR := $(USERMOD_DIR)
+WAVESHARE_BATTERY_DRIVER_DIR := $(USERMOD_DIR)/../../SDK/battery
 
 # Add all C files to SRC_USERMOD.
 SRC_USERMOD += $(WAVESHARE_BATTERY_MOD_DIR)/waveshare_battery.c
-SRC_USERMOD += $(WAVESHARE_BATTERY_MOD_DIR)/battery.c
+SRC_USERMOD += $(WAVESHARE_BATTERY_DRIVER_DIR)/battery.c
 # We can add our module folder to include paths if needed
-CFLAGS_USERMOD += -I$(WAVESHARE_BATTERY_MOD_DIR)
\ No newline at end of file
+CFLAGS_USERMOD += -I$(WAVESHARE_BATTERY_MOD_DIR)
+CFLAGS_USERMOD += -I$(WAVESHARE_BATTERY_DRIVER_DIR)
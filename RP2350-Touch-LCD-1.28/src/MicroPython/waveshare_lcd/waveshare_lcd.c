@@ -8,6 +8,7 @@
 #include "py/objarray.h"
 #include "py/mphal.h"
 #include "lcd.h"
+#include "lcd_profile.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -16,6 +17,27 @@
 #define STATIC static
 #endif
 
+// framebuffer() and framebuf() hand out one RGB332 byte per pixel
+#if LCD_COLOR_DEPTH != 8 || (defined(LCD_TILED) && LCD_TILED)
+#error "waveshare_lcd needs the RGB332 framebuffer of the lcd driver (LCD_COLOR_DEPTH 8, no LCD_TILED)"
+#endif
+
+// Set once framebuffer() has handed out the framebuffer. Python then writes
+// pixels the driver does not see, so fills are finished before control
+// returns to Python, and every swap sends the whole screen until Python
+// reports its writes with mark_dirty().
+STATIC bool framebuffer_shared = false;
+STATIC bool framebuffer_marked = false; // set by mark_dirty(), swaps then send only the dirty regions
+
+// Wait for a background fill when Python may write the framebuffer next
+STATIC void waveshare_lcd_fill_sync(void)
+{
+    if (framebuffer_shared)
+    {
+        lcd_fill_wait();
+    }
+}
+
 // Function to get backlight level
 STATIC mp_obj_t waveshare_lcd_get_backlight_level(void)
 {
@@ -59,13 +81,51 @@ STATIC mp_obj_t waveshare_lcd_set_backlight_level(size_t n_args, const mp_obj_t
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_lcd_set_backlight_level_obj, 1, 1, waveshare_lcd_set_backlight_level);
 
-// Function to "swap" the framebuffer to the display
-STATIC mp_obj_t waveshare_lcd_swap(void)
+// Wait for the frame transfer while still running scheduled callbacks and
+// letting Ctrl-C through
+STATIC void waveshare_lcd_swap_wait(void)
 {
-    lcd_swap();
+    while (lcd_swap_busy())
+    {
+        mp_handle_pending(true);
+    }
+}
+
+// Function to "swap" the framebuffer to the display. With block=False it
+// returns once the transfer is started; poll swap_done() before drawing
+// the next frame
+STATIC mp_obj_t waveshare_lcd_swap(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    enum
+    {
+        ARG_block
+    };
+    static const mp_arg_t allowed_args[] = {
+        {MP_QSTR_block, MP_ARG_BOOL, {.u_bool = true}},
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    waveshare_lcd_swap_wait(); // the previous frame, before lcd_swap_async blocks on it
+    if (framebuffer_shared && !framebuffer_marked)
+    {
+        lcd_invalidate();
+    }
+    lcd_swap_async();
+    if (args[ARG_block].u_bool)
+    {
+        waveshare_lcd_swap_wait();
+    }
     return mp_const_none;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_lcd_swap_obj, waveshare_lcd_swap);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(waveshare_lcd_swap_obj, 0, waveshare_lcd_swap);
+
+// Check whether the frame started by swap() has reached the display
+STATIC mp_obj_t waveshare_lcd_swap_done(void)
+{
+    return mp_obj_new_bool(!lcd_swap_busy());
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_lcd_swap_done_obj, waveshare_lcd_swap_done);
 
 // Draw pixel in 16-bit framebuffer
 STATIC mp_obj_t waveshare_lcd_draw_pixel(size_t n_args, const mp_obj_t *args)
@@ -76,8 +136,8 @@ STATIC mp_obj_t waveshare_lcd_draw_pixel(size_t n_args, const mp_obj_t *args)
         mp_raise_ValueError(MP_ERROR_TEXT("draw_pixel requires 3 arguments: x, y, color"));
     }
 
-    uint8_t x = mp_obj_get_int(args[0]);
-    uint8_t y = mp_obj_get_int(args[1]);
+    uint16_t x = mp_obj_get_int(args[0]);
+    uint16_t y = mp_obj_get_int(args[1]);
     uint16_t color = mp_obj_get_int(args[2]);
 
     lcd_draw_pixel(x, y, color);
@@ -95,6 +155,7 @@ STATIC mp_obj_t waveshare_lcd_fill_screen(size_t n_args, const mp_obj_t *args)
     }
     uint16_t color = mp_obj_get_int(args[0]);
     lcd_fill(color);
+    waveshare_lcd_fill_sync();
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_lcd_fill_screen_obj, 1, 1, waveshare_lcd_fill_screen);
@@ -108,10 +169,10 @@ STATIC mp_obj_t waveshare_lcd_blit(size_t n_args, const mp_obj_t *args)
         mp_raise_ValueError(MP_ERROR_TEXT("blit requires 5 arguments: x, y, width, height, buffer"));
     }
 
-    uint8_t x = mp_obj_get_int(args[0]);
-    uint8_t y = mp_obj_get_int(args[1]);
-    uint8_t width = mp_obj_get_int(args[2]);
-    uint8_t height = mp_obj_get_int(args[3]);
+    uint16_t x = mp_obj_get_int(args[0]);
+    uint16_t y = mp_obj_get_int(args[1]);
+    uint16_t width = mp_obj_get_int(args[2]);
+    uint16_t height = mp_obj_get_int(args[3]);
 
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(args[4], &bufinfo, MP_BUFFER_READ);
@@ -128,6 +189,66 @@ STATIC mp_obj_t waveshare_lcd_blit(size_t n_args, const mp_obj_t *args)
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_lcd_blit_obj, 5, 5, waveshare_lcd_blit);
 
+// Get the framebuffer as a writable memoryview, one RGB332 byte per pixel
+STATIC mp_obj_t waveshare_lcd_framebuffer(void)
+{
+    framebuffer_shared = true;
+    lcd_fill_wait();
+    return mp_obj_new_memoryview('B' | MP_OBJ_ARRAY_TYPECODE_FLAG_RW, LCD_WIDTH * LCD_HEIGHT, lcd_get_framebuffer());
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_lcd_framebuffer_obj, waveshare_lcd_framebuffer);
+
+// Get a framebuf.FrameBuffer drawing straight into the framebuffer
+STATIC mp_obj_t waveshare_lcd_framebuf(void)
+{
+    // GS8 stores one byte per pixel, which here is an RGB332 color (see color332)
+    mp_obj_t framebuf = mp_import_name(MP_QSTR_framebuf, mp_const_none, MP_OBJ_NEW_SMALL_INT(0));
+    mp_obj_t args[4] = {
+        waveshare_lcd_framebuffer(),
+        MP_OBJ_NEW_SMALL_INT(LCD_WIDTH),
+        MP_OBJ_NEW_SMALL_INT(LCD_HEIGHT),
+        mp_load_attr(framebuf, MP_QSTR_GS8),
+    };
+    return mp_call_function_n_kw(mp_load_attr(framebuf, MP_QSTR_FrameBuffer), 4, 0, args);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_lcd_framebuf_obj, waveshare_lcd_framebuf);
+
+// Mark a region written through framebuffer() or framebuf() for the next
+// swap. From the first call on, swaps no longer resend the whole screen
+STATIC mp_obj_t waveshare_lcd_mark_dirty(size_t n_args, const mp_obj_t *args)
+{
+    // Arguments: x, y, width, height
+    if (n_args != 4)
+    {
+        mp_raise_ValueError(MP_ERROR_TEXT("mark_dirty requires 4 arguments: x, y, width, height"));
+    }
+
+    uint16_t x = mp_obj_get_int(args[0]);
+    uint16_t y = mp_obj_get_int(args[1]);
+    uint16_t width = mp_obj_get_int(args[2]);
+    uint16_t height = mp_obj_get_int(args[3]);
+
+    framebuffer_marked = true;
+    lcd_mark_dirty(x, y, width, height);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_lcd_mark_dirty_obj, 4, 4, waveshare_lcd_mark_dirty);
+
+// Resend the whole framebuffer on the next swap
+STATIC mp_obj_t waveshare_lcd_invalidate(void)
+{
+    lcd_invalidate();
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_lcd_invalidate_obj, waveshare_lcd_invalidate);
+
+// Convert an RGB565 color to the value stored in the framebuffer
+STATIC mp_obj_t waveshare_lcd_color332(mp_obj_t color)
+{
+    return MP_OBJ_NEW_SMALL_INT(lcd_framebuffer_color(mp_obj_get_int(color)));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(waveshare_lcd_color332_obj, waveshare_lcd_color332);
+
 // Draw a line
 STATIC mp_obj_t waveshare_lcd_draw_line(size_t n_args, const mp_obj_t *args)
 {
@@ -164,6 +285,7 @@ STATIC mp_obj_t waveshare_lcd_draw_rect(size_t n_args, const mp_obj_t *args)
     uint16_t color = mp_obj_get_int(args[4]);
 
     lcd_draw_rect(x, y, width, height, color);
+    waveshare_lcd_fill_sync();
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_lcd_draw_rect_obj, 5, 5, waveshare_lcd_draw_rect);
@@ -184,6 +306,7 @@ STATIC mp_obj_t waveshare_lcd_fill_rect(size_t n_args, const mp_obj_t *args)
     uint16_t color = mp_obj_get_int(args[4]);
 
     lcd_fill_rect(x, y, width, height, color);
+    waveshare_lcd_fill_sync();
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_lcd_fill_rect_obj, 5, 5, waveshare_lcd_fill_rect);
@@ -235,12 +358,12 @@ STATIC mp_obj_t waveshare_lcd_fill_triangle(size_t n_args, const mp_obj_t *args)
         mp_raise_ValueError(MP_ERROR_TEXT("fill_triangle requires 7 arguments: x1, y1, x2, y2, x3, y3, color"));
     }
 
-    uint16_t x1 = mp_obj_get_int(args[0]);
-    uint16_t y1 = mp_obj_get_int(args[1]);
-    uint16_t x2 = mp_obj_get_int(args[2]);
-    uint16_t y2 = mp_obj_get_int(args[3]);
-    uint16_t x3 = mp_obj_get_int(args[4]);
-    uint16_t y3 = mp_obj_get_int(args[5]);
+    int16_t x1 = mp_obj_get_int(args[0]);
+    int16_t y1 = mp_obj_get_int(args[1]);
+    int16_t x2 = mp_obj_get_int(args[2]);
+    int16_t y2 = mp_obj_get_int(args[3]);
+    int16_t x3 = mp_obj_get_int(args[4]);
+    int16_t y3 = mp_obj_get_int(args[5]);
     uint16_t color = mp_obj_get_int(args[6]);
 
     lcd_fill_triangle(x1, y1, x2, y2, x3, y3, color);
@@ -323,6 +446,152 @@ STATIC mp_obj_t waveshare_lcd_set_font(size_t n_args, const mp_obj_t *args)
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_lcd_set_font_obj, 1, 1, waveshare_lcd_set_font);
 
+// Commands of the draw_batch buffer. Each one is its opcode followed by the
+// arguments of the matching single call, all as little-endian uint16 words
+// except the BATCH_FILL_TRIANGLE vertices, which are int16 and may be negative.
+// BATCH_TEXT is followed by x, y, color and the byte count of the text, then
+// by the text itself, padded with a zero byte to a whole word.
+#define BATCH_FILL 1          // color
+#define BATCH_PIXEL 2         // x, y, color
+#define BATCH_LINE 3          // x1, y1, x2, y2, color
+#define BATCH_RECT 4          // x, y, width, height, color
+#define BATCH_FILL_RECT 5     // x, y, width, height, color
+#define BATCH_CIRCLE 6        // center_x, center_y, radius, color
+#define BATCH_FILL_CIRCLE 7   // center_x, center_y, radius, color
+#define BATCH_FILL_TRIANGLE 8 // x1, y1, x2, y2, x3, y3, color
+#define BATCH_TEXT 9          // x, y, color, length
+#define BATCH_TEXT_MAX 255    // Longest text of one BATCH_TEXT command
+
+// Argument words after each opcode, 0 for the ones not in use
+STATIC const uint8_t batch_arg_words[] = {0, 1, 3, 5, 5, 5, 4, 4, 7, 4};
+
+// Draw a whole list of primitives in one call
+STATIC mp_obj_t waveshare_lcd_draw_batch(mp_obj_t buffer)
+{
+    // Arguments: buffer (bytes, bytearray or array('H') of commands)
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_READ);
+
+    // Words are read byte by byte, so a buffer or slice at any address works
+    const uint8_t *p = (const uint8_t *)bufinfo.buf;
+    const uint8_t *end = p + bufinfo.len;
+    uint16_t args[7];
+    mp_int_t count = 0;
+
+    // Commands are drawn as they are decoded; those before a bad one stay drawn
+    while (p < end)
+    {
+        if (end - p < 2)
+        {
+            mp_raise_ValueError(MP_ERROR_TEXT("draw_batch: command cut short"));
+        }
+        uint16_t op = p[0] | (p[1] << 8);
+        size_t words = op < sizeof(batch_arg_words) ? batch_arg_words[op] : 0;
+        if (words == 0)
+        {
+            mp_raise_ValueError(MP_ERROR_TEXT("draw_batch: unknown command"));
+        }
+        if ((size_t)(end - p) < (words + 1) * 2)
+        {
+            mp_raise_ValueError(MP_ERROR_TEXT("draw_batch: command cut short"));
+        }
+        for (size_t i = 0; i < words; i++)
+        {
+            args[i] = p[2 + 2 * i] | (p[3 + 2 * i] << 8);
+        }
+        p += (words + 1) * 2;
+
+        switch (op)
+        {
+        case BATCH_FILL:
+            lcd_fill(args[0]);
+            break;
+        case BATCH_PIXEL:
+            lcd_draw_pixel(args[0], args[1], args[2]);
+            break;
+        case BATCH_LINE:
+            lcd_draw_line(args[0], args[1], args[2], args[3], args[4]);
+            break;
+        case BATCH_RECT:
+            lcd_draw_rect(args[0], args[1], args[2], args[3], args[4]);
+            break;
+        case BATCH_FILL_RECT:
+            lcd_fill_rect(args[0], args[1], args[2], args[3], args[4]);
+            break;
+        case BATCH_CIRCLE:
+            lcd_draw_circle(args[0], args[1], args[2], args[3]);
+            break;
+        case BATCH_FILL_CIRCLE:
+            lcd_fill_circle(args[0], args[1], args[2], args[3]);
+            break;
+        case BATCH_FILL_TRIANGLE:
+            lcd_fill_triangle((int16_t)args[0], (int16_t)args[1], (int16_t)args[2], (int16_t)args[3],
+                              (int16_t)args[4], (int16_t)args[5], args[6]);
+            break;
+        case BATCH_TEXT:
+        {
+            char text[BATCH_TEXT_MAX + 1];
+            size_t length = args[3];
+            size_t padded = (length + 1) & ~(size_t)1;
+            if (length > BATCH_TEXT_MAX)
+            {
+                mp_raise_ValueError(MP_ERROR_TEXT("draw_batch: text longer than 255 bytes"));
+            }
+            if ((size_t)(end - p) < padded)
+            {
+                mp_raise_ValueError(MP_ERROR_TEXT("draw_batch: command cut short"));
+            }
+            memcpy(text, p, length);
+            text[length] = '\0';
+            p += padded;
+            lcd_draw_text(args[0], args[1], text, args[2]);
+            break;
+        }
+        }
+        count++;
+    }
+    waveshare_lcd_fill_sync();
+    return mp_obj_new_int(count);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(waveshare_lcd_draw_batch_obj, waveshare_lcd_draw_batch);
+
+// Read the profiling counters: a dict with fps, frames, elapsed_us, clock_hz
+// and a (calls, cycles, pixels) tuple for each of "fill", "shape", "text",
+// "blit", "swap_convert" and "swap_transfer". Cycles are ticks of clock_hz.
+// All zero unless the module is built with LCD_PROFILE=1, see PROFILE.
+STATIC mp_obj_t waveshare_lcd_profile(void)
+{
+    LcdProfile profile;
+    lcd_get_profile(&profile);
+
+    mp_obj_t dict = mp_obj_new_dict(4 + LCD_PROFILE_KINDS);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fps), mp_obj_new_float(profile.fps));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_frames), mp_obj_new_int_from_uint(profile.frames));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_elapsed_us), mp_obj_new_int_from_ull(profile.elapsed_us));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_clock_hz), mp_obj_new_int_from_uint(profile.clock_hz));
+    for (int kind = 0; kind < LCD_PROFILE_KINDS; kind++)
+    {
+        const LcdProfileCounter *counter = &profile.counters[kind];
+        const char *name = lcd_profile_name(kind);
+        mp_obj_t entry[3] = {
+            mp_obj_new_int_from_uint(counter->calls),
+            mp_obj_new_int_from_ull(counter->cycles),
+            mp_obj_new_int_from_ull(counter->pixels),
+        };
+        mp_obj_dict_store(dict, mp_obj_new_str(name, strlen(name)), mp_obj_new_tuple(3, entry));
+    }
+    return dict;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_lcd_profile_obj, waveshare_lcd_profile);
+
+// Clear the profiling counters and start measuring again
+STATIC mp_obj_t waveshare_lcd_profile_reset(void)
+{
+    lcd_reset_profile();
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_lcd_profile_reset_obj, waveshare_lcd_profile_reset);
+
 // Module globals table
 STATIC const mp_rom_map_elem_t waveshare_lcd_module_globals_table[] = {
     {MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_waveshare_lcd)},
@@ -331,6 +600,7 @@ STATIC const mp_rom_map_elem_t waveshare_lcd_module_globals_table[] = {
     {MP_ROM_QSTR(MP_QSTR_init), MP_ROM_PTR(&waveshare_lcd_init_obj)},
     {MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&waveshare_lcd_reset_obj)},
     {MP_ROM_QSTR(MP_QSTR_swap), MP_ROM_PTR(&waveshare_lcd_swap_obj)},
+    {MP_ROM_QSTR(MP_QSTR_swap_done), MP_ROM_PTR(&waveshare_lcd_swap_done_obj)},
     {MP_ROM_QSTR(MP_QSTR_get_backlight_level), MP_ROM_PTR(&waveshare_lcd_get_backlight_level_obj)},
     {MP_ROM_QSTR(MP_QSTR_set_backlight_level), MP_ROM_PTR(&waveshare_lcd_set_backlight_level_obj)},
 
@@ -338,6 +608,11 @@ STATIC const mp_rom_map_elem_t waveshare_lcd_module_globals_table[] = {
     {MP_ROM_QSTR(MP_QSTR_draw_pixel), MP_ROM_PTR(&waveshare_lcd_draw_pixel_obj)},
     {MP_ROM_QSTR(MP_QSTR_fill_screen), MP_ROM_PTR(&waveshare_lcd_fill_screen_obj)},
     {MP_ROM_QSTR(MP_QSTR_blit), MP_ROM_PTR(&waveshare_lcd_blit_obj)},
+    {MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&waveshare_lcd_framebuffer_obj)},
+    {MP_ROM_QSTR(MP_QSTR_framebuf), MP_ROM_PTR(&waveshare_lcd_framebuf_obj)},
+    {MP_ROM_QSTR(MP_QSTR_mark_dirty), MP_ROM_PTR(&waveshare_lcd_mark_dirty_obj)},
+    {MP_ROM_QSTR(MP_QSTR_invalidate), MP_ROM_PTR(&waveshare_lcd_invalidate_obj)},
+    {MP_ROM_QSTR(MP_QSTR_color332), MP_ROM_PTR(&waveshare_lcd_color332_obj)},
 
     // Shape drawing functions
     {MP_ROM_QSTR(MP_QSTR_draw_line), MP_ROM_PTR(&waveshare_lcd_draw_line_obj)},
@@ -347,6 +622,23 @@ STATIC const mp_rom_map_elem_t waveshare_lcd_module_globals_table[] = {
     {MP_ROM_QSTR(MP_QSTR_fill_circle), MP_ROM_PTR(&waveshare_lcd_fill_circle_obj)},
     {MP_ROM_QSTR(MP_QSTR_fill_triangle), MP_ROM_PTR(&waveshare_lcd_fill_triangle_obj)},
 
+    // Batched drawing
+    {MP_ROM_QSTR(MP_QSTR_draw_batch), MP_ROM_PTR(&waveshare_lcd_draw_batch_obj)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_FILL), MP_ROM_INT(BATCH_FILL)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_PIXEL), MP_ROM_INT(BATCH_PIXEL)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_LINE), MP_ROM_INT(BATCH_LINE)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_RECT), MP_ROM_INT(BATCH_RECT)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_FILL_RECT), MP_ROM_INT(BATCH_FILL_RECT)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_CIRCLE), MP_ROM_INT(BATCH_CIRCLE)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_FILL_CIRCLE), MP_ROM_INT(BATCH_FILL_CIRCLE)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_FILL_TRIANGLE), MP_ROM_INT(BATCH_FILL_TRIANGLE)},
+    {MP_ROM_QSTR(MP_QSTR_BATCH_TEXT), MP_ROM_INT(BATCH_TEXT)},
+
+    // Profiling, True in PROFILE when built with LCD_PROFILE=1
+    {MP_ROM_QSTR(MP_QSTR_profile), MP_ROM_PTR(&waveshare_lcd_profile_obj)},
+    {MP_ROM_QSTR(MP_QSTR_profile_reset), MP_ROM_PTR(&waveshare_lcd_profile_reset_obj)},
+    {MP_ROM_QSTR(MP_QSTR_PROFILE), LCD_PROFILE ? MP_ROM_TRUE : MP_ROM_FALSE},
+
     // Text rendering functions
     {MP_ROM_QSTR(MP_QSTR_draw_char), MP_ROM_PTR(&waveshare_lcd_draw_char_obj)},
     {MP_ROM_QSTR(MP_QSTR_draw_text), MP_ROM_PTR(&waveshare_lcd_draw_text_obj)},
@@ -8,6 +8,7 @@
 #include "py/objarray.h"
 #include "py/mphal.h"
 #include "touch.h"
+#include "hardware/sync.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -45,6 +46,7 @@ STATIC mp_obj_t waveshare_touch_init(size_t n_args, const mp_obj_t *args)
     }
     uint8_t mode = mp_obj_get_int(args[0]);
     bool result = touch_init(mode);
+    enable_interrupts(); // the touch interrupt needs them unmasked
     return mp_obj_new_bool(result);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(waveshare_touch_init_obj, 1, 1, waveshare_touch_init);
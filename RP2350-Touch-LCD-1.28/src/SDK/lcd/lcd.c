@@ -1,37 +1,54 @@
-#include "lcd.h"
+#include "lcd_internal.h"
+#include "lcd_expand.h"
+#include "lcd_memset.h"
+#include <string.h>
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#if LCD_DUAL_CORE
+#include "lcd_ring.h"
+#include "pico/multicore.h"
+#endif
+
+#if LCD_TILED
+#error "LCD_TILED is not supported by this panel driver, it streams the full framebuffer"
+#endif
+#if LCD_DUAL_CORE && LCD_COLOR_DEPTH == 16
+#error "LCD_DUAL_CORE needs LCD_COLOR_DEPTH 8, an RGB565 framebuffer is sent without expansion"
+#endif
 
 static bool lcd_initialized = false; // flag to indicate if the LCD is initialized
 
-// Static framebuffer (16-bit per pixel for RGB565)
-static uint8_t framebuffer[LCD_WIDTH * LCD_HEIGHT];
-static uint16_t palette[256]; // 256-color palette for RGB332
 static uint8_t backlight_level;
 static uint slice_num;
 
-static FontTable *current_font = NULL;
-
-/******************************************************************************
- * function: Convert a 16-bit RGB565 color to an 8-bit RGB332 color
- * parameter:
- *    color : 16-bit RGB565 color value
- * returns: 8-bit RGB332 color value
- ******************************************************************************/
-static uint8_t lcd_color565_to_332(uint16_t color)
-{
-    return ((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3);
-}
-/******************************************************************************
- * function: Convert 8-bit RGB332 components to a 16-bit RGB565 color
- * parameter:
- *    r : Red component (0-255)
- *    g : Green component (0-255)
- *    b : Blue component (0-255)
- * returns: 16-bit RGB565 color value
- ******************************************************************************/
-static uint16_t lcd_color332_to_565(uint8_t r, uint8_t g, uint8_t b)
-{
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-}
+#if LCD_DUAL_CORE
+// Line buffers of the chunk ring: core1 expands into the free ones while
+// DMA drains the others, see lcd_ring.h
+static uint16_t line_buffers[LCD_RING_SLOTS][LCD_WIDTH * LCD_CHUNK_LINES];
+static uint8_t swap_fill_buffer = 0;             // line buffer of the slot core1 fills
+static lcd_ring_t swap_ring;
+static void lcd_core1_entry(void);
+#elif LCD_COLOR_DEPTH != 16
+// Ping-pong line buffers for the DMA frame transfer: while DMA drains one,
+// the next chunk of the framebuffer is expanded into the other
+static uint16_t line_buffers[2][LCD_WIDTH * LCD_CHUNK_LINES];
+static uint8_t swap_fill_buffer = 0;             // line buffer the next chunk is expanded into
+#endif
+static int dma_tx = -1;                          // DMA channel feeding the SPI TX FIFO
+static volatile bool swap_busy = false;          // true while a frame is being streamed
+#if !LCD_DUAL_CORE
+static const uint16_t *volatile swap_pending_data = NULL; // next chunk ready for DMA
+static volatile size_t swap_pending_pixels = 0;  // size of that chunk, 0 when none is ready
+static volatile uint16_t swap_next_y = 0;        // first row of the region not yet prepared
+#endif
+static dirty_area_t swap_areas[LCD_MAX_DIRTY_AREAS]; // regions of the frame in flight
+static uint8_t swap_area_count = 0;
+static volatile uint8_t swap_area_index = 0;     // region currently being streamed
+static uint16_t swap_chunk_lines = LCD_CHUNK_LINES; // rows per DMA transfer for that region
+#if LCD_PROFILE
+static uint32_t swap_profile_start = 0;  // lcd_profile_now() when the frame started
+static uint32_t swap_profile_pixels = 0; // pixels of the frame in flight
+#endif
 
 /******************************************************************************
  * function: Initialize the backlight PWM for the LCD
@@ -50,477 +67,262 @@ static void lcd_backlight_init(void)
     pwm_set_enabled(slice_num, true);
 }
 
-/******************************************************************************
-function: Draw a single pixel to the framebuffer
-parameter:
-    X     : X coordinate (0 to LCD_WIDTH-1)
-    Y     : Y coordinate (0 to LCD_HEIGHT-1)
-    color : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_draw_pixel(uint8_t x, uint8_t y, uint16_t color)
+/********************************************************************************
+function: Get the current backlight brightness level
+parameter: none
+returns: Brightness level from 0 (off) to 100 (full)
+********************************************************************************/
+uint8_t lcd_get_backlight_level(void)
 {
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT)
-    {
-        return; // bounds check
-    }
-    // Convert to 8-bit and store
-    framebuffer[y * LCD_WIDTH + x] = lcd_color565_to_332(color);
+    return backlight_level;
 }
 
 /******************************************************************************
-function: Draw a line between two points using Bresenham's algorithm
+function: Send a command byte without waiting for a frame transfer
 parameter:
-    x1    : Starting X coordinate
-    y1    : Starting Y coordinate
-    x2    : Ending X coordinate
-    y2    : Ending Y coordinate
-    color : RGB565 color value
+    cmd : Command byte to send
 returns: none
 ******************************************************************************/
-void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+static void lcd_send_cmd(uint8_t cmd)
 {
-    int dx = abs((int)x2 - (int)x1);
-    int dy = abs((int)y2 - (int)y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-    const uint8_t color_index = lcd_color565_to_332(color);
-    while (true)
-    {
-        // Draw pixel if within bounds
-        if (x1 < LCD_WIDTH && y1 < LCD_HEIGHT)
-        {
-            framebuffer[y1 * LCD_WIDTH + x1] = color_index;
-        }
-
-        // Check if we've reached the end point
-        if (x1 == x2 && y1 == y2)
-            break;
-
-        int e2 = 2 * err;
-        if (e2 > -dy)
-        {
-            err -= dy;
-            x1 += sx;
-        }
-        if (e2 < dx)
-        {
-            err += dx;
-            y1 += sy;
-        }
-    }
+    gpio_put(LCD_DC_PIN, 0);
+    spi_write_blocking(LCD_SPI_PORT, &cmd, 1);
 }
 
 /******************************************************************************
-function: Draw a rectangle outline to the framebuffer
+function: Send data bytes without waiting for a frame transfer
 parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of rectangle
-    height : Height of rectangle
-    color  : RGB565 color value
+    data : Bytes to send
+    len  : Number of bytes
 returns: none
 ******************************************************************************/
-void lcd_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+static void lcd_send_data(const uint8_t *data, size_t len)
 {
-    const uint8_t color_index = lcd_color565_to_332(color);
-    // Draw four lines to form rectangle
-    lcd_draw_line(x, y, x + width - 1, y, color_index);                           // Top
-    lcd_draw_line(x, y + height - 1, x + width - 1, y + height - 1, color_index); // Bottom
-    lcd_draw_line(x, y, x, y + height - 1, color_index);                          // Left
-    lcd_draw_line(x + width - 1, y, x + width - 1, y + height - 1, color_index);  // Right
+    gpio_put(LCD_DC_PIN, 1);
+    spi_write_blocking(LCD_SPI_PORT, data, len);
 }
 
 /******************************************************************************
-function: Draw a filled rectangle to the framebuffer
+function: Rows per DMA transfer for a framebuffer region
 parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of rectangle
-    height : Height of rectangle
-    color  : RGB565 color value
-returns: none
+    area : Region to stream
+returns: Number of rows
 ******************************************************************************/
-void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+static uint16_t lcd_area_chunk_lines(const dirty_area_t *area)
 {
-    // Bounds clipping
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT)
-        return;
-
-    if (x + width > LCD_WIDTH)
-        width = LCD_WIDTH - x;
-    if (y + height > LCD_HEIGHT)
-        height = LCD_HEIGHT - y;
-
-    const uint8_t color_index = lcd_color565_to_332(color);
-
-    // Fast fill using optimized loops
-    for (uint16_t py = y; py < y + height; py++)
-    {
-        for (uint16_t px = x; px < x + width; px++)
-        {
-            framebuffer[py * LCD_WIDTH + px] = color_index;
-        }
-    }
+    uint16_t area_width = area->x1 - area->x0 + 1;
+#if LCD_COLOR_DEPTH == 16
+    // Full-width regions are contiguous in memory and go out in one transfer
+    return (area_width == LCD_WIDTH) ? (area->y1 - area->y0 + 1) : 1;
+#else
+    // Narrow regions fit more rows into one line buffer
+    return (LCD_WIDTH * LCD_CHUNK_LINES) / area_width;
+#endif
 }
 
 /******************************************************************************
-function: Draw a single character to the framebuffer
+function: Prepare the next chunk of a framebuffer region for DMA
 parameter:
-    x     : Top-left X coordinate
-    y     : Top-left Y coordinate
-    c     : Character to draw
-    color : RGB565 color value
-returns: none
+    area   : Region being streamed
+    y      : First framebuffer row of the chunk
+    pixels : Receives the chunk size in pixels
+returns: Address DMA should read the chunk from
+note: RGB332 rows are expanded into the next ping-pong line buffer, or in
+      dual-core mode into the line buffer of the ring slot being filled. A
+      native RGB565 framebuffer is sent straight from memory.
 ******************************************************************************/
-void lcd_draw_char(uint16_t x, uint16_t y, char c, uint16_t color)
+static const uint16_t *__not_in_flash_func(lcd_prepare_chunk)(const dirty_area_t *area, uint16_t y, size_t *pixels)
 {
-    if (current_font == NULL || c < 32 || c > 126)
-        return; // invalid font or character
-
-    // Calculate bytes per row (width rounded up to nearest byte boundary)
-    uint8_t bytes_per_row = (current_font->width + 7) / 8;
-    const uint8_t *char_data = &current_font->table[(c - 32) * current_font->height * bytes_per_row];
-
-    for (uint8_t row = 0; row < current_font->height; row++)
+    uint16_t area_width = area->x1 - area->x0 + 1;
+    uint16_t lines_to_send = (y + swap_chunk_lines > area->y1 + 1) ? (area->y1 + 1 - y) : swap_chunk_lines;
+
+    *pixels = (size_t)area_width * lines_to_send;
+    LCD_PROFILE_CHARGE(LCD_PROFILE_SWAP_CONVERT, (uint32_t)area_width * lines_to_send);
+
+#if LCD_COLOR_DEPTH == 16
+    return &lcd_framebuffer[y * LCD_WIDTH + area->x0];
+#else
+    uint16_t *buffer = line_buffers[swap_fill_buffer];
+    uint16_t *dst = buffer;
+#if !LCD_DUAL_CORE
+    swap_fill_buffer ^= 1;
+#endif
+
+    for (uint16_t line = 0; line < lines_to_send; line++)
     {
-        const uint8_t *row_data = &char_data[row * bytes_per_row];
-
-        for (uint8_t col = 0; col < current_font->width; col++)
-        {
-            uint8_t byte_index = col / 8;
-            uint8_t bit_index = 7 - (col % 8);
-
-            if (row_data[byte_index] & (1 << bit_index))
-            {
-                lcd_draw_pixel(x + col, y + row, color);
-            }
-        }
+        lcd_expand_rgb332(dst, &lcd_framebuffer[(y + line) * LCD_WIDTH + area->x0], area_width, lcd_palette);
+        dst += area_width;
     }
+    return buffer;
+#endif
 }
 
+#if LCD_DUAL_CORE
 /******************************************************************************
-function: Draw a circle outline to the framebuffer
-parameter:
-    center_x : Center X coordinate
-    center_y : Center Y coordinate
-    radius   : Radius in pixels
-    color    : RGB565 color value
+function: Core1 expansion loop
+parameter: none
 returns: none
+note: Waits for a region count from core0 on the inter-core FIFO and expands
+      swap_areas chunk by chunk into the ring, then publishes the end of the
+      frame. Core0's DMA IRQ sends the chunks, see lcd_ring.h.
 ******************************************************************************/
-void lcd_draw_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+static void lcd_core1_entry(void)
 {
-    if (radius == 0 || radius > 100)
-        return;
-
-    int x = 0;
-    int y = radius;
-    int d = 3 - 2 * radius;
-    const uint8_t color_index = lcd_color565_to_332(color);
-
-    while (x <= y)
-    {
-        // Draw 8 symmetric points
-        if (center_x + x < LCD_WIDTH && center_y + y < LCD_HEIGHT)
-            framebuffer[(center_y + y) * LCD_WIDTH + (center_x + x)] = color_index;
-        if (center_x - x < LCD_WIDTH && center_y + y < LCD_HEIGHT)
-            framebuffer[(center_y + y) * LCD_WIDTH + (center_x - x)] = color_index;
-        if (center_x + x < LCD_WIDTH && center_y - y < LCD_HEIGHT)
-            framebuffer[(center_y - y) * LCD_WIDTH + (center_x + x)] = color_index;
-        if (center_x - x < LCD_WIDTH && center_y - y < LCD_HEIGHT)
-            framebuffer[(center_y - y) * LCD_WIDTH + (center_x - x)] = color_index;
-        if (center_x + y < LCD_WIDTH && center_y + x < LCD_HEIGHT)
-            framebuffer[(center_y + x) * LCD_WIDTH + (center_x + y)] = color_index;
-        if (center_x - y < LCD_WIDTH && center_y + x < LCD_HEIGHT)
-            framebuffer[(center_y + x) * LCD_WIDTH + (center_x - y)] = color_index;
-        if (center_x + y < LCD_WIDTH && center_y - x < LCD_HEIGHT)
-            framebuffer[(center_y - x) * LCD_WIDTH + (center_x + y)] = color_index;
-        if (center_x - y < LCD_WIDTH && center_y - x < LCD_HEIGHT)
-            framebuffer[(center_y - x) * LCD_WIDTH + (center_x - y)] = color_index;
-
-        if (d < 0)
-            d += 4 * x + 6;
-        else
-        {
-            d += 4 * (x - y) + 10;
-            y--;
-        }
-        x++;
-    }
-}
-
-void lcd_draw_text(uint16_t x, uint16_t y, const char *text, uint16_t color)
-{
-    if (current_font == NULL)
-        return; // invalid font
-
-    uint16_t cursor_x = x;
-    uint16_t cursor_y = y;
-
-    while (*text)
+    lcd_profile_init(); // cycle counter of core1, which converts the frames
+    while (true)
     {
-        char ch = *text;
-
-        if (ch == '\n')
-        {
-            cursor_x = x;                     // Reset to start of line
-            cursor_y += current_font->height; // Move down one line
-        }
-        else if (ch == ' ')
+        uint8_t area_count = (uint8_t)multicore_fifo_pop_blocking();
+        for (uint8_t n = 0; n < area_count; n++)
         {
-            // Handle space - just advance position without drawing
-            cursor_x += current_font->width;
-        }
-        else
-        {
-            // Check if character would exceed screen width
-            if (cursor_x + current_font->width > LCD_WIDTH)
-            {
-                // Wrap to next line
-                cursor_x = x;
-                cursor_y += current_font->height;
-            }
-
-            // Check if we're still within screen height
-            if (cursor_y + current_font->height <= LCD_HEIGHT)
+            const dirty_area_t *area = &swap_areas[n];
+            swap_chunk_lines = lcd_area_chunk_lines(area);
+            for (uint16_t y = area->y0; y <= area->y1; y += swap_chunk_lines)
             {
-                lcd_draw_char(cursor_x, cursor_y, ch, color);
+                size_t pixels;
+                swap_fill_buffer = lcd_ring_acquire(&swap_ring);
+                const uint16_t *data = lcd_prepare_chunk(area, y, &pixels);
+                lcd_ring_publish(&swap_ring, data, pixels, n);
             }
-
-            cursor_x += current_font->width;
         }
-        text++;
+        lcd_ring_acquire(&swap_ring);
+        lcd_ring_publish(&swap_ring, NULL, 0, area_count);
     }
 }
+#endif
 
 /******************************************************************************
-function: Draw a filled circle to the framebuffer
-parameter:
-    center_x : Center X coordinate
-    center_y : Center Y coordinate
-    radius   : Radius in pixels
-    color    : RGB565 color value
+function: Start streaming the current region of the frame in flight
+parameter: none
 returns: none
+note: Sends the window commands as 8-bit frames, switches the SPI to 16-bit
+      frames, prepares the first two chunks and kicks the first DMA
+      transfer. The rest of the region is chained from the DMA IRQ. In
+      dual-core mode the first chunk comes from the ring instead.
 ******************************************************************************/
-void lcd_fill_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+static void lcd_swap_start_area(void)
 {
-    if (radius == 0 || radius > 100)
-        return;
-
-    const uint8_t color_index = lcd_color565_to_332(color);
-
-    int radius_squared = radius * radius;
-
-    // Calculate bounding box
-    int start_x = (center_x > radius) ? (center_x - radius) : 0;
-    int end_x = (center_x + radius < LCD_WIDTH) ? (center_x + radius) : (LCD_WIDTH - 1);
-    int start_y = (center_y > radius) ? (center_y - radius) : 0;
-    int end_y = (center_y + radius < LCD_HEIGHT) ? (center_y + radius) : (LCD_HEIGHT - 1);
+    const dirty_area_t *area = &swap_areas[swap_area_index];
+#if LCD_PROFILE
+    uint16_t area_width = area->x1 - area->x0 + 1;
+    swap_profile_pixels += (uint32_t)area_width * (area->y1 - area->y0 + 1);
+#endif
+
+    uint8_t caset[4] = {area->x0 >> 8, area->x0 & 0xFF, area->x1 >> 8, area->x1 & 0xFF};
+    uint8_t raset[4] = {area->y0 >> 8, area->y0 & 0xFF, area->y1 >> 8, area->y1 & 0xFF};
+
+    spi_set_format(LCD_SPI_PORT, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    lcd_send_cmd(0x2A);
+    lcd_send_data(caset, sizeof(caset));
+    lcd_send_cmd(0x2B);
+    lcd_send_data(raset, sizeof(raset));
+    lcd_send_cmd(0x2C);
+    gpio_put(LCD_DC_PIN, 1);
 
-    // Fill using distance check
-    for (int y = start_y; y <= end_y; y++)
+    // One RGB565 pixel per SPI frame, MSB first as the panel expects
+    spi_set_format(LCD_SPI_PORT, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+
+#if LCD_DUAL_CORE
+    // Core1 started expanding at lcd_swap_async, the chunk is usually ready
+    const lcd_ring_slot_t *slot = lcd_ring_peek(&swap_ring);
+    dma_channel_transfer_from_buffer_now(dma_tx, slot->data, slot->size);
+#else
+    swap_chunk_lines = lcd_area_chunk_lines(area);
+#if LCD_COLOR_DEPTH != 16
+    swap_fill_buffer = 0;
+#endif
+
+    // Prepare two chunks before DMA starts so the IRQ never waits on us
+    size_t first_pixels;
+    const uint16_t *first_data = lcd_prepare_chunk(area, area->y0, &first_pixels);
+    swap_next_y = area->y0 + swap_chunk_lines;
+    swap_pending_pixels = 0;
+    if (swap_next_y <= area->y1)
     {
-        int dy = y - center_y;
-        int dy_squared = dy * dy;
-
-        for (int x = start_x; x <= end_x; x++)
-        {
-            int dx = x - center_x;
-            int distance_squared = dx * dx + dy_squared;
-
-            if (distance_squared <= radius_squared)
-            {
-                framebuffer[y * LCD_WIDTH + x] = color_index;
-            }
-        }
+        size_t pixels;
+        swap_pending_data = lcd_prepare_chunk(area, swap_next_y, &pixels);
+        swap_pending_pixels = pixels;
+        swap_next_y += swap_chunk_lines;
     }
+
+    dma_channel_transfer_from_buffer_now(dma_tx, first_data, first_pixels);
+#endif
 }
 
 /******************************************************************************
-function: Draw a filled triangle to the framebuffer
-parameter:
-    x1, y1 : First vertex coordinates
-    x2, y2 : Second vertex coordinates
-    x3, y3 : Third vertex coordinates
-    color  : RGB565 color value
+function: DMA completion handler for the frame transfer
+parameter: none
 returns: none
+note: Hands the already prepared chunk to DMA and prepares the one after it,
+      or in dual-core mode releases the chunk DMA just read and sends the
+      next one core1 published. Once a region is done it waits for the SPI
+      to shift out the last pixels and moves on to the next region, or ends
+      the frame.
 ******************************************************************************/
-void lcd_fill_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t color)
+static void __no_inline_not_in_flash_func(lcd_dma_irq_handler)(void)
 {
-    // Sort vertices by Y coordinate (y1 <= y2 <= y3)
-    if (y1 > y2)
-    {
-        uint16_t temp = x1;
-        x1 = x2;
-        x2 = temp;
-        temp = y1;
-        y1 = y2;
-        y2 = temp;
-    }
-    if (y2 > y3)
-    {
-        uint16_t temp = x2;
-        x2 = x3;
-        x3 = temp;
-        temp = y2;
-        y2 = y3;
-        y3 = temp;
-    }
-    if (y1 > y2)
-    {
-        uint16_t temp = x1;
-        x1 = x2;
-        x2 = temp;
-        temp = y1;
-        y1 = y2;
-        y2 = temp;
-    }
-
-    // Handle degenerate case
-    if (y1 == y3)
+    if (!dma_channel_get_irq1_status(dma_tx))
         return;
+    dma_channel_acknowledge_irq1(dma_tx);
 
-    const uint8_t color_index = lcd_color565_to_332(color);
+    if (!swap_busy)
+        return;
 
-    // Fill the triangle using horizontal scanlines
-    for (uint16_t y = y1; y <= y3; y++)
+#if LCD_DUAL_CORE
+    lcd_ring_release(&swap_ring);
+    const lcd_ring_slot_t *slot = lcd_ring_peek(&swap_ring);
+    if (slot->area == swap_area_index)
     {
-        if (y >= LCD_HEIGHT)
-            break;
-
-        int x_left, x_right;
-        bool has_intersection = false;
-
-        // Find left edge intersection
-        if (y3 != y1)
-        {
-            x_left = x1 + (int)((x3 - x1) * (int)(y - y1)) / (int)(y3 - y1);
-            has_intersection = true;
-        }
-
-        // Find right edge intersection
-        if (y <= y2 && y2 != y1)
-        {
-            x_right = x1 + (int)((x2 - x1) * (int)(y - y1)) / (int)(y2 - y1);
-        }
-        else if (y > y2 && y3 != y2)
-        {
-            x_right = x2 + (int)((x3 - x2) * (int)(y - y2)) / (int)(y3 - y2);
-        }
-        else
-        {
-            x_right = x_left;
-        }
-
-        if (!has_intersection)
-            continue;
-
-        // Ensure x_left <= x_right
-        if (x_left > x_right)
-        {
-            int temp = x_left;
-            x_left = x_right;
-            x_right = temp;
-        }
-
-        // Clamp to screen bounds
-        if (x_left < 0)
-            x_left = 0;
-        if (x_right >= LCD_WIDTH)
-            x_right = LCD_WIDTH - 1;
-
-        // Draw horizontal line
-        for (int x = x_left; x <= x_right; x++)
-        {
-            framebuffer[y * LCD_WIDTH + x] = color_index;
-        }
+        dma_channel_transfer_from_buffer_now(dma_tx, slot->data, slot->size);
+        return;
     }
-}
-
-/******************************************************************************
-function: Fill the entire framebuffer with a solid color
-parameter:
-    color : RGB565 color value to fill with
-returns: none
-******************************************************************************/
-void lcd_fill(uint16_t color)
-{
-    const uint8_t color_index = lcd_color565_to_332(color);
-    for (uint32_t i = 0; i < LCD_HEIGHT * LCD_WIDTH; i++)
+#else
+    if (swap_pending_pixels > 0)
     {
-        framebuffer[i] = color_index;
-    }
-}
+        const dirty_area_t *area = &swap_areas[swap_area_index];
 
-/******************************************************************************
-function: Copy an external image buffer into the framebuffer at specified position
-parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of the buffer to blit
-    height : Height of the buffer to blit
-    buffer : Pointer to RGB332 pixel data array (8-bit per pixel)
-returns: none
-******************************************************************************/
-void lcd_blit(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *buffer)
-{
-    for (uint16_t j = 0; j < height; j++)
-    {
-        for (uint16_t i = 0; i < width; i++)
+        // Keep the bus busy first, then refill the line buffer DMA just released
+        dma_channel_transfer_from_buffer_now(dma_tx, swap_pending_data, swap_pending_pixels);
+        swap_pending_pixels = 0;
+
+        if (swap_next_y <= area->y1)
         {
-            if ((x + i) < LCD_WIDTH && (y + j) < LCD_HEIGHT)
-            {
-                framebuffer[(y + j) * LCD_WIDTH + (x + i)] = buffer[j * width + i];
-            }
+            size_t pixels;
+            swap_pending_data = lcd_prepare_chunk(area, swap_next_y, &pixels);
+            swap_pending_pixels = pixels;
+            swap_next_y += swap_chunk_lines;
         }
+        return;
     }
-}
+#endif
 
-/********************************************************************************
-function: Get the current backlight brightness level
-parameter: none
-returns: Brightness level from 0 (off) to 100 (full)
-********************************************************************************/
-uint8_t lcd_get_backlight_level(void)
-{
-    return backlight_level;
-}
+    // DMA only filled the FIFO, the last pixels are still being shifted out
+    while (spi_is_busy(LCD_SPI_PORT))
+        tight_loop_contents();
 
-/********************************************************************************
-function: Get the current font height
-parameter: none
-returns: Font height in pixels
-********************************************************************************/
-uint8_t lcd_get_font_height(void)
-{
-    if (current_font != NULL)
+    if (swap_area_index + 1 < swap_area_count)
     {
-        return current_font->height;
+        swap_area_index++;
+        lcd_swap_start_area();
+        return;
     }
-    return 0;
-}
 
-/********************************************************************************
-function: Get the current font width
-parameter: none
-returns: Font width in pixels
-********************************************************************************/
-uint8_t lcd_get_font_width(void)
-{
-    if (current_font != NULL)
-    {
-        return current_font->width;
-    }
-    return 0;
+#if LCD_DUAL_CORE
+    lcd_ring_release(&swap_ring); // end of the frame
+#endif
+    spi_set_format(LCD_SPI_PORT, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+#if LCD_PROFILE
+    lcd_profile_count(LCD_PROFILE_SWAP_TRANSFER, lcd_profile_now() - swap_profile_start, swap_profile_pixels);
+#endif
+    swap_busy = false;
 }
 
 /********************************************************************************
 function: Initialize the LCD display hardware and framebuffer
 parameter:
-    horizontal : true for horizontal/landscape mode, false for vertical/portrait mode
+    horizontal : true for rotation 0, false to start rotated by 90 degrees
 returns: none
-note: Can only be called once; subsequent calls are ignored
+note: Can only be called once; subsequent calls are ignored. The
+      orientation can be changed later with lcd_set_rotation.
 ********************************************************************************/
 void lcd_init(bool horizontal)
 {
@@ -549,6 +351,23 @@ void lcd_init(bool horizontal)
     gpio_set_function(LCD_CLK_PIN, GPIO_FUNC_SPI);
     gpio_set_function(LCD_MOSI_PIN, GPIO_FUNC_SPI);
 
+    // DMA for the pixel stream: one RGB565 value per transfer, paced by SPI TX
+    dma_tx = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_dreq(&c, spi_get_dreq(LCD_SPI_PORT, true));
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(dma_tx, &c, &spi_get_hw(LCD_SPI_PORT)->dr, NULL, 0, false);
+
+    dma_channel_set_irq1_enabled(dma_tx, true);
+    irq_add_shared_handler(DMA_IRQ_1, lcd_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+#if LCD_DUAL_CORE
+    // Core1 expands the chunks of every frame from here on
+    multicore_launch_core1(lcd_core1_entry);
+#endif
+
     // Hardware reset
     lcd_reset();
 
@@ -789,27 +608,17 @@ void lcd_init(bool horizontal)
     lcd_write_cmd(0x29);
     sleep_ms(20);
 
-    // init palette
-    for (int i = 0; i < 256; i++)
-    {
-        // Extract RGB332 components
-        uint8_t r3 = (i >> 5) & 0x07; // 3 bits for red
-        uint8_t g3 = (i >> 2) & 0x07; // 3 bits for green
-        uint8_t b2 = i & 0x03;        // 2 bits for blue
-
-        // Convert to 8-bit RGB
-        uint8_t r8 = (r3 * 255) / 7; // Scale 3-bit to 8-bit
-        uint8_t g8 = (g3 * 255) / 7; // Scale 3-bit to 8-bit
-        uint8_t b8 = (b2 * 255) / 3; // Scale 2-bit to 8-bit
-
-        // Convert to RGB565 for the palette
-        palette[i] = lcd_color332_to_565(r8, g8, b8);
-    }
+    lcd_palette_init(); // RGB332 palette, in panel byte order
 
     lcd_backlight_init(); // Initialize backlight PWM
 
     lcd_set_font(LCD_DEFAULT_FONT_SIZE); // Set default font
 
+    lcd_memset_init(); // DMA channel for lcd_fill and lcd_fill_rect
+    lcd_set_rotation(horizontal ? 0 : 90); // replaces the scan direction set above
+    lcd_invalidate(); // Panel RAM is undefined after reset, send everything once
+    lcd_profile_init(); // cycle counter for LCD_PROFILE
+
     lcd_initialized = true; // set the flag to indicate initialization is done
 }
 
@@ -854,29 +663,27 @@ void lcd_set_backlight_level(uint8_t brightness)
     pwm_set_chan_level(slice_num, PWM_CHAN_B, backlight_level);
 }
 
-void lcd_set_font(FontSize size)
+/******************************************************************************
+function: Apply a display orientation (called by lcd_set_rotation)
+parameter:
+    transform : LCD_SWAP_XY, LCD_FLIP_X and LCD_FLIP_Y bits
+returns: true, the controller handles every orientation
+note: The GC9A01 maps the window and the pixel order itself through the
+      memory access control register (0x36): MV exchanges rows and
+      columns, MX and MY reverse them. The framebuffer is sent unchanged.
+******************************************************************************/
+bool lcd_panel_orient(uint8_t transform)
 {
-    switch (size)
-    {
-    case FONT_XTRA_SMALL:
-        current_font = (FontTable *)&Font8;
-        break;
-    case FONT_SMALL:
-        current_font = (FontTable *)&Font12;
-        break;
-    case FONT_MEDIUM:
-        current_font = (FontTable *)&Font16;
-        break;
-    case FONT_LARGE:
-        current_font = (FontTable *)&Font20;
-        break;
-    case FONT_XTRA_LARGE:
-        current_font = (FontTable *)&Font24;
-        break;
-    default:
-        current_font = (FontTable *)&Font16; // Default to medium if invalid size
-        break;
-    }
+    uint8_t madctl = 0x08; // BGR, as in lcd_init
+    if (transform & LCD_SWAP_XY)
+        madctl |= 0x20;
+    if (transform & LCD_FLIP_X)
+        madctl |= 0x40;
+    if (transform & LCD_FLIP_Y)
+        madctl |= 0x80;
+    lcd_write_cmd(0x36);
+    lcd_write_data(madctl);
+    return true;
 }
 
 /******************************************************************************
@@ -885,38 +692,65 @@ parameter: none
 returns: none
 note: Call this after drawing operations to update the screen. This is the
       only function that actually writes to the display hardware, preventing
-      screen tearing and ensuring atomic frame updates.
+      screen tearing and ensuring atomic frame updates. Only the regions
+      touched since the last swap are sent.
 ******************************************************************************/
 void lcd_swap(void)
 {
-    // set the X coordinates
-    lcd_write_cmd(0x2A);
-    lcd_write_data(0x00);
-    lcd_write_data(0);
-    lcd_write_data((LCD_WIDTH - 1) >> 8);
-    lcd_write_data(LCD_WIDTH - 1);
-
-    // set the Y coordinates
-    lcd_write_cmd(0x2B);
-    lcd_write_data(0x00);
-    lcd_write_data(0);
-    lcd_write_data((LCD_HEIGHT - 1) >> 8);
-    lcd_write_data(LCD_HEIGHT - 1);
+    lcd_swap_async();
+    lcd_swap_wait();
+}
 
-    lcd_write_cmd(0X2C);
+/******************************************************************************
+function: Start sending the framebuffer to the display in the background
+parameter: none
+returns: none
+note: Only the regions touched since the last swap are sent. Returns once
+      the first two chunks are prepared; DMA and its IRQ handle the rest.
+      With LCD_DUAL_CORE core1 expands the chunks and this returns as soon
+      as the first one is on its way.
+      Anything drawn before lcd_swap_wait() returns may or may not make it
+      into this frame. Waits for a previous frame first.
+******************************************************************************/
+void lcd_swap_async(void)
+{
+    lcd_swap_wait();
+
+    swap_area_count = lcd_dirty_take(swap_areas);
+    if (swap_area_count == 0)
+        return; // Nothing was drawn, the panel already shows the framebuffer
+
+    swap_area_index = 0;
+    swap_busy = true;
+#if LCD_PROFILE
+    swap_profile_start = lcd_profile_now();
+    swap_profile_pixels = 0;
+#endif
+#if LCD_DUAL_CORE
+    multicore_fifo_push_blocking(swap_area_count); // core1 starts expanding
+#endif
+    lcd_swap_start_area();
+}
 
-    gpio_put(LCD_DC_PIN, 1);
+/******************************************************************************
+function: Wait for a background frame transfer to finish
+parameter: none
+returns: none
+******************************************************************************/
+void lcd_swap_wait(void)
+{
+    while (swap_busy)
+        tight_loop_contents();
+}
 
-    // Convert 8-bit palette indices to 16-bit RGB565 and send
-    for (uint32_t i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++)
-    {
-        uint8_t palette_index = framebuffer[i];
-        uint16_t color = palette[palette_index];
-        uint8_t high_byte = color >> 8;
-        uint8_t low_byte = color & 0xFF;
-        uint8_t data[2] = {high_byte, low_byte};
-        spi_write_blocking(LCD_SPI_PORT, data, 2);
-    }
+/******************************************************************************
+function: Check whether a background frame transfer is still running
+parameter: none
+returns: true while lcd_swap_async is streaming a frame
+******************************************************************************/
+bool lcd_swap_busy(void)
+{
+    return swap_busy;
 }
 
 /******************************************************************************
@@ -928,8 +762,8 @@ note: Low-level function used internally for LCD communication
 ******************************************************************************/
 void lcd_write_cmd(uint8_t cmd)
 {
-    gpio_put(LCD_DC_PIN, 0);
-    spi_write_blocking(LCD_SPI_PORT, &cmd, 1);
+    lcd_swap_wait();
+    lcd_send_cmd(cmd);
 }
 
 /******************************************************************************
@@ -941,8 +775,8 @@ note: Low-level function used internally for LCD communication
 ******************************************************************************/
 void lcd_write_data(uint8_t data)
 {
-    gpio_put(LCD_DC_PIN, 1);
-    spi_write_blocking(LCD_SPI_PORT, &data, 1);
+    lcd_swap_wait();
+    lcd_send_data(&data, 1);
 }
 
 /******************************************************************************
@@ -954,9 +788,7 @@ note: Low-level function used internally for LCD communication
 ******************************************************************************/
 void lcd_write_data_16bit(uint16_t data)
 {
-    gpio_put(LCD_DC_PIN, 1);
-    uint8_t high_byte = data >> 8;
-    uint8_t low_byte = data & 0xFF;
-    spi_write_blocking(LCD_SPI_PORT, &high_byte, 1);
-    spi_write_blocking(LCD_SPI_PORT, &low_byte, 1);
+    lcd_swap_wait();
+    uint8_t bytes[2] = {data >> 8, data & 0xFF};
+    lcd_send_data(bytes, sizeof(bytes));
 }
@@ -1,11 +1,24 @@
 #include "touch.h"
+#include "lcd.h"
 
 static bool initialized = false;
 
-// read gesture ID
+// read gesture ID, swipes turned with lcd_set_rotation like the points
 uint8_t touch_get_gesture(void)
 {
-    return touch_read(TOUCH_GESTURE_ID);
+    // Unit steps of the swipes in the panel frame, up, down, left, right
+    static const int8_t swipes[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    uint8_t gesture = touch_read(TOUCH_GESTURE_ID);
+    if (gesture < TOUCH_GESTURE_UP || gesture > TOUCH_GESTURE_RIGHT)
+        return gesture;
+
+    uint16_t x0 = LCD_WIDTH / 2, y0 = LCD_HEIGHT / 2;
+    uint16_t x1 = x0 + swipes[gesture - TOUCH_GESTURE_UP][0], y1 = y0 + swipes[gesture - TOUCH_GESTURE_UP][1];
+    lcd_panel_to_screen(&x0, &y0);
+    lcd_panel_to_screen(&x1, &y1);
+    if (y1 != y0)
+        return y1 < y0 ? TOUCH_GESTURE_UP : TOUCH_GESTURE_DOWN;
+    return x1 < x0 ? TOUCH_GESTURE_LEFT : TOUCH_GESTURE_RIGHT;
 }
 
 // get current touch point
@@ -19,9 +32,12 @@ TouchVector touch_get_point()
     y_point_l = touch_read(TOUCH_Y_POSITION_L);
 
     TouchVector tvector;
+    uint16_t x = ((x_point_h & 0x0f) << 8) + x_point_l;
+    uint16_t y = ((y_point_h & 0x0f) << 8) + y_point_l;
+    lcd_panel_to_screen(&x, &y); // follow lcd_set_rotation
 
-    tvector.x = ((x_point_h & 0x0f) << 8) + x_point_l;
-    tvector.y = ((y_point_h & 0x0f) << 8) + y_point_l;
+    tvector.x = x;
+    tvector.y = y;
 
     return tvector;
 }
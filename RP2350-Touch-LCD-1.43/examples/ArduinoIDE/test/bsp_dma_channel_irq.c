@@ -55,6 +55,7 @@ void bsp_dma_channel_irq1_init(void)
     // dma_channel_set_irq0_enabled(dma_chan, true);
 
     // Configure the processor to run dma_handler() when DMA IRQ 0 is asserted
-    irq_set_exclusive_handler(DMA_IRQ_1, dma_iqr1_handler);
+    // Shared with the fill engine of the drawing core, see lcd_memset.c
+    irq_add_shared_handler(DMA_IRQ_1, dma_iqr1_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
     irq_set_enabled(DMA_IRQ_1, true);
 }
@@ -39,7 +39,9 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#ifndef LCD_HOST_BUILD
 #include "pico/stdlib.h"
+#endif
 
 typedef enum
 {
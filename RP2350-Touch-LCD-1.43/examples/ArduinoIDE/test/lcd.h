@@ -19,6 +19,8 @@
 #define LCD_CS_PIN (15)   // Chip Select pin
 #define LCD_RST_PIN (16)  // Reset pin
 #define LCD_PWR_PIN (19)  // Power control pin
+// LCD_TE_PIN, the panel tearing effect output, is not defined until its GPIO
+// is confirmed on the schematic. Without it lcd_set_vsync returns false.
 
 // QSPI (4-bit SPI) with D0-D3 on pins 11-14
 #define LCD_D0_PIN (11)
@@ -28,6 +30,24 @@
 
 #define LCD_CHUNK_LINES 8
 #define LCD_X_OFFSET 6
+#define LCD_MAX_DIRTY_AREAS 8 // Regions tracked between swaps before they get merged
+#define LCD_POLYGON_MAX_POINTS 32 // Vertex limit of lcd_fill_polygon
+#define LCD_DIRTY_ALIGN 2     // Window start/size granularity required by the controller
+#define LCD_PIXEL_BYTE_SWAP 1 // RGB565 stored byte-swapped, the QSPI byte stream sends it high byte first
+#define LCD_TE_TIMEOUT_US 50000 // Start a vsync swap anyway if TE does not arrive within this time
+
+// Framebuffer format: 8 keeps an RGB332 buffer expanded through a palette at
+// swap time (low memory), 16 keeps native RGB565 that is sent as-is
+#ifndef LCD_COLOR_DEPTH
+#define LCD_COLOR_DEPTH 8
+#endif
+
+// Set to 1 to expand (or render) frames on core1 while the DMA IRQ on core0
+// sends them, see lcd_ring.h (lcd_init then claims core1, so the MicroPython
+// module keeps it off for _thread)
+#ifndef LCD_DUAL_CORE
+#define LCD_DUAL_CORE 0
+#endif
 
 #define LCD_DEFAULT_BRIGHTNESS 50 // Default brightness (0-100)
 #define LCD_DEFAULT_FONT_SIZE FONT_MEDIUM
@@ -101,6 +121,29 @@
 #define COLOR_PINK 0xFE19
 #endif
 
+typedef struct
+{
+    uint32_t frame_count; // Number of frames sent to the panel
+    uint32_t transfer_us; // Wall time of the last frame, from swap start to last byte
+    uint32_t cpu_us;      // CPU time the last frame spent converting pixels (waiting for core1 with LCD_DUAL_CORE)
+} LcdFrameTiming;
+
+typedef struct
+{
+    float fps;              // Frames presented per second, averaged over the last second
+    uint32_t frame_count;   // Number of frames presented since lcd_init
+    uint32_t dropped;       // Refresh periods that repeated the previous frame between two swaps
+    uint32_t latency_us;    // Last frame, from lcd_swap_async to the last byte on the panel
+    uint32_t max_latency_us; // Worst latency since lcd_init
+} LcdFrameStats;
+
+// Polygon vertex, signed so shapes can extend past the screen edges
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+} LcdPoint;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -111,19 +154,47 @@ extern "C"
     void lcd_reset(void);
     void lcd_set_backlight_level(uint8_t brightness); // brightness: 0 (off) to 100 (full)
     void lcd_swap(void);
+    void lcd_swap_async(void); // start a background frame transfer
+    void lcd_swap_wait(void);  // block until the background transfer is done
+    bool lcd_swap_busy(void);
+    void lcd_get_frame_timing(LcdFrameTiming *timing);
+    bool lcd_set_vsync(bool enable); // start transfers on the panel TE edge, false without LCD_TE_PIN
+    void lcd_get_frame_stats(LcdFrameStats *stats);
 
     // Framebuffer drawing functions
     void lcd_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
     void lcd_fill(uint16_t color);
+    void lcd_fill_wait(void); // lcd_fill/lcd_fill_rect run on DMA, wait for the last one
+    bool lcd_fill_busy(void);
     void lcd_blit(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *buffer);
 
+    void lcd_mark_dirty(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+    void lcd_invalidate(void); // resend the whole framebuffer on the next swap
+    void *lcd_get_framebuffer(void); // for direct writes, mark them dirty; NULL with LCD_TILED
+    uint16_t lcd_framebuffer_color(uint16_t color); // RGB565 to the value stored in the framebuffer
+
+    // Orientation: drawing coordinates follow the rotation (clockwise) and
+    // the optional left-right mirror; both return false when the panel
+    // cannot show it. Redraw everything after a change.
+    bool lcd_set_rotation(uint16_t degrees); // 0, 90, 180 or 270
+    bool lcd_set_mirror(bool mirror);
+    uint16_t lcd_get_rotation(void);
+    uint16_t lcd_get_width(void);  // drawing area, swapped with the height at 90 and 270
+    uint16_t lcd_get_height(void);
+    void lcd_panel_to_screen(uint16_t *x, uint16_t *y); // touch (panel frame) to drawing coordinates
+
     // Shape drawing functions
     void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
     void lcd_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
     void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
     void lcd_draw_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color);
     void lcd_fill_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color);
-    void lcd_fill_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t color);
+    void lcd_draw_ring(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t thickness, uint16_t color);
+    void lcd_draw_arc(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t thickness,
+                      int16_t start_angle, int16_t end_angle, uint16_t color); // degrees clockwise from 12 o'clock
+    void lcd_fill_triangle(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, uint16_t color);
+    void lcd_fill_polygon(const LcdPoint *points, uint8_t count, uint16_t color);
+    void lcd_draw_thick_line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t width, uint16_t color);
 
     // Text rendering functions
     void lcd_draw_char(uint16_t x, uint16_t y, char c, uint16_t color);
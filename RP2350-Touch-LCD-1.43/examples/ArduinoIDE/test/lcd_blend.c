@@ -0,0 +1,381 @@
+#include "lcd_blend.h"
+#include "lcd_internal.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef LCD_HOST_BUILD
+#define __not_in_flash_func(func_name) func_name
+#else
+#include "pico/platform.h"
+#endif
+
+// RGB565 spread over a word as -----GGGGGG-----RRRRR------BBBBB. Each field
+// has room for a channel times 32, so a multiply by a 0-32 alpha scales all
+// three at once and two scaled pixels can be added without carries.
+#define BLEND_MASK 0x07E0F81Fu
+#define BLEND_ROUND 0x02008010u // half of 32 in each field
+
+static inline uint32_t blend_spread(uint16_t color)
+{
+    return (color | ((uint32_t)color << 16)) & BLEND_MASK;
+}
+
+static inline uint32_t blend_alpha32(uint32_t alpha)
+{
+    return (alpha + 4) >> 3; // 0-255 -> 0-32
+}
+
+/******************************************************************************
+function: Mix a color into a framebuffer pixel
+parameter:
+    dst     : Framebuffer pixel
+    source  : blend_spread(color) * alpha + BLEND_ROUND
+    inverse : 32 - alpha
+returns: Blended framebuffer pixel
+******************************************************************************/
+static inline lcd_pixel_t blend_pixel(lcd_pixel_t dst, uint32_t source, uint32_t inverse)
+{
+    uint32_t mixed = ((blend_spread(lcd_pixel_to_color(dst)) * inverse + source) >> 5) & BLEND_MASK;
+    return lcd_color_to_pixel((uint16_t)(mixed | (mixed >> 16)));
+}
+
+/******************************************************************************
+function: Mix a color into one pixel, clipped to the screen (or the band)
+parameter:
+    x, y   : Pixel, may lie off-screen
+    spread : blend_spread of the color
+    alpha  : 0-32
+returns: none
+******************************************************************************/
+static inline void blend_point(int x, int y, uint32_t spread, uint32_t alpha)
+{
+    if (alpha == 0 || x < 0 || x >= LCD_VIEW_WIDTH || y < LCD_ROWS_BEGIN || y >= LCD_ROWS_END)
+        return;
+    lcd_pixel_t *p = LCD_PIXEL_AT(x, y);
+    *p = blend_pixel(*p, spread * alpha + BLEND_ROUND, 32 - alpha);
+}
+
+/******************************************************************************
+function: Mix a color into a rectangle
+parameter:
+    x      : Top-left X coordinate
+    y      : Top-left Y coordinate
+    width  : Width of rectangle
+    height : Height of rectangle
+    color  : RGB565 color value
+    alpha  : 0 leaves the rectangle as it is, 255 is a plain lcd_fill_rect
+returns: none
+note: With the RGB332 framebuffer a large rectangle blends the 256 possible
+      pixel values once and then only looks them up. With RGB565 the last
+      result is reused while the pixels repeat, as on flat backgrounds.
+******************************************************************************/
+void __not_in_flash_func(lcd_fill_rect_blend)(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                              uint16_t color, uint8_t alpha)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_FILL);
+    const uint32_t a = blend_alpha32(alpha);
+    if (a == 32)
+    {
+        lcd_fill_rect(x, y, width, height, color);
+        return;
+    }
+    if (a == 0 || x >= LCD_VIEW_WIDTH || y >= LCD_VIEW_HEIGHT || width == 0 || height == 0)
+        return;
+    if (x + width > LCD_VIEW_WIDTH)
+        width = LCD_VIEW_WIDTH - x;
+    if (y + height > LCD_VIEW_HEIGHT)
+        height = LCD_VIEW_HEIGHT - y;
+
+    lcd_dirty_add(x, y, x + width - 1, y + height - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_FILL_RECT_BLEND, NULL, 0, x, y, width, height, color, alpha))
+        return;
+
+    const uint32_t source = blend_spread(color) * a + BLEND_ROUND;
+    const uint32_t inverse = 32 - a;
+    int y0 = y > LCD_ROWS_BEGIN ? y : LCD_ROWS_BEGIN;
+    int y1 = y + height < LCD_ROWS_END ? y + height : LCD_ROWS_END;
+    if (y0 >= y1)
+        return;
+
+#if LCD_COLOR_DEPTH == 16
+    lcd_pixel_t last_in = *LCD_PIXEL_AT(x, y0);
+    lcd_pixel_t last_out = blend_pixel(last_in, source, inverse);
+    for (int row = y0; row < y1; row++)
+    {
+        lcd_pixel_t *p = LCD_PIXEL_AT(x, row);
+        for (int n = 0; n < width; n++)
+        {
+            if (p[n] != last_in)
+            {
+                last_in = p[n];
+                last_out = blend_pixel(last_in, source, inverse);
+            }
+            p[n] = last_out;
+        }
+    }
+#else
+    if ((y1 - y0) * width > 256)
+    {
+        lcd_pixel_t table[256];
+        for (int i = 0; i < 256; i++)
+            table[i] = blend_pixel(i, source, inverse);
+        for (int row = y0; row < y1; row++)
+        {
+            lcd_pixel_t *p = LCD_PIXEL_AT(x, row);
+            for (int n = 0; n < width; n++)
+                p[n] = table[p[n]];
+        }
+        return;
+    }
+    for (int row = y0; row < y1; row++)
+    {
+        lcd_pixel_t *p = LCD_PIXEL_AT(x, row);
+        for (int n = 0; n < width; n++)
+            p[n] = blend_pixel(p[n], source, inverse);
+    }
+#endif
+}
+
+/******************************************************************************
+function: Draw a color through a packed coverage mask
+parameter:
+    x, y        : Top-left corner, may lie off-screen
+    width       : Mask width in pixels
+    height      : Mask height in pixels
+    mask        : Coverage values, MSB first within a byte
+    stride_bits : Bits from the start of one row to the next
+    bpp         : Bits per value, 1, 2, 4 or 8; the largest value is opaque
+    color       : RGB565 color value
+returns: none
+note: Shared by lcd_blit_alpha and the font renderer. Transparent values
+      are skipped and opaque ones written without reading the framebuffer.
+      Does not mark anything dirty, the caller does.
+******************************************************************************/
+void __not_in_flash_func(lcd_blend_mask)(int x, int y, int width, int height, const uint8_t *mask,
+                                         uint32_t stride_bits, uint8_t bpp, uint16_t color)
+{
+    int col0 = x < 0 ? -x : 0;
+    int col1 = x + width > LCD_VIEW_WIDTH ? LCD_VIEW_WIDTH - x : width;
+    int row0 = y < LCD_ROWS_BEGIN ? LCD_ROWS_BEGIN - y : 0;
+    int row1 = y + height > LCD_ROWS_END ? LCD_ROWS_END - y : height;
+    if (col0 >= col1 || row0 >= row1)
+        return;
+
+    const uint32_t opaque = (1u << bpp) - 1;
+    uint8_t alpha32[16]; // value -> 0-32 for up to 4 bits per value
+    if (bpp < 8)
+    {
+        for (uint32_t level = 0; level <= opaque; level++)
+            alpha32[level] = (level * 32 + opaque / 2) / opaque;
+    }
+    const uint32_t spread = blend_spread(color);
+    const lcd_pixel_t pixel = lcd_color_to_pixel(color);
+
+    for (int row = row0; row < row1; row++)
+    {
+        uint32_t bit = row * stride_bits + col0 * bpp;
+        lcd_pixel_t *dst = LCD_PIXEL_AT(x, y + row);
+        for (int col = col0; col < col1; col++, bit += bpp)
+        {
+            uint32_t level = (mask[bit >> 3] >> (8 - bpp - (bit & 7))) & opaque;
+            if (level == 0)
+                continue;
+            if (level == opaque)
+            {
+                dst[col] = pixel;
+                continue;
+            }
+            uint32_t a = bpp == 8 ? blend_alpha32(level) : alpha32[level];
+            dst[col] = blend_pixel(dst[col], spread * a + BLEND_ROUND, 32 - a);
+        }
+    }
+}
+
+/******************************************************************************
+function: Draw a color through an alpha mask
+parameter:
+    x      : Top-left X coordinate, may be negative
+    y      : Top-left Y coordinate, may be negative
+    width  : Mask width in pixels
+    height : Mask height in pixels
+    alpha  : Mask, LCD_ALPHA_A8 or LCD_ALPHA_A4 (see lcd_blend.h)
+    format : LCD_ALPHA_A8 or LCD_ALPHA_A4
+    color  : RGB565 color value
+returns: none
+******************************************************************************/
+void lcd_blit_alpha(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *alpha, uint8_t format,
+                    uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_BLIT);
+    if (alpha == NULL || format > LCD_ALPHA_A4)
+        return;
+    lcd_dirty_add(x, y, x + width - 1, y + height - 1);
+    if (LCD_TILE_RECORD(LCD_TILE_BLIT_ALPHA, NULL, 0, x, y, width, height, (intptr_t)alpha, format, color))
+        return;
+
+    if (format == LCD_ALPHA_A4)
+        lcd_blend_mask(x, y, width, height, alpha, (width + 1) / 2 * 8, 4, color);
+    else
+        lcd_blend_mask(x, y, width, height, alpha, width * 8, 8, color);
+}
+
+/******************************************************************************
+function: Draw an anti-aliased line with Xiaolin Wu's algorithm
+parameter:
+    x1, y1 : Start point, may lie off-screen
+    x2, y2 : End point, may lie off-screen
+    color  : RGB565 color value
+returns: none
+note: One pixel per step along the major axis is split between the two
+      pixels across it in proportion to the distance to the ideal line, in
+      16.16 fixed point. The major axis is clipped before stepping.
+******************************************************************************/
+void __not_in_flash_func(lcd_draw_line_aa)(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    lcd_dirty_add(x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2, (x1 > x2 ? x1 : x2) + 1, (y1 > y2 ? y1 : y2) + 1);
+    if (LCD_TILE_RECORD(LCD_TILE_LINE_AA, NULL, 0, x1, y1, x2, y2, color))
+        return;
+
+    // Step along u, the major axis, and spread across v
+    const bool steep = abs(y2 - y1) > abs(x2 - x1);
+    int u1 = steep ? y1 : x1, v1 = steep ? x1 : y1;
+    int u2 = steep ? y2 : x2, v2 = steep ? x2 : y2;
+    if (u1 > u2)
+    {
+        int t = u1;
+        u1 = u2;
+        u2 = t;
+        t = v1;
+        v1 = v2;
+        v2 = t;
+    }
+    const int32_t gradient = u2 > u1 ? (int32_t)(((int64_t)(v2 - v1) << 16) / (u2 - u1)) : 0;
+
+    const int u_min = steep ? LCD_ROWS_BEGIN : 0;
+    const int u_max = steep ? LCD_ROWS_END - 1 : LCD_VIEW_WIDTH - 1;
+    int u0 = u1 > u_min ? u1 : u_min;
+    int u_end = u2 < u_max ? u2 : u_max;
+    int64_t v = ((int64_t)v1 << 16) + (int64_t)gradient * (u0 - u1);
+    const uint32_t spread = blend_spread(color);
+
+    for (int u = u0; u <= u_end; u++, v += gradient)
+    {
+        int vi = (int)(v >> 16);
+        uint32_t below = blend_alpha32((uint32_t)(v >> 8) & 0xFF); // share of the pixel at vi + 1
+        if (steep)
+        {
+            blend_point(vi, u, spread, 32 - below);
+            blend_point(vi + 1, u, spread, below);
+        }
+        else
+        {
+            blend_point(u, vi, spread, 32 - below);
+            blend_point(u, vi + 1, spread, below);
+        }
+    }
+}
+
+/******************************************************************************
+function: Draw an anti-aliased circle outline
+parameter:
+    center_x : Center X coordinate
+    center_y : Center Y coordinate
+    radius   : Radius of circle
+    color    : RGB565 color value
+returns: none
+note: A pixel at distance d from the center is covered by 1 - |d - radius|.
+      Each row only visits the columns within one pixel of the circle.
+******************************************************************************/
+void __not_in_flash_func(lcd_draw_circle_aa)(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    const int cx = center_x, cy = center_y, r = radius;
+    lcd_dirty_add(cx - r - 1, cy - r - 1, cx + r + 1, cy + r + 1);
+    if (LCD_TILE_RECORD(LCD_TILE_CIRCLE_AA, NULL, 0, center_x, center_y, radius, color))
+        return;
+
+    const uint32_t spread = blend_spread(color);
+    const float outer = (float)(r + 1) * (r + 1);
+    const float inner = r > 1 ? (float)(r - 1) * (r - 1) : -1.0f;
+    int dy0 = -r - 1, dy1 = r + 1;
+    if (cy + dy0 < LCD_ROWS_BEGIN)
+        dy0 = LCD_ROWS_BEGIN - cy;
+    if (cy + dy1 >= LCD_ROWS_END)
+        dy1 = LCD_ROWS_END - 1 - cy;
+
+    for (int dy = dy0; dy <= dy1; dy++)
+    {
+        const float yy = (float)dy * dy;
+        int dx_last = (int)sqrtf(outer - yy);
+        int dx_first = inner > yy ? (int)ceilf(sqrtf(inner - yy)) : 0;
+        for (int dx = dx_first; dx <= dx_last; dx++)
+        {
+            float coverage = 1.0f - fabsf(sqrtf(dx * dx + yy) - r);
+            if (coverage <= 0.0f)
+                continue;
+            uint32_t a = (uint32_t)(coverage * 32.0f + 0.5f);
+            blend_point(cx + dx, cy + dy, spread, a);
+            if (dx != 0)
+                blend_point(cx - dx, cy + dy, spread, a);
+        }
+    }
+}
+
+/******************************************************************************
+function: Draw a filled circle with an anti-aliased edge
+parameter:
+    center_x : Center X coordinate
+    center_y : Center Y coordinate
+    radius   : Radius of circle
+    color    : RGB565 color value
+returns: none
+note: The inside is written as plain spans, only the pixels on the edge
+      (coverage radius + 0.5 - d between 0 and 1) are blended.
+******************************************************************************/
+void __not_in_flash_func(lcd_fill_circle_aa)(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_SHAPE);
+    const int cx = center_x, cy = center_y, r = radius;
+    lcd_dirty_add(cx - r - 1, cy - r - 1, cx + r + 1, cy + r + 1);
+    if (LCD_TILE_RECORD(LCD_TILE_FILL_CIRCLE_AA, NULL, 0, center_x, center_y, radius, color))
+        return;
+
+    const uint32_t spread = blend_spread(color);
+    const lcd_pixel_t pixel = lcd_color_to_pixel(color);
+    const float edge = r + 0.5f;
+    const float solid = r - 0.5f;
+    int dy0 = -r - 1, dy1 = r + 1;
+    if (cy + dy0 < LCD_ROWS_BEGIN)
+        dy0 = LCD_ROWS_BEGIN - cy;
+    if (cy + dy1 >= LCD_ROWS_END)
+        dy1 = LCD_ROWS_END - 1 - cy;
+
+    for (int dy = dy0; dy <= dy1; dy++)
+    {
+        const float yy = (float)dy * dy;
+        if (yy >= edge * edge)
+            continue;
+        int dx_last = (int)sqrtf(edge * edge - yy);
+        int dx_solid = solid > 0.0f && solid * solid > yy ? (int)sqrtf(solid * solid - yy) : -1;
+
+        // Inside: every pixel fully covered
+        int x0 = cx - dx_solid < 0 ? 0 : cx - dx_solid;
+        int x1 = cx + dx_solid >= LCD_VIEW_WIDTH ? LCD_VIEW_WIDTH - 1 : cx + dx_solid;
+        lcd_pixel_t *row = LCD_PIXEL_AT(0, cy + dy);
+        for (int x = x0; x <= x1; x++)
+            row[x] = pixel;
+
+        // Edge, mirrored on both sides
+        for (int dx = dx_solid + 1; dx <= dx_last; dx++)
+        {
+            float coverage = edge - sqrtf(dx * dx + yy);
+            if (coverage <= 0.0f)
+                continue;
+            uint32_t a = coverage >= 1.0f ? 32 : (uint32_t)(coverage * 32.0f + 0.5f);
+            blend_point(cx + dx, cy + dy, spread, a);
+            if (dx != 0)
+                blend_point(cx - dx, cy + dy, spread, a);
+        }
+    }
+}
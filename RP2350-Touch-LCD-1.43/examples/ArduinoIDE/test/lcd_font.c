@@ -0,0 +1,285 @@
+#include "lcd_font.h"
+#include "lcd_internal.h"
+#include <string.h>
+
+#define FONT_MAGIC_0 'L'
+#define FONT_MAGIC_1 'F'
+#define FONT_RANGE_SIZE 8
+#define FONT_GLYPH_SIZE 8
+
+// Tables of a font container, located once per call
+typedef struct
+{
+    const uint8_t *ranges, *glyphs, *kerning, *bitmaps;
+    uint16_t range_count, glyph_count, kerning_count;
+    uint16_t missing;
+    uint8_t bpp, height;
+    uint8_t pair_size; // bytes per kerning entry
+} font_view_t;
+
+// Union of the glyph bitmaps of a text, and where its pen ended up
+typedef struct
+{
+    int x0, y0, x1, y1; // inclusive, x1 < x0 when nothing is drawn
+    int pen_x;          // after the last character
+    int widest;         // advance width of the longest line
+} font_layout_t;
+
+static inline uint16_t font_u16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t font_u32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/******************************************************************************
+function: Check a font container and locate its tables
+parameter:
+    view : Set to the tables
+    font : Font container
+returns: false when the header is not valid
+******************************************************************************/
+static bool font_open(font_view_t *view, const uint8_t *font)
+{
+    if (font == NULL || font[0] != FONT_MAGIC_0 || font[1] != FONT_MAGIC_1 ||
+        (font[2] != 1 && font[2] != 2 && font[2] != 4))
+        return false;
+    view->bpp = font[2];
+    view->height = font[4];
+    view->missing = font_u16(font + 6);
+    view->range_count = font_u16(font + 8);
+    view->glyph_count = font_u16(font + 10);
+    view->kerning_count = font_u16(font + 12);
+    view->pair_size = (font[3] & LCD_FONT_BYTE_KERNING) ? 3 : 5;
+    view->ranges = font + LCD_FONT_HEADER_SIZE;
+    view->glyphs = view->ranges + view->range_count * FONT_RANGE_SIZE;
+    view->kerning = view->glyphs + view->glyph_count * FONT_GLYPH_SIZE;
+    view->bitmaps = view->kerning + view->kerning_count * view->pair_size;
+    return true;
+}
+
+/******************************************************************************
+function: Find the glyph of a code point
+parameter:
+    view : Font tables
+    code : Unicode code point
+returns: Glyph number, the missing glyph when the font has none, or -1
+******************************************************************************/
+static int font_glyph(const font_view_t *view, uint32_t code)
+{
+    int lo = 0, hi = view->range_count;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        const uint8_t *range = view->ranges + mid * FONT_RANGE_SIZE;
+        uint32_t first = font_u32(range);
+        if (code < first)
+            hi = mid;
+        else if (code - first >= font_u16(range + 4))
+            lo = mid + 1;
+        else
+            return font_u16(range + 6) + (code - first);
+    }
+    return view->missing < view->glyph_count ? view->missing : -1;
+}
+
+/******************************************************************************
+function: Look up the kerning between two glyphs
+parameter:
+    view  : Font tables
+    left  : Previous glyph, -1 at the start of a line
+    right : Glyph about to be drawn
+returns: Pixels to add to the pen position
+******************************************************************************/
+static int font_kerning(const font_view_t *view, int left, int right)
+{
+    if (left < 0 || view->kerning_count == 0)
+        return 0;
+    const uint32_t key = ((uint32_t)left << 16) | right;
+    int lo = 0, hi = view->kerning_count;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        const uint8_t *pair = view->kerning + mid * view->pair_size;
+        uint32_t pair_key = view->pair_size == 3 ? ((uint32_t)pair[0] << 16) | pair[1]
+                                                 : ((uint32_t)font_u16(pair) << 16) | font_u16(pair + 2);
+        if (key < pair_key)
+            hi = mid;
+        else if (key > pair_key)
+            lo = mid + 1;
+        else
+            return (int8_t)pair[view->pair_size - 1];
+    }
+    return 0;
+}
+
+/******************************************************************************
+function: Decode the next character of a UTF-8 string
+parameter:
+    text : Read position, advanced past the character
+returns: Code point, U+FFFD for a malformed sequence
+note: A sequence cut short stops before the offending byte, so the
+      terminating NUL is never skipped.
+******************************************************************************/
+static uint32_t utf8_next(const char **text)
+{
+    const uint8_t *p = (const uint8_t *)*text;
+    uint32_t code = *p++;
+    int extra = 0;
+    if (code >= 0xF8 || (code >= 0x80 && code < 0xC0))
+        code = 0xFFFD;
+    else if (code >= 0xF0)
+    {
+        extra = 3;
+        code &= 0x07;
+    }
+    else if (code >= 0xE0)
+    {
+        extra = 2;
+        code &= 0x0F;
+    }
+    else if (code >= 0xC0)
+    {
+        extra = 1;
+        code &= 0x1F;
+    }
+
+    for (; extra > 0; extra--, p++)
+    {
+        if ((*p & 0xC0) != 0x80)
+        {
+            code = 0xFFFD;
+            break;
+        }
+        code = (code << 6) | (*p & 0x3F);
+    }
+    *text = (const char *)p;
+    return code;
+}
+
+/******************************************************************************
+function: Lay out a text, and draw it
+parameter:
+    view   : Font tables
+    x, y   : Top-left corner of the first line
+    text   : UTF-8 string
+    draw   : false to only measure
+    color  : RGB565 color value
+    layout : Set to the area covered and the pen position
+returns: none
+******************************************************************************/
+static void font_layout(const font_view_t *view, int x, int y, const char *text, bool draw, uint16_t color,
+                        font_layout_t *layout)
+{
+    int pen_x = x, pen_y = y;
+    int previous = -1;
+    layout->x0 = layout->y0 = 0x7FFFFFFF;
+    layout->x1 = layout->y1 = -0x7FFFFFFF;
+    layout->widest = 0;
+
+    while (*text)
+    {
+        uint32_t code = utf8_next(&text);
+        if (code == '\n')
+        {
+            if (pen_x - x > layout->widest)
+                layout->widest = pen_x - x;
+            pen_x = x;
+            pen_y += view->height;
+            previous = -1;
+            continue;
+        }
+        int glyph = font_glyph(view, code);
+        if (glyph < 0)
+            continue;
+
+        pen_x += font_kerning(view, previous, glyph);
+        previous = glyph;
+        const uint8_t *entry = view->glyphs + glyph * FONT_GLYPH_SIZE;
+        const int width = entry[3], height = entry[4];
+        const int gx = pen_x + (int8_t)entry[5], gy = pen_y + (int8_t)entry[6];
+        pen_x += entry[7];
+        if (width == 0 || height == 0)
+            continue;
+
+        if (gx < layout->x0)
+            layout->x0 = gx;
+        if (gy < layout->y0)
+            layout->y0 = gy;
+        if (gx + width - 1 > layout->x1)
+            layout->x1 = gx + width - 1;
+        if (gy + height - 1 > layout->y1)
+            layout->y1 = gy + height - 1;
+        if (draw)
+        {
+            const uint32_t offset = entry[0] | (entry[1] << 8) | (entry[2] << 16);
+            lcd_blend_mask(gx, gy, width, height, view->bitmaps + offset, width * view->bpp, view->bpp, color);
+        }
+    }
+    if (pen_x - x > layout->widest)
+        layout->widest = pen_x - x;
+    layout->pen_x = pen_x;
+}
+
+/******************************************************************************
+function: Get the line height of a font
+parameter:
+    font : Font container
+returns: Height in pixels, 0 when the font is not valid
+******************************************************************************/
+uint8_t lcd_font_height(const uint8_t *font)
+{
+    font_view_t view;
+    return font_open(&view, font) ? view.height : 0;
+}
+
+/******************************************************************************
+function: Measure a text
+parameter:
+    font : Font container
+    text : UTF-8 string, '\n' starts a new line
+returns: Advance width of the widest line in pixels
+******************************************************************************/
+uint16_t lcd_text_width(const uint8_t *font, const char *text)
+{
+    font_view_t view;
+    font_layout_t layout;
+    if (text == NULL || !font_open(&view, font))
+        return 0;
+    font_layout(&view, 0, 0, text, false, 0, &layout);
+    return layout.widest;
+}
+
+/******************************************************************************
+function: Draw a text with a proportional font
+parameter:
+    x     : X coordinate of the first line's pen start, may be negative
+    y     : Y coordinate of the first line's top, may be negative
+    text  : UTF-8 string, '\n' starts a new line
+    font  : Font container
+    color : RGB565 color value
+returns: Pen X coordinate after the last character
+note: The text is measured first so the exact area can be marked dirty
+      (and recorded in tiled mode), then drawn glyph by glyph.
+******************************************************************************/
+int16_t lcd_draw_text_font(int16_t x, int16_t y, const char *text, const uint8_t *font, uint16_t color)
+{
+    LCD_PROFILE_DRAW(LCD_PROFILE_TEXT);
+    font_view_t view;
+    font_layout_t layout;
+    if (text == NULL || !font_open(&view, font))
+        return x;
+
+    font_layout(&view, x, y, text, false, color, &layout);
+    if (layout.x1 < layout.x0)
+        return layout.pen_x; // only spaces and line breaks
+    lcd_dirty_add(layout.x0, layout.y0, layout.x1, layout.y1);
+    if (LCD_TILE_RECORD(LCD_TILE_TEXT_FONT, text, strlen(text) + 1, x, y, color, (intptr_t)font))
+        return layout.pen_x;
+
+    font_layout(&view, x, y, text, true, color, &layout);
+    return layout.pen_x;
+}
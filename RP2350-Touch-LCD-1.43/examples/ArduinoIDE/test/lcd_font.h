@@ -0,0 +1,64 @@
+// Proportional, anti-aliased fonts with kerning and UTF-8 text.
+//
+// Built from TrueType or BDF files with
+// RP2350-Touch-LCD-3.49/tools/host/font_compile.py. The fixed-width
+// FontTable fonts (lcd_set_font, lcd_draw_text) are unchanged.
+//
+// Container, all values little-endian:
+//   0  'L' 'F'   magic
+//   2  bpp       1, 2 or 4 bits of coverage per pixel
+//   3  flags     LCD_FONT_BYTE_KERNING: kerning entries are 3 bytes
+//   4  height    uint8, line height in pixels
+//   5  ascent    uint8, baseline, in pixels below the top of a line
+//   6  missing   uint16, glyph drawn for characters not in the font, 0xFFFF
+//                to skip them
+//   8  ranges    uint16, entries in the range table
+//   10 glyphs    uint16, entries in the glyph table
+//   12 kerning   uint16, entries in the kerning table
+//   14 0         reserved
+//   16 range table, sorted by code point, 8 bytes per entry:
+//        first   uint32, first code point of a run of consecutive ones
+//        count   uint16, code points in the run
+//        glyph   uint16, glyph of the first one, the rest follow in order
+//   glyph table, 8 bytes per entry:
+//        offset  uint24, start of the bitmap, from the end of the tables
+//        width   uint8, bitmap size in pixels
+//        height  uint8
+//        left    int8, bitmap position relative to the pen
+//        top     int8, bitmap position relative to the top of the line
+//        advance uint8, pen movement after the glyph
+//   kerning table, sorted by left then right glyph, 5 bytes per entry, or 3
+//        with LCD_FONT_BYTE_KERNING where the glyph numbers are uint8:
+//        left    uint16, glyph
+//        right   uint16, glyph drawn after it
+//        adjust  int8, added to the advance of the left glyph
+//   bitmaps, each starting on a byte, rows following each other without
+//        padding, pixels MSB first, 0 transparent to (1 << bpp) - 1 opaque
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lcd.h"
+
+#define LCD_FONT_HEADER_SIZE 16
+#define LCD_FONT_BYTE_KERNING 0x01 // Header flag, set by font_compile.py for up to 256 glyphs
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Line height in pixels, 0 when the font is not valid
+    uint8_t lcd_font_height(const uint8_t *font);
+
+    // Width in pixels of the widest line of UTF-8 text, kerning included
+    uint16_t lcd_text_width(const uint8_t *font, const char *text);
+
+    // Draw UTF-8 text with the top-left corner of its first line at (x, y),
+    // '\n' starting a new line below. Coverage is blended into the
+    // framebuffer (see lcd_blend.h). The font is referenced in tiled mode.
+    // Returns the pen position after the last character.
+    int16_t lcd_draw_text_font(int16_t x, int16_t y, const char *text, const uint8_t *font, uint16_t color);
+
+#ifdef __cplusplus
+}
+#endif
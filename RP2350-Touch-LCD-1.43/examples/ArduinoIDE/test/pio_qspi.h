@@ -26,6 +26,8 @@ void pio_qspi_4bit_write_data_blocking(uint8_t *buf, size_t len);
 void pio_qspi_1bit_write_data(uint8_t *buf, size_t len);
 void pio_qspi_4bit_write_data(uint8_t *buf, size_t len);
 
+void pio_qspi_wait_idle(void);
+
 int pio_qspi_get_dma_channel(void);
 uint pio_qspi_get_sm(void);
 
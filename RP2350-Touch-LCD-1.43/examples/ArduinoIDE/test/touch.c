@@ -1,4 +1,5 @@
 #include "touch.h"
+#include "lcd.h"
 #include <string.h>
 
 static bool initialized = false;
@@ -35,11 +36,11 @@ static void touch_read_bytes(uint8_t reg, uint8_t *data, size_t len)
     i2c_read_blocking(SENSOR_I2C_PORT, TOUCH_ADDR, data, len, false);
 }
 
-// Internal function to read touch data from FT6146
-static void touch_read_data(void)
+// Read touch data from FT6146, force reads it without a touch interrupt
+void touch_read_data(bool force)
 {
     // Check interrupt flag - only read if touch interrupt occurred
-    if (!touch_irq_flag)
+    if (!touch_irq_flag && !force)
     {
         touch_state.num_points = 0;
         return;
@@ -80,12 +81,13 @@ TouchVector touch_get_point()
     }
 
     // Read latest touch data
-    touch_read_data();
+    touch_read_data(TOUCH_POLL);
 
     if (touch_state.num_points > 0)
     {
         tvector.x = touch_state.x;
         tvector.y = touch_state.y;
+        lcd_panel_to_screen(&tvector.x, &tvector.y); // follow lcd_set_rotation
     }
     else
     {
@@ -19,6 +19,13 @@
 #define TOUCH_RST_PIN (17)
 #define TOUCH_BAUDRATE (400000)
 
+// With TOUCH_POLL, touch_get_point reads the chip on every call instead of
+// after a touch interrupt. The MicroPython module sets it, as the port keeps
+// the GPIO interrupt to itself.
+#ifndef TOUCH_POLL
+#define TOUCH_POLL 0
+#endif
+
 // FT6146 Register definitions
 #define TOUCH_REG_NUM_TOUCHES 0x02
 
@@ -39,6 +46,7 @@ extern "C"
 	void touch_init(void);
 
 	uint8_t touch_read(uint8_t reg);
+	void touch_read_data(bool force);
 	void touch_reset();
 	void touch_reset_state();
 	void touch_set_callback(gpio_irq_callback_t callback);
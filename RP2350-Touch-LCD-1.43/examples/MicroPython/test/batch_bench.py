@@ -0,0 +1,74 @@
+def main():
+    """Count primitives per second drawn one call at a time and with draw_batch"""
+
+    from time import ticks_us, ticks_diff
+    from waveshare_lcd import (
+        fill_rect,
+        draw_line,
+        fill_circle,
+        COLOR_BLACK,
+        LCD_WIDTH,
+        LCD_HEIGHT,
+    )
+    from lcd import LCD
+    from draw_list import DrawList
+
+    lcd = LCD()
+    frames = 10
+
+    # Small shapes, so the time goes into the calls rather than the pixels
+    shapes = []
+    seed = 1
+    for i in range(300):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        x = seed % (LCD_WIDTH - 8)
+        y = (seed >> 16) % (LCD_HEIGHT - 8)
+        shapes.append((i % 3, x, y, seed & 0xFFFF))
+    count = len(shapes) * frames
+
+    def report(name, start):
+        us = ticks_diff(ticks_us(), start)
+        print(f"{name}: {count * 1000000 // us} primitives/s ({us // frames} us/frame)")
+
+    # The module functions are called directly, as the LCD methods add an
+    # import to every call
+    lcd.fill_screen(COLOR_BLACK)
+    start = ticks_us()
+    for _ in range(frames):
+        for kind, x, y, color in shapes:
+            if kind == 0:
+                fill_rect(x, y, 8, 8, color)
+            elif kind == 1:
+                draw_line(x, y, x + 7, y + 7, color)
+            else:
+                fill_circle(x + 4, y + 4, 3, color)
+    report("per call", start)
+
+    # Recording the list again every frame, as for a screen that changes
+    lcd.fill_screen(COLOR_BLACK)
+    commands = DrawList()
+    start = ticks_us()
+    for _ in range(frames):
+        commands.clear()
+        for kind, x, y, color in shapes:
+            if kind == 0:
+                commands.fill_rect(x, y, 8, 8, color)
+            elif kind == 1:
+                commands.draw_line(x, y, x + 7, y + 7, color)
+            else:
+                commands.fill_circle(x + 4, y + 4, 3, color)
+        commands.draw()
+    report("record + draw_batch", start)
+
+    # Drawing the recorded list again, as for a screen that stays the same
+    lcd.fill_screen(COLOR_BLACK)
+    start = ticks_us()
+    for _ in range(frames):
+        commands.draw()
+    report("draw_batch", start)
+
+    lcd.swap()
+
+
+if __name__ == "__main__":
+    main()
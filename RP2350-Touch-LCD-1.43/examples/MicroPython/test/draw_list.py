@@ -0,0 +1,101 @@
+from struct import pack_into
+from waveshare_lcd import (
+    draw_batch,
+    BATCH_FILL,
+    BATCH_PIXEL,
+    BATCH_LINE,
+    BATCH_RECT,
+    BATCH_FILL_RECT,
+    BATCH_CIRCLE,
+    BATCH_FILL_CIRCLE,
+    BATCH_FILL_TRIANGLE,
+    BATCH_TEXT,
+)
+
+
+class DrawList:
+    """Packed list of drawing commands, drawn with one call to draw_batch
+
+    Record the primitives of a frame with the same arguments as the LCD
+    methods, then draw them all at once. A list can be kept and drawn again
+    every frame, e.g. for the static part of a screen. Arguments are stored
+    as 16-bit words, so coordinates and colors must be 0 to 65535, apart
+    from the fill_triangle vertices which are -32768 to 32767.
+    """
+
+    def __init__(self, size: int = 1024):
+        self.buffer = bytearray(size)
+        self.length = 0
+
+    def _reserve(self, size: int) -> int:
+        """Return the offset of size new bytes at the end, growing the buffer"""
+        offset = self.length
+        if offset + size > len(self.buffer):
+            grown = bytearray(max(2 * len(self.buffer), offset + size))
+            grown[:offset] = memoryview(self.buffer)[:offset]
+            self.buffer = grown
+        self.length = offset + size
+        return offset
+
+    def clear(self):
+        """Forget all commands, keeping the buffer for the next frame"""
+        self.length = 0
+
+    def draw(self) -> int:
+        """Draw all commands into the framebuffer, returns how many were drawn"""
+        return draw_batch(memoryview(self.buffer)[: self.length])
+
+    def fill_screen(self, color: int):
+        offset = self._reserve(4)
+        pack_into("<2H", self.buffer, offset, BATCH_FILL, color)
+
+    def draw_pixel(self, x: int, y: int, color: int):
+        offset = self._reserve(8)
+        pack_into("<4H", self.buffer, offset, BATCH_PIXEL, x, y, color)
+
+    def draw_line(self, x1: int, y1: int, x2: int, y2: int, color: int):
+        offset = self._reserve(12)
+        pack_into("<6H", self.buffer, offset, BATCH_LINE, x1, y1, x2, y2, color)
+
+    def draw_rect(self, x: int, y: int, w: int, h: int, color: int):
+        offset = self._reserve(12)
+        pack_into("<6H", self.buffer, offset, BATCH_RECT, x, y, w, h, color)
+
+    def fill_rect(self, x: int, y: int, w: int, h: int, color: int):
+        offset = self._reserve(12)
+        pack_into("<6H", self.buffer, offset, BATCH_FILL_RECT, x, y, w, h, color)
+
+    def draw_circle(self, x: int, y: int, r: int, color: int):
+        offset = self._reserve(10)
+        pack_into("<5H", self.buffer, offset, BATCH_CIRCLE, x, y, r, color)
+
+    def fill_circle(self, x: int, y: int, r: int, color: int):
+        offset = self._reserve(10)
+        pack_into("<5H", self.buffer, offset, BATCH_FILL_CIRCLE, x, y, r, color)
+
+    def fill_triangle(
+        self, x1: int, y1: int, x2: int, y2: int, x3: int, y3: int, color: int
+    ):
+        offset = self._reserve(16)
+        pack_into(
+            "<H6hH",
+            self.buffer,
+            offset,
+            BATCH_FILL_TRIANGLE,
+            x1,
+            y1,
+            x2,
+            y2,
+            x3,
+            y3,
+            color,
+        )
+
+    def draw_text(self, x: int, y: int, text: str, color: int):
+        """Record text of up to 255 bytes once encoded as UTF-8"""
+        data = text.encode()
+        offset = self._reserve(10 + len(data) + (len(data) & 1))
+        pack_into("<5H", self.buffer, offset, BATCH_TEXT, x, y, color, len(data))
+        self.buffer[offset + 10 : offset + 10 + len(data)] = data
+        if len(data) & 1:
+            self.buffer[offset + 10 + len(data)] = 0
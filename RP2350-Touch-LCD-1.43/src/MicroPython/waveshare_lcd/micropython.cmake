@@ -1,32 +1,42 @@
+# The Python bindings on top of this board's SDK lcd driver (src/SDK/lcd) and
+# the drawing core shared by all boards (common/lcd), so the module runs the
+# same driver code as the SDK examples
+set(LCD_BOARD_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/lcd)
+include(${CMAKE_CURRENT_LIST_DIR}/../../../../common/lcd/lcd_core.cmake)
+
+# Panel and bus driver, the sources of the SDK lcd library
+file(GLOB LCD_BOARD_SOURCES ${LCD_BOARD_DIR}/*.c)
+
 # Create a C module for Waveshare LCD extension
 add_library(usermod_waveshare_lcd INTERFACE)
 
 # Generate PIO header from .pio file
-pico_generate_pio_header(usermod_waveshare_lcd ${CMAKE_CURRENT_LIST_DIR}/pio_qspi.pio)
+pico_generate_pio_header(usermod_waveshare_lcd ${LCD_BOARD_DIR}/pio_qspi.pio)
 
 target_sources(usermod_waveshare_lcd INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd.c
-    ${CMAKE_CURRENT_LIST_DIR}/bsp_dma_channel_irq.c
-    ${CMAKE_CURRENT_LIST_DIR}/lcd.c
-    ${CMAKE_CURRENT_LIST_DIR}/font8.c
-    ${CMAKE_CURRENT_LIST_DIR}/font12.c
-    ${CMAKE_CURRENT_LIST_DIR}/font16.c
-    ${CMAKE_CURRENT_LIST_DIR}/font20.c
-    ${CMAKE_CURRENT_LIST_DIR}/font24.c
-    ${CMAKE_CURRENT_LIST_DIR}/pio_qspi.c
+    ${LCD_BOARD_SOURCES}
 )
 
 target_include_directories(usermod_waveshare_lcd INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${LCD_BOARD_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_lcd INTERFACE
     MODULE_WAVESHARE_LCD_ENABLED=1
 )
 
+# Frame-rate and per-primitive counters, see lcd_profile.h. Pass
+# CMAKE_ARGS=-DLCD_PROFILE=ON to make to turn them on.
+if(LCD_PROFILE)
+    target_compile_definitions(usermod_waveshare_lcd INTERFACE LCD_PROFILE=1)
+endif()
+
 target_link_libraries(usermod INTERFACE usermod_waveshare_lcd)
+target_link_libraries(usermod_waveshare_lcd INTERFACE usermod_lcd_core)
 
-# Link required Pico SDK libraries
+# Link required Pico SDK libraries, as the SDK lcd library does
 target_link_libraries(usermod_waveshare_lcd INTERFACE
     pico_stdlib
     pico_printf
@@ -1,13 +1,40 @@
 WAVESHARE_LCD_MOD_DIR := $(USERMOD_DIR)
+LCD_BOARD_DIR := $(USERMOD_DIR)/../../SDK/lcd
+LCD_CORE_DIR := $(USERMOD_DIR)/../../../../common/lcd
 
 # Add all C files to SRC_USERMOD.
 SRC_USERMOD += $(WAVESHARE_LCD_MOD_DIR)/waveshare_lcd.c
-SRC_USERMOD += $(WAVESHARE_LCD_MOD_DIR)/lcd.c
-SRC_USERMOD += $(WAVESHARE_LCD_MOD_DIR)/font8.c
-SRC_USERMOD += $(WAVESHARE_LCD_MOD_DIR)/font12.c
-SRC_USERMOD += $(WAVESHARE_LCD_MOD_DIR)/font16.c
-SRC_USERMOD += $(WAVESHARE_LCD_MOD_DIR)/font20.c
-SRC_USERMOD += $(WAVESHARE_LCD_MOD_DIR)/font24.c
+
+# Panel and bus driver of this board, the sources of the SDK lcd library
+SRC_USERMOD += $(LCD_BOARD_DIR)/bsp_dma_channel_irq.c
+SRC_USERMOD += $(LCD_BOARD_DIR)/lcd.c
+SRC_USERMOD += $(LCD_BOARD_DIR)/pio_qspi.c
+
+# Drawing core shared by all boards, LCD_CORE_SOURCES in lcd_core.cmake
+SRC_USERMOD += $(LCD_CORE_DIR)/font8.c
+SRC_USERMOD += $(LCD_CORE_DIR)/font12.c
+SRC_USERMOD += $(LCD_CORE_DIR)/font16.c
+SRC_USERMOD += $(LCD_CORE_DIR)/font20.c
+SRC_USERMOD += $(LCD_CORE_DIR)/font24.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_profile.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_blend.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_draw.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_expand.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_font.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_glyph.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_image.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_memset.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_palette.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_rotation.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_sprite.c
+SRC_USERMOD += $(LCD_CORE_DIR)/lcd_tile.c
 
 # We can add our module folder to include paths if needed
 CFLAGS_USERMOD += -I$(WAVESHARE_LCD_MOD_DIR)
+CFLAGS_USERMOD += -I$(LCD_BOARD_DIR)
+CFLAGS_USERMOD += -I$(LCD_CORE_DIR)
+
+# Frame-rate and per-primitive counters, see lcd_profile.h: make LCD_PROFILE=1
+ifeq ($(LCD_PROFILE),1)
+CFLAGS_USERMOD += -DLCD_PROFILE=1
+endif
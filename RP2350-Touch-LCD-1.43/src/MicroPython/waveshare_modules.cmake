@@ -1,56 +1,24 @@
 # Combined Waveshare Modules for MicroPython
 
-# Include waveshare_lcd module
-add_library(usermod_waveshare_lcd INTERFACE)
+# Include waveshare_lcd module, kept in its own file as it also pulls in the
+# fonts and profiling counters shared through common/lcd
+include(${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/micropython.cmake)
 
-# Generate PIO header from .pio file
-pico_generate_pio_header(usermod_waveshare_lcd
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/pio_qspi.pio
-)
-
-target_sources(usermod_waveshare_lcd INTERFACE
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/waveshare_lcd.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/bsp_dma_channel_irq.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/lcd.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font8.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font12.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font16.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font20.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/font24.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd/pio_qspi.c
-)
-
-target_include_directories(usermod_waveshare_lcd INTERFACE
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_lcd
-)
-
-target_compile_definitions(usermod_waveshare_lcd INTERFACE
-    MODULE_WAVESHARE_LCD_ENABLED=1
-)
-
-target_link_libraries(usermod INTERFACE usermod_waveshare_lcd)
-
-# Link against the required Pico SDK libraries for LCD
-target_link_libraries(usermod_waveshare_lcd INTERFACE
-    pico_stdlib
-    pico_printf
-    pico_float
-    hardware_gpio
-    hardware_spi
-    hardware_pwm
-    hardware_pio
-)
+# The other modules build their driver from src/SDK, the module folders only
+# hold the Python bindings
+set(WAVESHARE_SDK_DIR ${CMAKE_CURRENT_LIST_DIR}/../SDK)
 
 # Include waveshare_battery module
 add_library(usermod_waveshare_battery INTERFACE)
 
 target_sources(usermod_waveshare_battery INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_battery/waveshare_battery.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_battery/battery.c
+    ${WAVESHARE_SDK_DIR}/battery/battery.c
 )
 
 target_include_directories(usermod_waveshare_battery INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_battery
+    ${WAVESHARE_SDK_DIR}/battery
 )
 
 target_compile_definitions(usermod_waveshare_battery INTERFACE
@@ -74,15 +42,19 @@ add_library(usermod_waveshare_touch INTERFACE)
 
 target_sources(usermod_waveshare_touch INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_touch/waveshare_touch.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_touch/touch.c
+    ${WAVESHARE_SDK_DIR}/touch/touch.c
 )
 
 target_include_directories(usermod_waveshare_touch INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_touch
+    ${WAVESHARE_SDK_DIR}/touch
+    ${LCD_BOARD_DIR}
+    ${LCD_CORE_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_touch INTERFACE
     MODULE_WAVESHARE_TOUCH_ENABLED=1
+    TOUCH_POLL=1
 )
 
 target_link_libraries(usermod INTERFACE usermod_waveshare_touch)
@@ -101,11 +73,12 @@ add_library(usermod_waveshare_qmi INTERFACE)
 
 target_sources(usermod_waveshare_qmi INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_qmi/waveshare_qmi.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_qmi/qmi.c
+    ${WAVESHARE_SDK_DIR}/qmi/qmi.c
 )
 
 target_include_directories(usermod_waveshare_qmi INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_qmi
+    ${WAVESHARE_SDK_DIR}/qmi
 )
 
 target_compile_definitions(usermod_waveshare_qmi INTERFACE
@@ -128,12 +101,13 @@ add_library(usermod_waveshare_sd INTERFACE)
 
 target_sources(usermod_waveshare_sd INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_sd/waveshare_sd.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_sd/sdcard.c
-    ${CMAKE_CURRENT_LIST_DIR}/waveshare_sd/fat32.c
+    ${WAVESHARE_SDK_DIR}/sd/sdcard.c
+    ${WAVESHARE_SDK_DIR}/sd/fat32.c
 )
 
 target_include_directories(usermod_waveshare_sd INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_sd
+    ${WAVESHARE_SDK_DIR}/sd
 )
 
 target_compile_definitions(usermod_waveshare_sd INTERFACE
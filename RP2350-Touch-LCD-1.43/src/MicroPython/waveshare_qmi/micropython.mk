@@ -1,7 +1,9 @@
 WAVESHARE_QMI_MOD_DIR := $(USERMOD_DIR)
+WAVESHARE_QMI_DRIVER_DIR := $(USERMOD_DIR)/../../SDK/qmi
 
 # Add all C files to SRC_USERMOD.
 SRC_USERMOD += $(WAVESHARE_QMI_MOD_DIR)/waveshare_qmi.c
-SRC_USERMOD += $(WAVESHARE_QMI_MOD_DIR)/qmi.c
+SRC_USERMOD += $(WAVESHARE_QMI_DRIVER_DIR)/qmi.c
 # We can add our module folder to include paths if needed
-CFLAGS_USERMOD += -I$(WAVESHARE_QMI_MOD_DIR)
\ No newline at end of file
+CFLAGS_USERMOD += -I$(WAVESHARE_QMI_MOD_DIR)
+CFLAGS_USERMOD += -I$(WAVESHARE_QMI_DRIVER_DIR)
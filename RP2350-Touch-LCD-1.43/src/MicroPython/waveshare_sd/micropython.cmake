@@ -1,14 +1,17 @@
-# Create a C module for Waveshare sd extension
+# Create a C module for Waveshare sd extension, built on
+# the driver in src/SDK/sd
+set(WAVESHARE_SD_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/sd)
 add_library(usermod_waveshare_sd INTERFACE)
 
 target_sources(usermod_waveshare_sd INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_sd.c
-    ${CMAKE_CURRENT_LIST_DIR}/sdcard.c
-    ${CMAKE_CURRENT_LIST_DIR}/fat32.c
+    ${WAVESHARE_SD_DRIVER_DIR}/sdcard.c
+    ${WAVESHARE_SD_DRIVER_DIR}/fat32.c
 )
 
 target_include_directories(usermod_waveshare_sd INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_SD_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_sd INTERFACE
@@ -1,7 +1,11 @@
 WAVESHARE_TOUCH_MOD_DIR := $(USERMOD_DIR)
+WAVESHARE_TOUCH_DRIVER_DIR := $(USERMOD_DIR)/../../SDK/touch
 
 # Add all C files to SRC_USERMOD.
 SRC_USERMOD += $(WAVESHARE_TOUCH_MOD_DIR)/waveshare_touch.c
-SRC_USERMOD += $(WAVESHARE_TOUCH_MOD_DIR)/touch.c
+SRC_USERMOD += $(WAVESHARE_TOUCH_DRIVER_DIR)/touch.c
 # We can add our module folder to include paths if needed
-CFLAGS_USERMOD += -I$(WAVESHARE_TOUCH_MOD_DIR)
\ No newline at end of file
+CFLAGS_USERMOD += -I$(WAVESHARE_TOUCH_MOD_DIR)
+CFLAGS_USERMOD += -I$(WAVESHARE_TOUCH_DRIVER_DIR)
+CFLAGS_USERMOD += -I$(USERMOD_DIR)/../../SDK/lcd -I$(USERMOD_DIR)/../../../../common/lcd
+CFLAGS_USERMOD += -DTOUCH_POLL=1
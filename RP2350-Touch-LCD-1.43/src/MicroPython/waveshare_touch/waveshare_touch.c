@@ -8,6 +8,7 @@
 #include "py/objarray.h"
 #include "py/mphal.h"
 #include "touch.h"
+#include "hardware/sync.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -33,6 +34,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_touch_get_touch_point_obj, waveshare_
 STATIC mp_obj_t waveshare_touch_init(void)
 {
     touch_init();
+    enable_interrupts(); // the touch interrupt needs them unmasked
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(waveshare_touch_init_obj, waveshare_touch_init);
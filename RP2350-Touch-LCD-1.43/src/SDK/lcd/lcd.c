@@ -1,72 +1,66 @@
-#include "lcd.h"
+#include "lcd_internal.h"
+#include "lcd_expand.h"
+#include "lcd_memset.h"
+#include <string.h>
 #include "pio_qspi.h"
 #include "hardware/dma.h"
 #include "hardware/pio.h"
+#include "hardware/sync.h"
+#if LCD_DUAL_CORE
+#include "lcd_ring.h"
+#include "pico/multicore.h"
+#endif
 
 static bool lcd_initialized = false; // flag to indicate if the LCD is initialized
 
-// Static framebuffer (16-bit per pixel for RGB565)
-static uint8_t framebuffer[LCD_WIDTH * LCD_HEIGHT];
-static uint16_t palette[256]; // 256-color palette for RGB332
 static uint8_t backlight_level;
 static uint8_t last_cmd = 0x00; // Track last command for data writes
 static bool set_brightness_flag = false;
 
-static FontTable *current_font = NULL;
-
-/******************************************************************************
- * function: Convert a 16-bit RGB565 color to an 8-bit RGB332 color
- * parameter:
- *    color : 16-bit RGB565 color value
- * returns: 8-bit RGB332 color value
- ******************************************************************************/
-static uint8_t lcd_color565_to_332(uint16_t color)
-{
-    return ((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3);
-}
-/******************************************************************************
- * function: Convert 8-bit RGB332 components to a 16-bit RGB565 color
- * parameter:
- *    r : Red component (0-255)
- *    g : Green component (0-255)
- *    b : Blue component (0-255)
- * returns: 16-bit RGB565 color value
- ******************************************************************************/
-static uint16_t lcd_color332_to_565(uint8_t r, uint8_t g, uint8_t b)
-{
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-}
-
-/******************************************************************************
- * function: DMA completion callback for frame buffer flush
- * parameter: none
- * returns: none
- * note: Called when DMA transfer completes. Handles brightness updates.
- ******************************************************************************/
-static void __no_inline_not_in_flash_func(flush_dma_done_cb)(void)
-{
-    __asm__ volatile("nop");
-    __asm__ volatile("nop");
-
-    gpio_put(LCD_CS_PIN, 1);
-
-    if (set_brightness_flag)
-    {
-        set_brightness_flag = false;
-        uint8_t oled_brightness = 0x25 + (backlight_level * (0xFF - 0x25)) / 100;
-
-        uint8_t buffer[5];
-        buffer[0] = 0x02;
-        buffer[1] = 0x00;
-        buffer[2] = 0x51;
-        buffer[3] = 0x00;
-        buffer[4] = oled_brightness;
-
-        gpio_put(LCD_CS_PIN, 0);
-        pio_qspi_1bit_write_data_blocking(buffer, 5);
-        gpio_put(LCD_CS_PIN, 1);
-    }
-}
+#if LCD_COLOR_DEPTH != 16 || LCD_TILED
+#define SWAP_BUFFER_LINES LCD_CHUNK_LINES
+#else
+#define SWAP_BUFFER_LINES 1 // only used to gather rotated frames
+#endif
+#if LCD_DUAL_CORE
+// Line buffers of the chunk ring: core1 converts into the free ones while
+// DMA drains the others, see lcd_ring.h
+static uint16_t line_buffers[LCD_RING_SLOTS][LCD_WIDTH * SWAP_BUFFER_LINES];
+static uint8_t swap_fill_buffer = 0;            // line buffer of the slot core1 fills
+static lcd_ring_t swap_ring;
+static void lcd_core1_entry(void);
+#else
+// Ping-pong line buffers for the DMA frame transfer: while DMA drains one,
+// the next chunk of the framebuffer (or of the band) is converted into the
+// other
+static uint16_t line_buffers[2][LCD_WIDTH * SWAP_BUFFER_LINES];
+static uint8_t swap_fill_buffer = 0;            // line buffer the next chunk is converted into
+static const uint8_t *volatile swap_pending_data = NULL; // next chunk ready for DMA
+static volatile size_t swap_pending_bytes = 0;  // size of that chunk, 0 when none is ready
+static volatile uint16_t swap_next_y = 0;       // first row of the region not yet converted
+#endif
+static volatile bool swap_busy = false;         // true while a frame is being streamed
+static volatile uint32_t swap_cpu_us = 0;       // CPU time spent on the current frame
+static uint32_t swap_start_us = 0;              // timestamp of the current frame start
+static uint32_t swap_request_us = 0;            // timestamp lcd_swap_async queued the frame
+static volatile bool swap_armed = false;        // frame queued, waiting for the TE edge
+static dirty_area_t swap_areas[LCD_MAX_DIRTY_AREAS]; // regions of the frame in flight, panel frame
+static uint8_t swap_area_count = 0;
+static volatile uint8_t swap_area_index = 0;    // region currently being streamed
+static uint16_t swap_chunk_lines = LCD_CHUNK_LINES; // rows per DMA transfer for that region
+static LcdFrameTiming frame_timing = {0};
+#if LCD_PROFILE
+static uint32_t swap_profile_start = 0;  // lcd_profile_now() when the frame started
+static uint32_t swap_profile_pixels = 0; // pixels of the frame in flight
+#endif
+
+// Tearing effect pacing and frame statistics
+static bool vsync_enabled = false;
+static volatile uint32_t te_count = 0;     // TE edges seen since vsync was enabled
+static uint32_t te_count_last_frame = 0;    // te_count when the previous frame started
+static uint32_t fps_window_start_us = 0;
+static uint32_t fps_window_frames = 0;
+static LcdFrameStats frame_stats = {0};
 
 typedef struct
 {
@@ -94,6 +88,7 @@ static void tx_param(oled_cmd_t *cmds, size_t cmd_len)
         }
         pio_qspi_1bit_write_data_blocking(write_buffer, 4 + cmds[i].data_bytes);
         // spi_write_blocking(BSP_OLED_SPI_NUM, write_buffer, 4 + cmds[i].data_bytes);
+        pio_qspi_wait_idle();
         gpio_put(LCD_CS_PIN, 1);
         if (cmds[i].delay_ms > 0)
         {
@@ -102,15 +97,21 @@ static void tx_param(oled_cmd_t *cmds, size_t cmd_len)
     }
 }
 
-static void set_window()
+/******************************************************************************
+ * function: Set the controller column/row window
+ * parameter:
+ *    area : Framebuffer region (inclusive bounds)
+ * returns: none
+ ******************************************************************************/
+static void set_window(const dirty_area_t *area)
 {
     oled_cmd_t cmds[2];
 
-    uint16_t x_start = LCD_X_OFFSET;
-    uint16_t x_end = LCD_WIDTH + LCD_X_OFFSET;
+    uint16_t x_start = area->x0 + LCD_X_OFFSET;
+    uint16_t x_end = area->x1 + LCD_X_OFFSET;
 
-    uint16_t y_start = 0;
-    uint16_t y_end = LCD_HEIGHT;
+    uint16_t y_start = area->y0;
+    uint16_t y_end = area->y1;
     uint8_t x_data[4];
     uint8_t y_data[4];
     x_data[0] = (x_start >> 8) & 0xFF;
@@ -137,464 +138,384 @@ static void set_window()
 }
 
 /******************************************************************************
-function: Send command and data to OLED using the CO5300 protocol with PIO QSPI
-parameter:
-    cmd  : Command byte
-    data : Data bytes (can be NULL if data_len is 0)
-    data_len : Number of data bytes
-returns: none
-note: Low-level function used internally for OLED communication
-      CO5300 protocol: Header(0x02, 0x00, cmd, 0x00) + data bytes
-******************************************************************************/
-static void lcd_send_cmd_data(uint8_t cmd, const uint8_t *data, size_t data_len)
+ * function: Rows per DMA transfer for a region
+ * parameter:
+ *    area : Region to stream, in the panel frame
+ * returns: Number of rows
+ ******************************************************************************/
+static uint16_t lcd_area_chunk_lines(const dirty_area_t *area)
 {
-    size_t total_len = 4 + data_len;
-    uint8_t *buffer = malloc(total_len);
-    if (buffer == NULL)
+    uint16_t area_width = area->x1 - area->x0 + 1;
+
+#if LCD_COLOR_DEPTH == 16 && !LCD_TILED
+    // Full-width regions are contiguous in memory and go out in one transfer
+    if (lcd_transform == 0)
+        return (area_width == LCD_WIDTH) ? (area->y1 - area->y0 + 1) : 1;
+#endif
+    // Narrow regions fit more rows into one line buffer, but no more than
+    // one band in tiled mode
+    uint16_t lines = (LCD_WIDTH * SWAP_BUFFER_LINES) / area_width;
+    if (LCD_TILED && lines > LCD_TILE_LINES)
+        lines = LCD_TILE_LINES;
+    return lines;
+}
+
+/******************************************************************************
+ * function: Prepare the next chunk of a framebuffer region for DMA
+ * parameter:
+ *    area  : Region being streamed, in the panel frame
+ *    y     : First panel row of the chunk
+ *    bytes : Receives the chunk size in bytes
+ * returns: Address DMA should read the chunk from
+ * note: RGB332 rows are expanded into the next ping-pong line buffer, or in
+ *       dual-core mode into the line buffer of the ring slot being filled. A
+ *       native RGB565 framebuffer is already in panel order and is sent
+ *       straight from memory. In tiled mode the rows are rasterized into the
+ *       band first and copied out of it the same way. With a rotation set,
+ *       each panel row is gathered from a framebuffer row or column.
+ ******************************************************************************/
+static const uint8_t *__not_in_flash_func(lcd_prepare_chunk)(const dirty_area_t *area, uint16_t y, size_t *bytes)
+{
+    uint16_t area_width = area->x1 - area->x0 + 1;
+    uint16_t lines_to_send = (y + swap_chunk_lines > area->y1 + 1) ? (area->y1 + 1 - y) : swap_chunk_lines;
+
+    *bytes = (size_t)area_width * lines_to_send * 2;
+    LCD_PROFILE_CHARGE(LCD_PROFILE_SWAP_CONVERT, (uint32_t)area_width * lines_to_send);
+
+#if LCD_TILED
+    // Only mirrored orientations are allowed in tiled mode, so the chunk is
+    // a run of framebuffer rows, possibly upside down and right to left
+    int band_x0 = (lcd_transform & LCD_FLIP_X) ? LCD_WIDTH - 1 - area->x1 : area->x0;
+    int band_y = (lcd_transform & LCD_FLIP_Y) ? LCD_HEIGHT - y - lines_to_send : y;
+    lcd_tile_render(band_x0, band_x0 + area_width - 1, band_y, lines_to_send);
+#else
+#if LCD_COLOR_DEPTH == 16
+    if (lcd_transform == 0)
+        return (const uint8_t *)LCD_PIXEL_AT(area->x0, y);
+#endif
+#endif
+    uint16_t *buffer = line_buffers[swap_fill_buffer];
+    uint16_t *dst = buffer;
+#if !LCD_DUAL_CORE
+    swap_fill_buffer ^= 1;
+#endif
+
+    for (uint16_t line = 0; line < lines_to_send; line++)
+    {
+        int step = 1;
+        const lcd_pixel_t *src = lcd_transform ? lcd_transform_row(area->x0, y + line, &step)
+                                               : LCD_PIXEL_AT(area->x0, y + line);
+#if LCD_COLOR_DEPTH == 16
+        if (step == 1)
+            memcpy(dst, src, area_width * sizeof(uint16_t));
+        else
+            lcd_copy_rgb565_step(dst, src, area_width, step);
+#else
+        if (step == 1)
+            lcd_expand_rgb332(dst, src, area_width, lcd_palette);
+        else
+            lcd_expand_rgb332_step(dst, src, area_width, step, lcd_palette);
+#endif
+        dst += area_width;
+    }
+    return (const uint8_t *)buffer;
+}
+
+/******************************************************************************
+ * function: Send the pending brightness change to the panel
+ * parameter: none
+ * returns: none
+ * note: Must not run while a frame transfer owns the bus
+ ******************************************************************************/
+static void lcd_apply_brightness(void)
+{
+    if (!set_brightness_flag)
         return;
 
+    set_brightness_flag = false;
+    uint8_t oled_brightness = 0x25 + (backlight_level * (0xFF - 0x25)) / 100;
+
+    uint8_t buffer[5];
     buffer[0] = 0x02;
     buffer[1] = 0x00;
-    buffer[2] = cmd;
+    buffer[2] = 0x51;
     buffer[3] = 0x00;
-
-    for (size_t i = 0; i < data_len; i++)
-    {
-        buffer[4 + i] = data[i];
-    }
+    buffer[4] = oled_brightness;
 
     gpio_put(LCD_CS_PIN, 0);
-    pio_qspi_1bit_write_data_blocking(buffer, total_len);
+    pio_qspi_1bit_write_data_blocking(buffer, 5);
+    pio_qspi_wait_idle();
     gpio_put(LCD_CS_PIN, 1);
-
-    free(buffer);
-}
-
-/******************************************************************************
-function: Draw a single pixel to the framebuffer
-parameter:
-    X     : X coordinate (0 to LCD_WIDTH-1)
-    Y     : Y coordinate (0 to LCD_HEIGHT-1)
-    color : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_draw_pixel(uint16_t x, uint16_t y, uint16_t color)
-{
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT)
-    {
-        return; // bounds check
-    }
-    // Convert to 8-bit and store
-    framebuffer[y * LCD_WIDTH + x] = lcd_color565_to_332(color);
 }
 
+#if LCD_DUAL_CORE
 /******************************************************************************
-function: Draw a line between two points using Bresenham's algorithm
-parameter:
-    x1    : Starting X coordinate
-    y1    : Starting Y coordinate
-    x2    : Ending X coordinate
-    y2    : Ending Y coordinate
-    color : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+ * function: Core1 conversion loop
+ * parameter: none
+ * returns: none
+ * note: Waits for a region count from core0 on the inter-core FIFO and
+ *       converts swap_areas (rasterizes them in tiled mode) chunk by chunk
+ *       into the ring, then publishes the end of the frame. Core0's DMA IRQ
+ *       sends the chunks once the frame is released, see lcd_ring.h.
+ ******************************************************************************/
+static void lcd_core1_entry(void)
 {
-    int dx = abs((int)x2 - (int)x1);
-    int dy = abs((int)y2 - (int)y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-    const uint8_t color_index = lcd_color565_to_332(color);
+    lcd_profile_init(); // cycle counter of core1, which converts the frames
     while (true)
     {
-        // Draw pixel if within bounds
-        if (x1 < LCD_WIDTH && y1 < LCD_HEIGHT)
+        uint8_t area_count = (uint8_t)multicore_fifo_pop_blocking();
+        for (uint8_t n = 0; n < area_count; n++)
         {
-            framebuffer[y1 * LCD_WIDTH + x1] = color_index;
-        }
-
-        // Check if we've reached the end point
-        if (x1 == x2 && y1 == y2)
-            break;
-
-        int e2 = 2 * err;
-        if (e2 > -dy)
-        {
-            err -= dy;
-            x1 += sx;
-        }
-        if (e2 < dx)
-        {
-            err += dx;
-            y1 += sy;
+            const dirty_area_t *area = &swap_areas[n];
+            swap_chunk_lines = lcd_area_chunk_lines(area);
+            for (uint16_t y = area->y0; y <= area->y1; y += swap_chunk_lines)
+            {
+                size_t bytes;
+                swap_fill_buffer = lcd_ring_acquire(&swap_ring);
+                const uint8_t *data = lcd_prepare_chunk(area, y, &bytes);
+                lcd_ring_publish(&swap_ring, data, bytes, n);
+            }
         }
+        lcd_ring_acquire(&swap_ring);
+        lcd_ring_publish(&swap_ring, NULL, 0, area_count);
     }
 }
+#endif
 
 /******************************************************************************
-function: Draw a rectangle outline to the framebuffer
-parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of rectangle
-    height : Height of rectangle
-    color  : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
-{
-    const uint8_t color_index = lcd_color565_to_332(color);
-    // Draw four lines to form rectangle
-    lcd_draw_line(x, y, x + width - 1, y, color_index);                           // Top
-    lcd_draw_line(x, y + height - 1, x + width - 1, y + height - 1, color_index); // Bottom
-    lcd_draw_line(x, y, x, y + height - 1, color_index);                          // Left
-    lcd_draw_line(x + width - 1, y, x + width - 1, y + height - 1, color_index);  // Right
-}
-
-/******************************************************************************
-function: Draw a filled rectangle to the framebuffer
-parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of rectangle
-    height : Height of rectangle
-    color  : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+ * function: Start streaming the current region of the frame in flight
+ * parameter:
+ *    start_us : Timestamp the caller started working on the frame
+ * returns: none
+ * note: Sets the window, prepares the first two chunks and kicks the first
+ *       DMA transfer. The rest of the region is chained from the DMA IRQ. In
+ *       dual-core mode the first chunk comes from the ring instead.
+ ******************************************************************************/
+static void lcd_swap_start_area(uint32_t start_us)
 {
-    // Bounds clipping
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT)
-        return;
+    const dirty_area_t *area = &swap_areas[swap_area_index];
+#if LCD_PROFILE
+    uint16_t area_width = area->x1 - area->x0 + 1;
+    swap_profile_pixels += (uint32_t)area_width * (area->y1 - area->y0 + 1);
+#endif
+
+    set_window(area);
+
+#if LCD_DUAL_CORE
+    // Core1 started converting at lcd_swap_async, the chunk is usually ready
+    const lcd_ring_slot_t *slot = lcd_ring_peek(&swap_ring);
+    const uint8_t *first_data = slot->data;
+    size_t first_bytes = slot->size;
+#else
+    swap_chunk_lines = lcd_area_chunk_lines(area);
+    swap_fill_buffer = 0;
+
+    // Prepare two chunks before DMA starts so the IRQ never waits on us
+    size_t first_bytes;
+    const uint8_t *first_data = lcd_prepare_chunk(area, area->y0, &first_bytes);
+    swap_next_y = area->y0 + swap_chunk_lines;
+    swap_pending_bytes = 0;
+    if (swap_next_y <= area->y1)
+    {
+        size_t bytes;
+        swap_pending_data = lcd_prepare_chunk(area, swap_next_y, &bytes);
+        swap_pending_bytes = bytes;
+        swap_next_y += swap_chunk_lines;
+    }
+#endif
 
-    if (x + width > LCD_WIDTH)
-        width = LCD_WIDTH - x;
-    if (y + height > LCD_HEIGHT)
-        height = LCD_HEIGHT - y;
+    // Prepare pixel data command header (0x32 for DMA transfer)
+    uint8_t cmd_header[4] = {0x32, 0x00, 0x2C, 0x00};
 
-    const uint8_t color_index = lcd_color565_to_332(color);
+    gpio_put(LCD_CS_PIN, 0);
+    pio_qspi_1bit_write_data_blocking(cmd_header, 4);
 
-    // Fast fill using optimized loops
-    for (uint16_t py = y; py < y + height; py++)
-    {
-        for (uint16_t px = x; px < x + width; px++)
-        {
-            framebuffer[py * LCD_WIDTH + px] = color_index;
-        }
-    }
+    swap_cpu_us += time_us_32() - start_us;
+    pio_qspi_4bit_write_data((uint8_t *)first_data, first_bytes);
 }
 
 /******************************************************************************
-function: Draw a single character to the framebuffer
-parameter:
-    x     : Top-left X coordinate
-    y     : Top-left Y coordinate
-    c     : Character to draw
-    color : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_draw_char(uint16_t x, uint16_t y, char c, uint16_t color)
+ * function: DMA completion callback for frame buffer flush
+ * parameter: none
+ * returns: none
+ * note: Called when DMA transfer completes. While a frame is in flight this
+ *       hands the already prepared chunk to DMA and prepares the one after
+ *       it, or in dual-core mode releases the chunk DMA just read and sends
+ *       the next one core1 published, then moves on to the next dirty
+ *       region. After the last region it releases CS, records the frame
+ *       timing and handles brightness updates.
+ ******************************************************************************/
+static void __no_inline_not_in_flash_func(flush_dma_done_cb)(void)
 {
-    if (current_font == NULL || c < 32 || c > 126)
-        return; // invalid font or character
-
-    // Calculate bytes per row (width rounded up to nearest byte boundary)
-    uint8_t bytes_per_row = (current_font->width + 7) / 8;
-    const uint8_t *char_data = &current_font->table[(c - 32) * current_font->height * bytes_per_row];
-
-    for (uint8_t row = 0; row < current_font->height; row++)
+#if LCD_DUAL_CORE
+    if (swap_busy)
     {
-        const uint8_t *row_data = &char_data[row * bytes_per_row];
+        uint32_t start_us = time_us_32();
 
-        for (uint8_t col = 0; col < current_font->width; col++)
+        lcd_ring_release(&swap_ring);
+        const lcd_ring_slot_t *slot = lcd_ring_peek(&swap_ring);
+        swap_cpu_us += time_us_32() - start_us;
+        if (slot->area == swap_area_index)
         {
-            uint8_t byte_index = col / 8;
-            uint8_t bit_index = 7 - (col % 8);
-
-            if (row_data[byte_index] & (1 << bit_index))
-            {
-                lcd_draw_pixel(x + col, y + row, color);
-            }
+            pio_qspi_4bit_write_data((uint8_t *)slot->data, slot->size);
+            return;
         }
     }
-}
-
-/******************************************************************************
-function: Draw a circle outline to the framebuffer
-parameter:
-    center_x : Center X coordinate
-    center_y : Center Y coordinate
-    radius   : Radius in pixels
-    color    : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_draw_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
-{
-    if (radius == 0 || radius > 100)
-        return;
+#else
+    if (swap_busy && swap_pending_bytes > 0)
+    {
+        uint32_t start_us = time_us_32();
+        const dirty_area_t *area = &swap_areas[swap_area_index];
 
-    int x = 0;
-    int y = radius;
-    int d = 3 - 2 * radius;
-    const uint8_t color_index = lcd_color565_to_332(color);
+        // Keep the bus busy first, then refill the line buffer DMA just released
+        pio_qspi_4bit_write_data((uint8_t *)swap_pending_data, swap_pending_bytes);
+        swap_pending_bytes = 0;
 
-    while (x <= y)
-    {
-        // Draw 8 symmetric points
-        if (center_x + x < LCD_WIDTH && center_y + y < LCD_HEIGHT)
-            framebuffer[(center_y + y) * LCD_WIDTH + (center_x + x)] = color_index;
-        if (center_x - x < LCD_WIDTH && center_y + y < LCD_HEIGHT)
-            framebuffer[(center_y + y) * LCD_WIDTH + (center_x - x)] = color_index;
-        if (center_x + x < LCD_WIDTH && center_y - y < LCD_HEIGHT)
-            framebuffer[(center_y - y) * LCD_WIDTH + (center_x + x)] = color_index;
-        if (center_x - x < LCD_WIDTH && center_y - y < LCD_HEIGHT)
-            framebuffer[(center_y - y) * LCD_WIDTH + (center_x - x)] = color_index;
-        if (center_x + y < LCD_WIDTH && center_y + x < LCD_HEIGHT)
-            framebuffer[(center_y + x) * LCD_WIDTH + (center_x + y)] = color_index;
-        if (center_x - y < LCD_WIDTH && center_y + x < LCD_HEIGHT)
-            framebuffer[(center_y + x) * LCD_WIDTH + (center_x - y)] = color_index;
-        if (center_x + y < LCD_WIDTH && center_y - x < LCD_HEIGHT)
-            framebuffer[(center_y - x) * LCD_WIDTH + (center_x + y)] = color_index;
-        if (center_x - y < LCD_WIDTH && center_y - x < LCD_HEIGHT)
-            framebuffer[(center_y - x) * LCD_WIDTH + (center_x - y)] = color_index;
-
-        if (d < 0)
-            d += 4 * x + 6;
-        else
+        if (swap_next_y <= area->y1)
         {
-            d += 4 * (x - y) + 10;
-            y--;
+            size_t bytes;
+            swap_pending_data = lcd_prepare_chunk(area, swap_next_y, &bytes);
+            swap_pending_bytes = bytes;
+            swap_next_y += swap_chunk_lines;
         }
-        x++;
+
+        swap_cpu_us += time_us_32() - start_us;
+        return;
     }
-}
+#endif
 
-void lcd_draw_text(uint16_t x, uint16_t y, const char *text, uint16_t color)
-{
-    if (current_font == NULL)
-        return; // invalid font
+    // DMA only filled the FIFO, wait for the last nibbles to be clocked out
+    pio_qspi_wait_idle();
 
-    uint16_t cursor_x = x;
-    uint16_t cursor_y = y;
+    gpio_put(LCD_CS_PIN, 1);
 
-    while (*text)
+    if (swap_busy)
     {
-        char ch = *text;
-
-        if (ch == '\n')
+        if (swap_area_index + 1 < swap_area_count)
         {
-            cursor_x = x;                     // Reset to start of line
-            cursor_y += current_font->height; // Move down one line
+            uint32_t start_us = time_us_32();
+            swap_area_index++;
+            lcd_swap_start_area(start_us);
+            return;
         }
-        else if (ch == ' ')
+
+#if LCD_DUAL_CORE
+        lcd_ring_release(&swap_ring); // end of the frame
+#endif
+        uint32_t now_us = time_us_32();
+#if LCD_PROFILE
+        lcd_profile_count(LCD_PROFILE_SWAP_TRANSFER, lcd_profile_now() - swap_profile_start, swap_profile_pixels);
+#endif
+        frame_timing.frame_count++;
+        frame_timing.transfer_us = now_us - swap_start_us;
+        frame_timing.cpu_us = swap_cpu_us;
+
+        frame_stats.frame_count++;
+        frame_stats.latency_us = now_us - swap_request_us;
+        if (frame_stats.latency_us > frame_stats.max_latency_us)
+            frame_stats.max_latency_us = frame_stats.latency_us;
+
+        fps_window_frames++;
+        uint32_t window_us = now_us - fps_window_start_us;
+        if (window_us >= 1000000)
         {
-            // Handle space - just advance position without drawing
-            cursor_x += current_font->width;
+            frame_stats.fps = (float)fps_window_frames * 1000000.0f / (float)window_us;
+            fps_window_frames = 0;
+            fps_window_start_us = now_us;
         }
-        else
-        {
-            // Check if character would exceed screen width
-            if (cursor_x + current_font->width > LCD_WIDTH)
-            {
-                // Wrap to next line
-                cursor_x = x;
-                cursor_y += current_font->height;
-            }
 
-            // Check if we're still within screen height
-            if (cursor_y + current_font->height <= LCD_HEIGHT)
-            {
-                lcd_draw_char(cursor_x, cursor_y, ch, color);
-            }
-
-            cursor_x += current_font->width;
-        }
-        text++;
+        swap_busy = false;
     }
+
+    lcd_apply_brightness();
 }
 
 /******************************************************************************
-function: Draw a filled circle to the framebuffer
-parameter:
-    center_x : Center X coordinate
-    center_y : Center Y coordinate
-    radius   : Radius in pixels
-    color    : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_fill_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+ * function: Start the frame queued by lcd_swap_async
+ * parameter: none
+ * returns: none
+ * note: Called from the TE IRQ in vsync mode, otherwise straight from
+ *       lcd_swap_async. In vsync mode callers outside the IRQ disable
+ *       interrupts first so the same frame cannot be started twice.
+ ******************************************************************************/
+static void lcd_swap_release(void)
 {
-    if (radius == 0 || radius > 100)
-        return;
-
-    const uint8_t color_index = lcd_color565_to_332(color);
+    uint32_t start_us = time_us_32();
 
-    int radius_squared = radius * radius;
+    swap_armed = false;
 
-    // Calculate bounding box
-    int start_x = (center_x > radius) ? (center_x - radius) : 0;
-    int end_x = (center_x + radius < LCD_WIDTH) ? (center_x + radius) : (LCD_WIDTH - 1);
-    int start_y = (center_y > radius) ? (center_y - radius) : 0;
-    int end_y = (center_y + radius < LCD_HEIGHT) ? (center_y + radius) : (LCD_HEIGHT - 1);
-
-    // Fill using distance check
-    for (int y = start_y; y <= end_y; y++)
+    if (vsync_enabled)
     {
-        int dy = y - center_y;
-        int dy_squared = dy * dy;
-
-        for (int x = start_x; x <= end_x; x++)
-        {
-            int dx = x - center_x;
-            int distance_squared = dx * dx + dy_squared;
-
-            if (distance_squared <= radius_squared)
-            {
-                framebuffer[y * LCD_WIDTH + x] = color_index;
-            }
-        }
+        // Every TE edge beyond the first since the previous frame is a
+        // refresh that showed the old frame again
+        uint32_t periods = te_count - te_count_last_frame;
+        if (frame_stats.frame_count > 0 && periods > 1)
+            frame_stats.dropped += periods - 1;
+        te_count_last_frame = te_count;
     }
+
+    swap_start_us = start_us;
+    swap_area_index = 0;
+    swap_cpu_us = 0;
+#if LCD_PROFILE
+    swap_profile_start = lcd_profile_now();
+    swap_profile_pixels = 0;
+#endif
+    lcd_swap_start_area(start_us);
 }
 
 /******************************************************************************
-function: Draw a filled triangle to the framebuffer
-parameter:
-    x1, y1 : First vertex coordinates
-    x2, y2 : Second vertex coordinates
-    x3, y3 : Third vertex coordinates
-    color  : RGB565 color value
-returns: none
-******************************************************************************/
-void lcd_fill_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t color)
+ * function: Tearing effect GPIO interrupt handler
+ * parameter: none
+ * returns: none
+ * note: The panel raises TE when it enters vertical blanking. Starting the
+ *       transfer there keeps the write ahead of the scan-out.
+ ******************************************************************************/
+#ifdef LCD_TE_PIN
+static void __no_inline_not_in_flash_func(te_irq_handler)(void)
 {
-    // Sort vertices by Y coordinate (y1 <= y2 <= y3)
-    if (y1 > y2)
-    {
-        uint16_t temp = x1;
-        x1 = x2;
-        x2 = temp;
-        temp = y1;
-        y1 = y2;
-        y2 = temp;
-    }
-    if (y2 > y3)
-    {
-        uint16_t temp = x2;
-        x2 = x3;
-        x3 = temp;
-        temp = y2;
-        y2 = y3;
-        y3 = temp;
-    }
-    if (y1 > y2)
-    {
-        uint16_t temp = x1;
-        x1 = x2;
-        x2 = temp;
-        temp = y1;
-        y1 = y2;
-        y2 = temp;
-    }
-
-    // Handle degenerate case
-    if (y1 == y3)
+    if (!(gpio_get_irq_event_mask(LCD_TE_PIN) & GPIO_IRQ_EDGE_RISE))
         return;
+    gpio_acknowledge_irq(LCD_TE_PIN, GPIO_IRQ_EDGE_RISE);
 
-    const uint8_t color_index = lcd_color565_to_332(color);
-
-    // Fill the triangle using horizontal scanlines
-    for (uint16_t y = y1; y <= y3; y++)
-    {
-        if (y >= LCD_HEIGHT)
-            break;
-
-        int x_left, x_right;
-        bool has_intersection = false;
-
-        // Find left edge intersection
-        if (y3 != y1)
-        {
-            x_left = x1 + (int)((x3 - x1) * (int)(y - y1)) / (int)(y3 - y1);
-            has_intersection = true;
-        }
-
-        // Find right edge intersection
-        if (y <= y2 && y2 != y1)
-        {
-            x_right = x1 + (int)((x2 - x1) * (int)(y - y1)) / (int)(y2 - y1);
-        }
-        else if (y > y2 && y3 != y2)
-        {
-            x_right = x2 + (int)((x3 - x2) * (int)(y - y2)) / (int)(y3 - y2);
-        }
-        else
-        {
-            x_right = x_left;
-        }
-
-        if (!has_intersection)
-            continue;
-
-        // Ensure x_left <= x_right
-        if (x_left > x_right)
-        {
-            int temp = x_left;
-            x_left = x_right;
-            x_right = temp;
-        }
-
-        // Clamp to screen bounds
-        if (x_left < 0)
-            x_left = 0;
-        if (x_right >= LCD_WIDTH)
-            x_right = LCD_WIDTH - 1;
-
-        // Draw horizontal line
-        for (int x = x_left; x <= x_right; x++)
-        {
-            framebuffer[y * LCD_WIDTH + x] = color_index;
-        }
-    }
+    te_count++;
+    if (swap_armed)
+        lcd_swap_release();
 }
+#endif
 
 /******************************************************************************
-function: Fill the entire framebuffer with a solid color
+function: Send command and data to OLED using the CO5300 protocol with PIO QSPI
 parameter:
-    color : RGB565 color value to fill with
+    cmd  : Command byte
+    data : Data bytes (can be NULL if data_len is 0)
+    data_len : Number of data bytes
 returns: none
+note: Low-level function used internally for OLED communication
+      CO5300 protocol: Header(0x02, 0x00, cmd, 0x00) + data bytes
 ******************************************************************************/
-void lcd_fill(uint16_t color)
+static void lcd_send_cmd_data(uint8_t cmd, const uint8_t *data, size_t data_len)
 {
-    const uint8_t color_index = lcd_color565_to_332(color);
-    for (uint32_t i = 0; i < LCD_HEIGHT * LCD_WIDTH; i++)
-    {
-        framebuffer[i] = color_index;
-    }
-}
+    size_t total_len = 4 + data_len;
+    uint8_t *buffer = malloc(total_len);
+    if (buffer == NULL)
+        return;
 
-/******************************************************************************
-function: Copy an external image buffer into the framebuffer at specified position
-parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of the buffer to blit
-    height : Height of the buffer to blit
-    buffer : Pointer to RGB332 pixel data array (8-bit per pixel)
-returns: none
-******************************************************************************/
-void lcd_blit(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *buffer)
-{
-    for (uint16_t j = 0; j < height; j++)
+    buffer[0] = 0x02;
+    buffer[1] = 0x00;
+    buffer[2] = cmd;
+    buffer[3] = 0x00;
+
+    for (size_t i = 0; i < data_len; i++)
     {
-        for (uint16_t i = 0; i < width; i++)
-        {
-            if ((x + i) < LCD_WIDTH && (y + j) < LCD_HEIGHT)
-            {
-                framebuffer[(y + j) * LCD_WIDTH + (x + i)] = buffer[j * width + i];
-            }
-        }
+        buffer[4 + i] = data[i];
     }
+
+    gpio_put(LCD_CS_PIN, 0);
+    pio_qspi_1bit_write_data_blocking(buffer, total_len);
+    gpio_put(LCD_CS_PIN, 1);
+
+    free(buffer);
 }
 
 /********************************************************************************
@@ -607,34 +528,6 @@ uint8_t lcd_get_backlight_level(void)
     return backlight_level;
 }
 
-/********************************************************************************
-function: Get the current font height
-parameter: none
-returns: Font height in pixels
-********************************************************************************/
-uint8_t lcd_get_font_height(void)
-{
-    if (current_font != NULL)
-    {
-        return current_font->height;
-    }
-    return 0;
-}
-
-/********************************************************************************
-function: Get the current font width
-parameter: none
-returns: Font width in pixels
-********************************************************************************/
-uint8_t lcd_get_font_width(void)
-{
-    if (current_font != NULL)
-    {
-        return current_font->width;
-    }
-    return 0;
-}
-
 /********************************************************************************
 function: Initialize the LCD display hardware and framebuffer
 returns: none
@@ -686,26 +579,21 @@ void lcd_init()
     oled_cmd_t brightness_cmd = {.reg = 0x51, .data = &oled_brightness, .data_bytes = 1, .delay_ms = 0};
     tx_param(&brightness_cmd, 1);
 
-    // init palette
-    for (int i = 0; i < 256; i++)
-    {
-        // Extract RGB332 components
-        uint8_t r3 = (i >> 5) & 0x07; // 3 bits for red
-        uint8_t g3 = (i >> 2) & 0x07; // 3 bits for green
-        uint8_t b2 = i & 0x03;        // 2 bits for blue
-
-        // Convert to 8-bit RGB
-        uint8_t r8 = (r3 * 255) / 7; // Scale 3-bit to 8-bit
-        uint8_t g8 = (g3 * 255) / 7; // Scale 3-bit to 8-bit
-        uint8_t b8 = (b2 * 255) / 3; // Scale 2-bit to 8-bit
-
-        // Convert to RGB565 for the palette
-        palette[i] = lcd_color332_to_565(r8, g8, b8);
-    }
+    lcd_palette_init(); // RGB332 palette, in panel byte order
 
     lcd_set_font(LCD_DEFAULT_FONT_SIZE); // Set default font
 
-    set_window(); // Set the drawing window to full screen
+    const dirty_area_t full_screen = {0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1};
+    set_window(&full_screen); // Set the drawing window to full screen
+    lcd_memset_init(); // DMA channel for lcd_fill and lcd_fill_rect
+    lcd_invalidate();          // Panel RAM is undefined after reset, send everything once
+    fps_window_start_us = time_us_32();
+    lcd_profile_init(); // cycle counter for LCD_PROFILE
+
+#if LCD_DUAL_CORE
+    // Core1 converts the chunks of every frame from here on
+    multicore_launch_core1(lcd_core1_entry);
+#endif
 
     lcd_initialized = true; // set the flag to indicate initialization is done
 }
@@ -739,31 +627,26 @@ void lcd_set_backlight_level(uint8_t brightness)
 
     backlight_level = brightness;
     set_brightness_flag = true;
+
+    // While a frame is in flight the DMA IRQ applies it once the bus is free
+    if (!swap_busy)
+        lcd_apply_brightness();
 }
 
-void lcd_set_font(FontSize size)
+/******************************************************************************
+function: Apply a display orientation (called by lcd_set_rotation)
+parameter:
+    transform : LCD_SWAP_XY, LCD_FLIP_X and LCD_FLIP_Y bits
+returns: false when the orientation cannot be shown
+note: The panel scans in its native orientation; lcd_prepare_chunk reads
+      the framebuffer in the matching order instead, so nothing is sent to
+      the controller. In tiled mode the band is a run of framebuffer rows
+      and cannot supply a panel row from a column, so only the orientations
+      without LCD_SWAP_XY are accepted.
+******************************************************************************/
+bool lcd_panel_orient(uint8_t transform)
 {
-    switch (size)
-    {
-    case FONT_XTRA_SMALL:
-        current_font = (FontTable *)&Font8;
-        break;
-    case FONT_SMALL:
-        current_font = (FontTable *)&Font12;
-        break;
-    case FONT_MEDIUM:
-        current_font = (FontTable *)&Font16;
-        break;
-    case FONT_LARGE:
-        current_font = (FontTable *)&Font20;
-        break;
-    case FONT_XTRA_LARGE:
-        current_font = (FontTable *)&Font24;
-        break;
-    default:
-        current_font = (FontTable *)&Font16; // Default to medium if invalid size
-        break;
-    }
+    return !(LCD_TILED && (transform & LCD_SWAP_XY));
 }
 
 /******************************************************************************
@@ -776,57 +659,167 @@ note: Call this after drawing operations to update the screen. This is the
 ******************************************************************************/
 void lcd_swap(void)
 {
-    // Set column address (X coordinates)
-    uint16_t x_start = LCD_X_OFFSET;
-    uint16_t x_end = LCD_WIDTH - 1 + LCD_X_OFFSET;
-    uint8_t x_data[4] = {
-        (x_start >> 8) & 0xFF,
-        x_start & 0xFF,
-        (x_end >> 8) & 0xFF,
-        x_end & 0xFF};
-    lcd_send_cmd_data(0x2A, x_data, 4);
-
-    // Set row address (Y coordinates)
-    uint16_t y_start = 0;
-    uint16_t y_end = LCD_HEIGHT - 1;
-    uint8_t y_data[4] = {
-        (y_start >> 8) & 0xFF,
-        y_start & 0xFF,
-        (y_end >> 8) & 0xFF,
-        y_end & 0xFF};
-    lcd_send_cmd_data(0x2B, y_data, 4);
+    lcd_swap_async();
+    lcd_swap_wait();
+}
 
-    // Prepare pixel data command header (0x32 for DMA transfer)
-    uint8_t cmd_header[4] = {0x32, 0x00, 0x2C, 0x00};
+/******************************************************************************
+function: Start sending the framebuffer to the display in the background
+parameter: none
+returns: none
+note: Only the regions touched since the last swap are sent. Returns as
+      soon as the first two chunks are converted. The remaining chunks are
+      converted and chained from the DMA IRQ, so the caller is free while
+      the panel is being written. Rows that were already sent may be drawn
+      into right away; anything drawn into rows that are still pending
+      shows up in this frame. With LCD_DUAL_CORE core1 converts the chunks
+      a few ahead of DMA instead. Waits for a previous frame first.
+******************************************************************************/
+void lcd_swap_async(void)
+{
+    lcd_swap_wait();
 
-    uint16_t line_buffer[LCD_WIDTH * LCD_CHUNK_LINES];
+    uint32_t request_us = time_us_32();
 
-    gpio_put(LCD_CS_PIN, 0);
-    pio_qspi_1bit_write_data_blocking(cmd_header, 4);
+    swap_area_count = lcd_dirty_take(swap_areas);
+    for (uint8_t i = 0; lcd_transform != 0 && i < swap_area_count; i++)
+        lcd_transform_area(&swap_areas[i], &swap_areas[i]); // streamed in panel rows
+#if LCD_TILED
+    lcd_tile_flip(); // the recorded commands become the frame to rasterize
+#endif
+    if (swap_area_count == 0)
+    {
+        // Nothing was drawn, the panel already shows the framebuffer
+        lcd_apply_brightness();
+        return;
+    }
 
-    // Send data line by line in chunks
-    for (uint16_t y = 0; y < LCD_HEIGHT; y += LCD_CHUNK_LINES)
+    swap_request_us = request_us;
+    swap_busy = true;
+#if LCD_DUAL_CORE
+    // Core1 starts converting now, in vsync mode while the frame waits for TE
+    multicore_fifo_push_blocking(swap_area_count);
+#endif
+
+    if (vsync_enabled)
     {
-        uint16_t lines_to_send = (y + LCD_CHUNK_LINES > LCD_HEIGHT) ? (LCD_HEIGHT - y) : LCD_CHUNK_LINES;
-        size_t pixels_in_chunk = LCD_WIDTH * lines_to_send;
+        // The TE IRQ picks the frame up at the next vertical blanking
+        swap_armed = true;
+        return;
+    }
+
+    lcd_swap_release();
+}
 
-        // Convert this chunk from RGB332 to RGB565 with byte swapping
-        for (size_t i = 0; i < pixels_in_chunk; i++)
+/******************************************************************************
+function: Wait for a background frame transfer to finish
+parameter: none
+returns: none
+note: In vsync mode a frame that has not seen a TE edge within
+      LCD_TE_TIMEOUT_US is started anyway, so a missing TE signal slows
+      the display down instead of hanging it.
+******************************************************************************/
+void lcd_swap_wait(void)
+{
+    while (swap_busy)
+    {
+        if (swap_armed && time_us_32() - swap_request_us > LCD_TE_TIMEOUT_US)
         {
-            uint8_t palette_index = framebuffer[y * LCD_WIDTH + i];
-            uint16_t color = palette[palette_index];
-            // Swap bytes: convert from host byte order to big-endian for display
-            line_buffer[i] = (color >> 8) | (color << 8);
+            uint32_t irq_state = save_and_disable_interrupts();
+            if (swap_armed)
+                lcd_swap_release();
+            restore_interrupts(irq_state);
         }
+        tight_loop_contents();
+    }
+}
 
-        // Send this chunk
-        pio_qspi_4bit_write_data_blocking((uint8_t *)line_buffer, pixels_in_chunk * 2);
+/******************************************************************************
+function: Check whether a background frame transfer is still running
+parameter: none
+returns: true while lcd_swap_async is streaming a frame or waiting for TE
+******************************************************************************/
+bool lcd_swap_busy(void)
+{
+    return swap_busy;
+}
+
+/******************************************************************************
+function: Enable or disable tearing effect paced swaps
+parameter:
+    enable : true to start every frame on the panel TE edge
+returns: false when the board defines no LCD_TE_PIN, vsync then stays off
+note: With vsync enabled lcd_swap_async queues the frame and the TE GPIO
+      interrupt starts the transfer at the next vertical blanking, so at
+      most one frame is sent per panel refresh and frames never tear.
+******************************************************************************/
+bool lcd_set_vsync(bool enable)
+{
+#ifdef LCD_TE_PIN
+    lcd_swap_wait();
+
+    if (enable == vsync_enabled)
+        return true;
+
+    if (enable)
+    {
+        te_count = 0;
+        te_count_last_frame = 0;
+        gpio_init(LCD_TE_PIN);
+        gpio_set_dir(LCD_TE_PIN, GPIO_IN);
+        gpio_add_raw_irq_handler(LCD_TE_PIN, te_irq_handler);
+        gpio_set_irq_enabled(LCD_TE_PIN, GPIO_IRQ_EDGE_RISE, true);
+        irq_set_enabled(IO_IRQ_BANK0, true);
     }
+    else
+    {
+        gpio_set_irq_enabled(LCD_TE_PIN, GPIO_IRQ_EDGE_RISE, false);
+        gpio_remove_raw_irq_handler(LCD_TE_PIN, te_irq_handler);
+    }
+    vsync_enabled = enable;
+    return true;
+#else
+    (void)enable;
+    return false;
+#endif
+}
 
-    // Wait for PIO state machine to finish shifting out all data
-    uint sm = pio_qspi_get_sm();
-    pio_sm_drain_tx_fifo(QSPI_PIO, sm);
-    gpio_put(LCD_CS_PIN, 1);
+/******************************************************************************
+function: Get timing information for the last completed frame
+parameter:
+    timing : Pointer to the structure to fill
+returns: none
+note: transfer_us is the wall time from lcd_swap_async to the last byte on
+      the bus, cpu_us is the part of it the CPU spent converting pixels.
+      The difference is the time handed back to the application.
+******************************************************************************/
+void lcd_get_frame_timing(LcdFrameTiming *timing)
+{
+    if (timing == NULL)
+        return;
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    *timing = frame_timing;
+    restore_interrupts(irq_state);
+}
+
+/******************************************************************************
+function: Get frame pacing statistics
+parameter:
+    stats : Pointer to the structure to fill
+returns: none
+note: dropped only counts while vsync is enabled, and only means something
+      while the application is swapping continuously: it is the number of
+      panel refreshes that showed a repeated frame between two swaps.
+******************************************************************************/
+void lcd_get_frame_stats(LcdFrameStats *stats)
+{
+    if (stats == NULL)
+        return;
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    *stats = frame_stats;
+    restore_interrupts(irq_state);
 }
 
 /******************************************************************************
@@ -838,6 +831,7 @@ note: Low-level function used internally for OLED communication
 ******************************************************************************/
 void lcd_write_cmd(uint8_t cmd)
 {
+    lcd_swap_wait();
     last_cmd = cmd;
     lcd_send_cmd_data(cmd, NULL, 0);
 }
@@ -852,6 +846,7 @@ note: Low-level function used internally for OLED communication
 ******************************************************************************/
 void lcd_write_data(uint8_t data)
 {
+    lcd_swap_wait();
     lcd_send_cmd_data(last_cmd, &data, 1);
 }
 
@@ -864,6 +859,7 @@ note: Low-level function used internally for OLED communication
 ******************************************************************************/
 void lcd_write_data_16bit(uint16_t data)
 {
+    lcd_swap_wait();
     uint8_t bytes[2] = {data >> 8, data & 0xFF};
     lcd_send_cmd_data(last_cmd, bytes, 2);
 }
@@ -158,6 +158,15 @@ void pio_qspi_4bit_write_data(uint8_t *buf, size_t len)
     dma_channel_set_read_addr(pio_qspi_dma_chan, buf, true);
 }
 
+// SM is done when it stalls on an empty FIFO
+void pio_qspi_wait_idle(void)
+{
+    uint32_t sm_stall_mask = 1u << (pio_qspi_sm + PIO_FDEBUG_TXSTALL_LSB);
+    QSPI_PIO->fdebug = sm_stall_mask;
+    while (!(QSPI_PIO->fdebug & sm_stall_mask))
+        tight_loop_contents();
+}
+
 int pio_qspi_get_dma_channel(void)
 {
     return pio_qspi_dma_chan;
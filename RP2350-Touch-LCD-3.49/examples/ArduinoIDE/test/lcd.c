@@ -1,45 +1,81 @@
-#include "lcd.h"
+#include "lcd_internal.h"
+#include "lcd_expand.h"
+#include "lcd_memset.h"
+#include <string.h>
 #include "qspi_pio.h"
 #include "hardware/dma.h"
 #include "hardware/pio.h"
+#include "hardware/irq.h"
+#if LCD_DUAL_CORE
+#include "lcd_ring.h"
+#include "pico/multicore.h"
+#endif
+
+#if LCD_TILED
+#error "LCD_TILED is not supported by this panel driver, it streams the full framebuffer"
+#endif
 
 static bool lcd_initialized = false; // flag to indicate if the LCD is initialized
 
-// Static framebuffer (16-bit per pixel for RGB565)
-static uint8_t framebuffer[LCD_WIDTH * LCD_HEIGHT];
-static uint16_t palette[256]; // 256-color palette for RGB332
 static uint8_t backlight_level;
 static uint8_t last_cmd = 0x00; // Track last command for data writes
 static bool set_brightness_flag = false;
 
-static FontTable *current_font = NULL;
-
 // DMA channel and configuration for QSPI transfers
 static int dma_tx;
 static dma_channel_config c;
 
-/******************************************************************************
- * function: Convert a 16-bit RGB565 color to an 8-bit RGB332 color
- * parameter:
- *    color : 16-bit RGB565 color value
- * returns: 8-bit RGB332 color value
- ******************************************************************************/
-static uint8_t lcd_color565_to_332(uint16_t color)
-{
-    return ((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3);
-}
-/******************************************************************************
- * function: Convert 8-bit RGB332 components to a 16-bit RGB565 color
- * parameter:
- *    r : Red component (0-255)
- *    g : Green component (0-255)
- *    b : Blue component (0-255)
- * returns: 16-bit RGB565 color value
- ******************************************************************************/
-static uint16_t lcd_color332_to_565(uint8_t r, uint8_t g, uint8_t b)
+// Vertical scroll commands not yet sent to the panel
+#define SCROLL_SEND_AREA 0x01  // 0x33, scroll area definition
+#define SCROLL_SEND_START 0x02 // 0x37, scroll start address
+
+typedef struct
 {
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-}
+    uint16_t top;    // rows fixed above the scroll area
+    uint16_t height; // rows in the scroll area
+    uint16_t offset; // ring position: screen line top shows row top + offset
+    uint8_t pending; // SCROLL_SEND_* bits
+} scroll_state_t;
+
+static scroll_state_t scroll = {0, LCD_HEIGHT, 0, 0};
+
+// Regions (in the panel frame) and scroll commands of the frame in flight
+static dirty_area_t swap_areas[LCD_MAX_DIRTY_AREAS];
+static scroll_state_t swap_scroll;
+static volatile bool swap_busy = false;
+static void lcd_dma_irq_handler(void);
+
+// Progress of the frame in flight, chained from the DMA IRQ
+static uint8_t swap_area_count;
+static uint8_t swap_area_index;
+#if !LCD_DUAL_CORE
+static const uint8_t *swap_pending_data; // prepared chunk for the next DMA transfer, NULL when none
+static size_t swap_pending_bytes;
+#endif
+#if LCD_PROFILE
+static uint32_t swap_profile_start;
+static uint32_t swap_profile_pixels;
+#endif
+
+#if LCD_COLOR_DEPTH == 16
+#define LINE_BUFFER_PIXELS LCD_WIDTH // only used to gather rotated frames
+#else
+#define LINE_BUFFER_PIXELS (LCD_WIDTH * LCD_CHUNK_LINES)
+#endif
+#if LCD_DUAL_CORE
+// Line buffers of the chunk ring: core1 expands into the free ones while
+// DMA drains the others, see lcd_ring.h
+static uint16_t line_buffers[LCD_RING_SLOTS][LINE_BUFFER_PIXELS];
+static lcd_ring_t swap_ring;
+static void lcd_core1_entry(void);
+#else
+// Region being streamed and the line buffers its chunks are prepared in
+static const dirty_area_t *stream_area;
+static uint16_t stream_chunk_lines;
+static uint16_t stream_next_y;
+static uint8_t stream_fill_buffer;
+static uint16_t line_buffers[2][LINE_BUFFER_PIXELS];
+#endif
 
 typedef struct
 {
@@ -138,6 +174,20 @@ static void set_window()
     tx_param(cmds, 2);
 }
 
+/******************************************************************************
+function: Wait until the QSPI state machine has shifted out all queued data
+parameter: none
+returns: none
+note: SM is done when it stalls on an empty FIFO
+******************************************************************************/
+static void lcd_wait_idle(void)
+{
+    uint32_t sm_stall_mask = 1u << (qspi.sm + PIO_FDEBUG_TXSTALL_LSB);
+    qspi.pio->fdebug = sm_stall_mask;
+    while (!(qspi.pio->fdebug & sm_stall_mask))
+        tight_loop_contents();
+}
+
 /******************************************************************************
 function: Send command and data to OLED using the CO5300 protocol with PIO QSPI
 parameter:
@@ -176,641 +226,569 @@ static void lcd_reset(pio_qspi_t qspi)
     sleep_ms(200);
 }
 
+/********************************************************************************
+function: Get the current backlight brightness level
+parameter: none
+returns: Brightness level from 0 (off) to 100 (full)
+********************************************************************************/
+uint8_t lcd_get_backlight_level(void)
+{
+    return backlight_level;
+}
+
+/********************************************************************************
+function: Initialize the LCD display hardware and framebuffer
+returns: none
+note: Can only be called once; subsequent calls are ignored
+********************************************************************************/
+void lcd_init()
+{
+    if (lcd_initialized)
+    {
+        return; // already initialized
+    }
+
+    // Hardware reset
+    lcd_reset(qspi);
+
+    // Initialize QSPI GPIO and PIO
+    QSPI_GPIO_Init(qspi);
+    QSPI_PIO_Init(qspi);
+    // Enable 4-wire mode for data transfers
+    QSPI_4Wrie_Mode(&qspi);
+
+    // Initialize DMA for QSPI transfers
+    dma_tx = dma_claim_unused_channel(true);
+    c = dma_channel_get_default_config(dma_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(qspi.pio, qspi.sm, false));
+    // Frames are chained from the DMA IRQ, see lcd_swap_async. DMA_IRQ_1
+    // like the fill engine, the MicroPython port owns DMA_IRQ_0.
+    dma_channel_set_irq1_enabled(dma_tx, true);
+    irq_add_shared_handler(DMA_IRQ_1, lcd_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // Send initialization commands
+    tx_param((sh8601_lcd_init_cmd_t *)lcd_init_cmds, sizeof(lcd_init_cmds) / sizeof(sh8601_lcd_init_cmd_t));
+
+    // Set initial brightness
+    uint8_t oled_brightness = 0x25 + (LCD_DEFAULT_BRIGHTNESS * (0xFF - 0x25)) / 100;
+    sh8601_lcd_init_cmd_t brightness_cmd = {.cmd = 0x51, .data = &oled_brightness, .data_bytes = 1, .delay_ms = 0};
+    tx_param(&brightness_cmd, 1);
+
+    lcd_palette_init(); // RGB332 palette, in panel byte order
+
+    lcd_set_font(LCD_DEFAULT_FONT_SIZE); // Set default font
+
+    set_window(); // Set the drawing window to full screen
+
+    lcd_memset_init(); // DMA channel for lcd_fill and lcd_fill_rect
+    lcd_invalidate(); // Panel RAM is undefined after reset, send everything once
+    lcd_profile_init(); // cycle counter for LCD_PROFILE
+
+#if LCD_DUAL_CORE
+    // Core1 expands the chunks of every frame from here on
+    multicore_launch_core1(lcd_core1_entry);
+#endif
+
+    lcd_initialized = true; // set the flag to indicate initialization is done
+}
 /******************************************************************************
-function: Draw a single pixel to the framebuffer
+function: Set the OLED display brightness
 parameter:
-    X     : X coordinate (0 to LCD_WIDTH-1)
-    Y     : Y coordinate (0 to LCD_HEIGHT-1)
-    color : RGB565 color value
+    brightness : Brightness level from 0 (off) to 100 (full)
 returns: none
 ******************************************************************************/
-void lcd_draw_pixel(uint16_t x, uint16_t y, uint16_t color)
+void lcd_set_backlight_level(uint8_t brightness)
 {
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT)
+    if (brightness > 100)
     {
-        return; // bounds check
+        brightness = 100;
     }
-    // Convert to 8-bit and store
-    framebuffer[y * LCD_WIDTH + x] = lcd_color565_to_332(color);
+
+    backlight_level = brightness;
+    set_brightness_flag = true;
 }
 
 /******************************************************************************
-function: Draw a line between two points using Bresenham's algorithm
+function: Prepare a chunk of a framebuffer region for DMA
 parameter:
-    x1    : Starting X coordinate
-    y1    : Starting Y coordinate
-    x2    : Ending X coordinate
-    y2    : Ending Y coordinate
-    color : RGB565 color value
-returns: none
+    buffer      : Line buffer to expand into
+    area        : Region being flushed, in the panel frame
+    y           : First panel row of the chunk
+    chunk_lines : Maximum number of rows in the chunk
+    bytes       : Receives the chunk size in bytes
+returns: Address DMA should read the chunk from
+note: RGB332 rows are expanded into buffer. A native RGB565 framebuffer is
+      already in panel order and is sent straight from memory. With a
+      rotation set, each panel row is gathered from a framebuffer row or
+      column into buffer instead.
 ******************************************************************************/
-void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+static const uint8_t *__not_in_flash_func(lcd_prepare_chunk)(uint16_t *buffer, const dirty_area_t *area, uint16_t y, uint16_t chunk_lines, size_t *bytes)
 {
-    int dx = abs((int)x2 - (int)x1);
-    int dy = abs((int)y2 - (int)y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-    const uint8_t color_index = lcd_color565_to_332(color);
-    while (true)
+    uint16_t area_width = area->x1 - area->x0 + 1;
+    uint16_t lines_to_send = (y + chunk_lines > area->y1 + 1) ? (area->y1 + 1 - y) : chunk_lines;
+
+    *bytes = (size_t)area_width * lines_to_send * 2;
+    LCD_PROFILE_CHARGE(LCD_PROFILE_SWAP_CONVERT, (uint32_t)area_width * lines_to_send);
+
+#if LCD_COLOR_DEPTH == 16
+    if (lcd_transform == 0)
+        return (const uint8_t *)LCD_PIXEL_AT(area->x0, y);
+#endif
+    uint16_t *dst = buffer;
+    for (uint16_t line = 0; line < lines_to_send; line++)
     {
-        // Draw pixel if within bounds
-        if (x1 < LCD_WIDTH && y1 < LCD_HEIGHT)
-        {
-            framebuffer[y1 * LCD_WIDTH + x1] = color_index;
-        }
-
-        // Check if we've reached the end point
-        if (x1 == x2 && y1 == y2)
-            break;
-
-        int e2 = 2 * err;
-        if (e2 > -dy)
-        {
-            err -= dy;
-            x1 += sx;
-        }
-        if (e2 < dx)
-        {
-            err += dx;
-            y1 += sy;
-        }
+        int step = 1;
+        const lcd_pixel_t *src = lcd_transform ? lcd_transform_row(area->x0, y + line, &step)
+                                               : LCD_PIXEL_AT(area->x0, y + line);
+#if LCD_COLOR_DEPTH == 16
+        lcd_copy_rgb565_step(dst, src, area_width, step);
+#else
+        if (step == 1)
+            lcd_expand_rgb332(dst, src, area_width, lcd_palette);
+        else
+            lcd_expand_rgb332_step(dst, src, area_width, step, lcd_palette);
+#endif
+        dst += area_width;
     }
+    return (const uint8_t *)buffer;
 }
 
 /******************************************************************************
-function: Draw a rectangle outline to the framebuffer
+function: Rows per DMA transfer for a framebuffer region
 parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of rectangle
-    height : Height of rectangle
-    color  : RGB565 color value
-returns: none
+    area : Region to stream, in the panel frame
+returns: Number of rows
 ******************************************************************************/
-void lcd_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+static uint16_t lcd_area_chunk_lines(const dirty_area_t *area)
 {
-    const uint8_t color_index = lcd_color565_to_332(color);
-    // Draw four lines to form rectangle
-    lcd_draw_line(x, y, x + width - 1, y, color_index);                           // Top
-    lcd_draw_line(x, y + height - 1, x + width - 1, y + height - 1, color_index); // Bottom
-    lcd_draw_line(x, y, x, y + height - 1, color_index);                          // Left
-    lcd_draw_line(x + width - 1, y, x + width - 1, y + height - 1, color_index);  // Right
+    uint16_t area_width = area->x1 - area->x0 + 1;
+#if LCD_COLOR_DEPTH == 16
+    // Full-width regions are contiguous in memory and go out in one
+    // transfer; rotated ones are gathered into a line buffer
+    return (lcd_transform != 0)        ? LCD_WIDTH / area_width
+           : (area_width == LCD_WIDTH) ? (area->y1 - area->y0 + 1)
+                                       : 1;
+#else
+    // Narrow regions fit more rows into one line buffer
+    return (LCD_WIDTH * LCD_CHUNK_LINES) / area_width;
+#endif
 }
 
 /******************************************************************************
-function: Draw a filled rectangle to the framebuffer
+function: Start streaming a framebuffer region to the panel
 parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of rectangle
-    height : Height of rectangle
-    color  : RGB565 color value
+    area : Region to send, in the panel frame (inclusive bounds)
 returns: none
+note: Sends the window and the pixel write command and points the DMA
+      request at the PIO. The pixels follow chunk by chunk, from
+      lcd_stream_chunk or in dual-core mode from the ring, then
+      lcd_stream_end releases the bus.
 ******************************************************************************/
-void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+static void lcd_stream_begin(const dirty_area_t *area)
 {
-    // Bounds clipping
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT)
-        return;
+#if LCD_PROFILE
+    uint16_t area_width = area->x1 - area->x0 + 1;
+    swap_profile_pixels += (uint32_t)area_width * (area->y1 - area->y0 + 1);
+#endif
+#if !LCD_DUAL_CORE
+    stream_area = area;
+    stream_chunk_lines = lcd_area_chunk_lines(area);
+    stream_next_y = area->y0;
+    stream_fill_buffer = 0;
+#endif
+
+    // Set window to the dirty region
+    QSPI_Select(qspi);
+    QSPI_REGISTER_Write(qspi, 0x2a);
+    QSPI_DATA_Write(qspi, (area->x0 + LCD_X_OFFSET) >> 8);
+    QSPI_DATA_Write(qspi, (area->x0 + LCD_X_OFFSET) & 0xff);
+    QSPI_DATA_Write(qspi, (area->x1 + LCD_X_OFFSET) >> 8);
+    QSPI_DATA_Write(qspi, (area->x1 + LCD_X_OFFSET) & 0xff);
+    QSPI_Deselect(qspi);
 
-    if (x + width > LCD_WIDTH)
-        width = LCD_WIDTH - x;
-    if (y + height > LCD_HEIGHT)
-        height = LCD_HEIGHT - y;
+    QSPI_Select(qspi);
+    QSPI_REGISTER_Write(qspi, 0x2b);
+    QSPI_DATA_Write(qspi, area->y0 >> 8);
+    QSPI_DATA_Write(qspi, area->y0 & 0xff);
+    QSPI_DATA_Write(qspi, area->y1 >> 8);
+    QSPI_DATA_Write(qspi, area->y1 & 0xff);
+    QSPI_Deselect(qspi);
 
-    const uint8_t color_index = lcd_color565_to_332(color);
+    // Start pixel write command - use QSPI_Pixel_Write like the original
+    QSPI_Select(qspi);
+    QSPI_Pixel_Write(qspi, 0x2c);
 
-    // Fast fill using optimized loops
-    for (uint16_t py = y; py < y + height; py++)
-    {
-        for (uint16_t px = x; px < x + width; px++)
-        {
-            framebuffer[py * LCD_WIDTH + px] = color_index;
-        }
-    }
+    // Configure DMA DREQ before transfer (like original)
+    channel_config_set_dreq(&c, pio_get_dreq(qspi.pio, qspi.sm, true));
 }
 
+#if !LCD_DUAL_CORE
 /******************************************************************************
-function: Draw a single character to the framebuffer
+function: Prepare the next chunk of the region being streamed
 parameter:
-    x     : Top-left X coordinate
-    y     : Top-left Y coordinate
-    c     : Character to draw
-    color : RGB565 color value
-returns: none
+    bytes : Receives the chunk size in bytes
+returns: Address DMA should read the chunk from, NULL after the last chunk
+note: Line buffers are used as a ping-pong pair: the next chunk is expanded
+      while DMA is still sending the previous one, so conversion and
+      transfer overlap. With LCD_COLOR_DEPTH 16 there is nothing to expand
+      and DMA reads the framebuffer directly, unless the display is
+      rotated.
 ******************************************************************************/
-void lcd_draw_char(uint16_t x, uint16_t y, char c, uint16_t color)
+static const uint8_t *__not_in_flash_func(lcd_stream_chunk)(size_t *bytes)
 {
-    if (current_font == NULL || c < 32 || c > 126)
-        return; // invalid font or character
-
-    // Calculate bytes per row (width rounded up to nearest byte boundary)
-    uint8_t bytes_per_row = (current_font->width + 7) / 8;
-    const uint8_t *char_data = &current_font->table[(c - 32) * current_font->height * bytes_per_row];
-
-    for (uint8_t row = 0; row < current_font->height; row++)
-    {
-        const uint8_t *row_data = &char_data[row * bytes_per_row];
-
-        for (uint8_t col = 0; col < current_font->width; col++)
-        {
-            uint8_t byte_index = col / 8;
-            uint8_t bit_index = 7 - (col % 8);
-
-            if (row_data[byte_index] & (1 << bit_index))
-            {
-                lcd_draw_pixel(x + col, y + row, color);
-            }
-        }
-    }
+    if (stream_next_y > stream_area->y1)
+        return NULL;
+
+    const uint8_t *data = lcd_prepare_chunk(line_buffers[stream_fill_buffer], stream_area, stream_next_y,
+                                            stream_chunk_lines, bytes);
+    stream_fill_buffer ^= 1;
+    stream_next_y += stream_chunk_lines;
+    return data;
 }
+#endif
 
 /******************************************************************************
-function: Draw a circle outline to the framebuffer
+function: Hand a chunk to DMA
 parameter:
-    center_x : Center X coordinate
-    center_y : Center Y coordinate
-    radius   : Radius in pixels
-    color    : RGB565 color value
+    data  : Chunk from lcd_stream_chunk or the ring
+    bytes : Its size in bytes
 returns: none
 ******************************************************************************/
-void lcd_draw_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+static void __not_in_flash_func(lcd_stream_send)(const uint8_t *data, size_t bytes)
 {
-    if (radius == 0 || radius > 100)
-        return;
+    dma_channel_configure(dma_tx,
+                          &c,
+                          &qspi.pio->txf[qspi.sm],
+                          data,
+                          bytes,
+                          true);
+}
 
-    int x = 0;
-    int y = radius;
-    int d = 3 - 2 * radius;
-    const uint8_t color_index = lcd_color565_to_332(color);
+/******************************************************************************
+function: Finish the region being streamed
+parameter: none
+returns: none
+note: Call once DMA has sent the last chunk. Deselects only after all data
+      has left the PIO, the next region starts with a command right away.
+******************************************************************************/
+static void __not_in_flash_func(lcd_stream_end)(void)
+{
+    lcd_wait_idle();
+    QSPI_Deselect(qspi);
+}
 
-    while (x <= y)
+/******************************************************************************
+function: Send pending vertical scroll commands
+parameter:
+    state : Scroll state captured with the frame
+returns: none
+note: Runs after the frame's regions are on the panel, so newly exposed
+      rows already hold their new content when the start address moves.
+******************************************************************************/
+static void lcd_flush_scroll(const scroll_state_t *state)
+{
+    if (state->pending & SCROLL_SEND_AREA)
     {
-        // Draw 8 symmetric points
-        if (center_x + x < LCD_WIDTH && center_y + y < LCD_HEIGHT)
-            framebuffer[(center_y + y) * LCD_WIDTH + (center_x + x)] = color_index;
-        if (center_x - x < LCD_WIDTH && center_y + y < LCD_HEIGHT)
-            framebuffer[(center_y + y) * LCD_WIDTH + (center_x - x)] = color_index;
-        if (center_x + x < LCD_WIDTH && center_y - y < LCD_HEIGHT)
-            framebuffer[(center_y - y) * LCD_WIDTH + (center_x + x)] = color_index;
-        if (center_x - x < LCD_WIDTH && center_y - y < LCD_HEIGHT)
-            framebuffer[(center_y - y) * LCD_WIDTH + (center_x - x)] = color_index;
-        if (center_x + y < LCD_WIDTH && center_y + x < LCD_HEIGHT)
-            framebuffer[(center_y + x) * LCD_WIDTH + (center_x + y)] = color_index;
-        if (center_x - y < LCD_WIDTH && center_y + x < LCD_HEIGHT)
-            framebuffer[(center_y + x) * LCD_WIDTH + (center_x - y)] = color_index;
-        if (center_x + y < LCD_WIDTH && center_y - x < LCD_HEIGHT)
-            framebuffer[(center_y - x) * LCD_WIDTH + (center_x + y)] = color_index;
-        if (center_x - y < LCD_WIDTH && center_y - x < LCD_HEIGHT)
-            framebuffer[(center_y - x) * LCD_WIDTH + (center_x - y)] = color_index;
-
-        if (d < 0)
-            d += 4 * x + 6;
-        else
-        {
-            d += 4 * (x - y) + 10;
-            y--;
-        }
-        x++;
+        uint16_t bottom = LCD_HEIGHT - state->top - state->height;
+        uint8_t data[6] = {state->top >> 8, state->top & 0xFF, state->height >> 8, state->height & 0xFF,
+                           bottom >> 8, bottom & 0xFF};
+        lcd_send_cmd_data(0x33, data, sizeof(data));
+    }
+    if (state->pending & SCROLL_SEND_START)
+    {
+        uint16_t start = state->top + state->offset;
+        uint8_t data[2] = {start >> 8, start & 0xFF};
+        lcd_send_cmd_data(0x37, data, sizeof(data));
     }
 }
 
-void lcd_draw_text(uint16_t x, uint16_t y, const char *text, uint16_t color)
+#if LCD_DUAL_CORE
+/******************************************************************************
+function: Core1 expansion loop
+parameter: none
+returns: none
+note: Waits for a region count from core0 on the inter-core FIFO and expands
+      swap_areas chunk by chunk into the ring, then publishes the end of the
+      frame. Core0's DMA IRQ sends the chunks, see lcd_ring.h.
+******************************************************************************/
+static void lcd_core1_entry(void)
 {
-    if (current_font == NULL)
-        return; // invalid font
-
-    uint16_t cursor_x = x;
-    uint16_t cursor_y = y;
-
-    while (*text)
+    lcd_profile_init(); // cycle counter of core1, which converts the frames
+    while (true)
     {
-        char ch = *text;
-
-        if (ch == '\n')
-        {
-            cursor_x = x;                     // Reset to start of line
-            cursor_y += current_font->height; // Move down one line
-        }
-        else if (ch == ' ')
-        {
-            // Handle space - just advance position without drawing
-            cursor_x += current_font->width;
-        }
-        else
+        uint8_t area_count = (uint8_t)multicore_fifo_pop_blocking();
+        for (uint8_t n = 0; n < area_count; n++)
         {
-            // Check if character would exceed screen width
-            if (cursor_x + current_font->width > LCD_WIDTH)
-            {
-                // Wrap to next line
-                cursor_x = x;
-                cursor_y += current_font->height;
-            }
-
-            // Check if we're still within screen height
-            if (cursor_y + current_font->height <= LCD_HEIGHT)
+            const dirty_area_t *area = &swap_areas[n];
+            uint16_t chunk_lines = lcd_area_chunk_lines(area);
+            for (uint16_t y = area->y0; y <= area->y1; y += chunk_lines)
             {
-                lcd_draw_char(cursor_x, cursor_y, ch, color);
+                size_t bytes;
+                uint32_t slot = lcd_ring_acquire(&swap_ring);
+                const uint8_t *data = lcd_prepare_chunk(line_buffers[slot], area, y, chunk_lines, &bytes);
+                lcd_ring_publish(&swap_ring, data, bytes, n);
             }
-
-            cursor_x += current_font->width;
         }
-        text++;
+        lcd_ring_acquire(&swap_ring);
+        lcd_ring_publish(&swap_ring, NULL, 0, area_count);
     }
 }
+#endif
 
 /******************************************************************************
-function: Draw a filled circle to the framebuffer
-parameter:
-    center_x : Center X coordinate
-    center_y : Center Y coordinate
-    radius   : Radius in pixels
-    color    : RGB565 color value
+function: Start streaming the current region of the frame in flight
+parameter: none
 returns: none
+note: Prepares the first two chunks and kicks the first DMA transfer, or in
+      dual-core mode sends the first chunk core1 published. The rest of the
+      region is chained from the DMA IRQ.
 ******************************************************************************/
-void lcd_fill_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color)
+static void lcd_swap_start_area(void)
 {
-    if (radius == 0 || radius > 100)
-        return;
-
-    const uint8_t color_index = lcd_color565_to_332(color);
-
-    int radius_squared = radius * radius;
-
-    // Calculate bounding box
-    int start_x = (center_x > radius) ? (center_x - radius) : 0;
-    int end_x = (center_x + radius < LCD_WIDTH) ? (center_x + radius) : (LCD_WIDTH - 1);
-    int start_y = (center_y > radius) ? (center_y - radius) : 0;
-    int end_y = (center_y + radius < LCD_HEIGHT) ? (center_y + radius) : (LCD_HEIGHT - 1);
-
-    // Fill using distance check
-    for (int y = start_y; y <= end_y; y++)
-    {
-        int dy = y - center_y;
-        int dy_squared = dy * dy;
-
-        for (int x = start_x; x <= end_x; x++)
-        {
-            int dx = x - center_x;
-            int distance_squared = dx * dx + dy_squared;
-
-            if (distance_squared <= radius_squared)
-            {
-                framebuffer[y * LCD_WIDTH + x] = color_index;
-            }
-        }
-    }
+    lcd_stream_begin(&swap_areas[swap_area_index]);
+
+#if LCD_DUAL_CORE
+    // Core1 started expanding at lcd_swap_async, the chunk is usually ready
+    const lcd_ring_slot_t *slot = lcd_ring_peek(&swap_ring);
+    lcd_stream_send(slot->data, slot->size);
+#else
+    // Prepare two chunks before DMA starts so the IRQ never waits on us
+    size_t first_bytes;
+    const uint8_t *first_data = lcd_stream_chunk(&first_bytes);
+    swap_pending_data = lcd_stream_chunk(&swap_pending_bytes);
+    lcd_stream_send(first_data, first_bytes);
+#endif
 }
 
 /******************************************************************************
-function: Draw a filled triangle to the framebuffer
-parameter:
-    x1, y1 : First vertex coordinates
-    x2, y2 : Second vertex coordinates
-    x3, y3 : Third vertex coordinates
-    color  : RGB565 color value
+function: DMA completion handler for the frame transfer
+parameter: none
 returns: none
+note: Hands the already prepared chunk to DMA and prepares the one after it,
+      or in dual-core mode releases the chunk DMA just read and sends the
+      next one core1 published. Once a region is done it waits for the PIO
+      to shift out the last pixels and moves on to the next region, or
+      sends the scroll commands and ends the frame.
 ******************************************************************************/
-void lcd_fill_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t color)
+static void __no_inline_not_in_flash_func(lcd_dma_irq_handler)(void)
 {
-    // Sort vertices by Y coordinate (y1 <= y2 <= y3)
-    if (y1 > y2)
-    {
-        uint16_t temp = x1;
-        x1 = x2;
-        x2 = temp;
-        temp = y1;
-        y1 = y2;
-        y2 = temp;
-    }
-    if (y2 > y3)
+    if (!dma_channel_get_irq1_status(dma_tx))
+        return;
+    dma_channel_acknowledge_irq1(dma_tx);
+
+    if (!swap_busy)
+        return;
+
+#if LCD_DUAL_CORE
+    lcd_ring_release(&swap_ring);
+    const lcd_ring_slot_t *slot = lcd_ring_peek(&swap_ring);
+    if (slot->area == swap_area_index)
     {
-        uint16_t temp = x2;
-        x2 = x3;
-        x3 = temp;
-        temp = y2;
-        y2 = y3;
-        y3 = temp;
+        lcd_stream_send(slot->data, slot->size);
+        return;
     }
-    if (y1 > y2)
+#else
+    if (swap_pending_data != NULL)
     {
-        uint16_t temp = x1;
-        x1 = x2;
-        x2 = temp;
-        temp = y1;
-        y1 = y2;
-        y2 = temp;
-    }
-
-    // Handle degenerate case
-    if (y1 == y3)
+        // Keep the bus busy first, then refill the line buffer DMA just released
+        lcd_stream_send(swap_pending_data, swap_pending_bytes);
+        swap_pending_data = lcd_stream_chunk(&swap_pending_bytes);
         return;
+    }
+#endif
 
-    const uint8_t color_index = lcd_color565_to_332(color);
+    // DMA only filled the FIFO, the last pixels are still being shifted out
+    lcd_stream_end();
 
-    // Fill the triangle using horizontal scanlines
-    for (uint16_t y = y1; y <= y3; y++)
+    if (swap_area_index + 1 < swap_area_count)
     {
-        if (y >= LCD_HEIGHT)
-            break;
-
-        int x_left, x_right;
-        bool has_intersection = false;
-
-        // Find left edge intersection
-        if (y3 != y1)
-        {
-            x_left = x1 + (int)((x3 - x1) * (int)(y - y1)) / (int)(y3 - y1);
-            has_intersection = true;
-        }
-
-        // Find right edge intersection
-        if (y <= y2 && y2 != y1)
-        {
-            x_right = x1 + (int)((x2 - x1) * (int)(y - y1)) / (int)(y2 - y1);
-        }
-        else if (y > y2 && y3 != y2)
-        {
-            x_right = x2 + (int)((x3 - x2) * (int)(y - y2)) / (int)(y3 - y2);
-        }
-        else
-        {
-            x_right = x_left;
-        }
-
-        if (!has_intersection)
-            continue;
-
-        // Ensure x_left <= x_right
-        if (x_left > x_right)
-        {
-            int temp = x_left;
-            x_left = x_right;
-            x_right = temp;
-        }
-
-        // Clamp to screen bounds
-        if (x_left < 0)
-            x_left = 0;
-        if (x_right >= LCD_WIDTH)
-            x_right = LCD_WIDTH - 1;
-
-        // Draw horizontal line
-        for (int x = x_left; x <= x_right; x++)
-        {
-            framebuffer[y * LCD_WIDTH + x] = color_index;
-        }
+        swap_area_index++;
+        lcd_swap_start_area();
+        return;
     }
+
+#if LCD_DUAL_CORE
+    lcd_ring_release(&swap_ring); // end of the frame
+#endif
+    lcd_flush_scroll(&swap_scroll);
+#if LCD_PROFILE
+    lcd_profile_count(LCD_PROFILE_SWAP_TRANSFER, lcd_profile_now() - swap_profile_start, swap_profile_pixels);
+#endif
+    swap_busy = false;
 }
 
 /******************************************************************************
-function: Fill the entire framebuffer with a solid color
-parameter:
-    color : RGB565 color value to fill with
+function: Send the framebuffer contents to the physical display
+parameter: none
 returns: none
+note: Call this after drawing operations to update the screen. This is the
+      only function that actually writes to the display hardware, preventing
+      screen tearing and ensuring atomic frame updates. Only the regions
+      touched since the last swap are sent.
 ******************************************************************************/
-void lcd_fill(uint16_t color)
+void lcd_swap(void)
 {
-    const uint8_t color_index = lcd_color565_to_332(color);
-    for (uint32_t i = 0; i < LCD_HEIGHT * LCD_WIDTH; i++)
-    {
-        framebuffer[i] = color_index;
-    }
+    lcd_swap_async();
+    lcd_swap_wait();
 }
 
 /******************************************************************************
-function: Copy an external image buffer into the framebuffer at specified position
-parameter:
-    x      : Top-left X coordinate
-    y      : Top-left Y coordinate
-    width  : Width of the buffer to blit
-    height : Height of the buffer to blit
-    buffer : Pointer to RGB332 pixel data array (8-bit per pixel)
+function: Start sending the framebuffer to the display
+parameter: none
 returns: none
+note: Returns right away; the caller may keep working while the panel is
+      written, but anything drawn before lcd_swap_wait() returns may or may
+      not make it into this frame. The first two chunks are prepared here
+      and the DMA IRQ handles the rest; with LCD_DUAL_CORE enabled core1
+      expands the chunks instead. Waits for a previous frame first.
 ******************************************************************************/
-void lcd_blit(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *buffer)
+void lcd_swap_async(void)
 {
-    for (uint16_t j = 0; j < height; j++)
+    lcd_swap_wait();
+
+    uint8_t area_count = lcd_dirty_take(swap_areas);
+    if (area_count == 0 && scroll.pending == 0)
+        return;
+
+    // The panel scans in its own orientation, see lcd_panel_orient
+    for (uint8_t i = 0; lcd_transform != 0 && i < area_count; i++)
+        lcd_transform_area(&swap_areas[i], &swap_areas[i]);
+
+    swap_scroll = scroll;
+    scroll.pending = 0;
+    if (area_count == 0)
     {
-        for (uint16_t i = 0; i < width; i++)
-        {
-            if ((x + i) < LCD_WIDTH && (y + j) < LCD_HEIGHT)
-            {
-                framebuffer[(y + j) * LCD_WIDTH + (x + i)] = buffer[j * width + i];
-            }
-        }
+        lcd_flush_scroll(&swap_scroll); // only the start address moves
+        return;
     }
+
+    swap_area_count = area_count;
+    swap_area_index = 0;
+    swap_busy = true;
+#if LCD_PROFILE
+    swap_profile_start = lcd_profile_now();
+    swap_profile_pixels = 0;
+#endif
+#if LCD_DUAL_CORE
+    multicore_fifo_push_blocking(area_count); // core1 starts expanding
+#endif
+    lcd_swap_start_area();
 }
 
-/********************************************************************************
-function: Get the current backlight brightness level
+/******************************************************************************
+function: Wait for a background frame transfer to finish
 parameter: none
-returns: Brightness level from 0 (off) to 100 (full)
-********************************************************************************/
-uint8_t lcd_get_backlight_level(void)
+returns: none
+******************************************************************************/
+void lcd_swap_wait(void)
 {
-    return backlight_level;
+    while (swap_busy)
+        tight_loop_contents();
 }
 
-/********************************************************************************
-function: Get the current font height
+/******************************************************************************
+function: Check whether a frame transfer is still in progress
 parameter: none
-returns: Font height in pixels
-********************************************************************************/
-uint8_t lcd_get_font_height(void)
+returns: true while the panel is being written
+******************************************************************************/
+bool lcd_swap_busy(void)
 {
-    if (current_font != NULL)
-    {
-        return current_font->height;
-    }
-    return 0;
+    return swap_busy;
 }
 
-/********************************************************************************
-function: Get the current font width
-parameter: none
-returns: Font width in pixels
-********************************************************************************/
-uint8_t lcd_get_font_width(void)
+/******************************************************************************
+function: Apply a display orientation (called by lcd_set_rotation)
+parameter:
+    transform : LCD_SWAP_XY, LCD_FLIP_X and LCD_FLIP_Y bits
+returns: true, every orientation is supported
+note: The panel keeps scanning in its native orientation and
+      lcd_prepare_chunk reads the framebuffer in the matching order. The
+      hardware scroll moves panel rows, which are framebuffer columns or
+      reversed rows once rotated, so it is reset here and only available at
+      rotation 0.
+******************************************************************************/
+bool lcd_panel_orient(uint8_t transform)
 {
-    if (current_font != NULL)
-    {
-        return current_font->width;
-    }
-    return 0;
+    (void)transform;
+    scroll = (scroll_state_t){0, LCD_HEIGHT, 0, SCROLL_SEND_AREA | SCROLL_SEND_START};
+    return true;
 }
 
-/********************************************************************************
-function: Initialize the LCD display hardware and framebuffer
+/******************************************************************************
+function: Define the vertically scrolling part of the screen
+parameter:
+    top_fixed    : Rows at the top that never scroll
+    bottom_fixed : Rows at the bottom that never scroll
 returns: none
-note: Can only be called once; subsequent calls are ignored
-********************************************************************************/
-void lcd_init()
+note: The rows in between scroll as a ring through the framebuffer, see
+      lcd_scroll_row. Resets the scroll position, so every row shows its own
+      framebuffer row again. Sent to the controller (0x33, 0x37) with the
+      next lcd_swap. Ignored when the fixed areas leave no rows to scroll,
+      and while the display is rotated or mirrored.
+******************************************************************************/
+void lcd_scroll_area(uint16_t top_fixed, uint16_t bottom_fixed)
 {
-    if (lcd_initialized)
-    {
-        return; // already initialized
-    }
-
-    // Hardware reset
-    lcd_reset(qspi);
-
-    // Initialize QSPI GPIO and PIO
-    QSPI_GPIO_Init(qspi);
-    QSPI_PIO_Init(qspi);
-    // Enable 4-wire mode for data transfers
-    QSPI_4Wrie_Mode(&qspi);
-
-    // Initialize DMA for QSPI transfers
-    dma_tx = dma_claim_unused_channel(true);
-    c = dma_channel_get_default_config(dma_tx);
-    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
-    channel_config_set_read_increment(&c, true);
-    channel_config_set_write_increment(&c, false);
-    channel_config_set_dreq(&c, pio_get_dreq(qspi.pio, qspi.sm, false));
-    irq_set_enabled(DMA_IRQ_0, false);
-
-    // Send initialization commands
-    tx_param((sh8601_lcd_init_cmd_t *)lcd_init_cmds, sizeof(lcd_init_cmds) / sizeof(sh8601_lcd_init_cmd_t));
-
-    // Set initial brightness
-    uint8_t oled_brightness = 0x25 + (LCD_DEFAULT_BRIGHTNESS * (0xFF - 0x25)) / 100;
-    sh8601_lcd_init_cmd_t brightness_cmd = {.cmd = 0x51, .data = &oled_brightness, .data_bytes = 1, .delay_ms = 0};
-    tx_param(&brightness_cmd, 1);
-
-    // init palette
-    for (int i = 0; i < 256; i++)
-    {
-        // Extract RGB332 components
-        uint8_t r3 = (i >> 5) & 0x07; // 3 bits for red
-        uint8_t g3 = (i >> 2) & 0x07; // 3 bits for green
-        uint8_t b2 = i & 0x03;        // 2 bits for blue
-
-        // Convert to 8-bit RGB
-        uint8_t r8 = (r3 * 255) / 7; // Scale 3-bit to 8-bit
-        uint8_t g8 = (g3 * 255) / 7; // Scale 3-bit to 8-bit
-        uint8_t b8 = (b2 * 255) / 3; // Scale 2-bit to 8-bit
-
-        // Convert to RGB565 for the palette
-        palette[i] = lcd_color332_to_565(r8, g8, b8);
-    }
-
-    lcd_set_font(LCD_DEFAULT_FONT_SIZE); // Set default font
-
-    set_window(); // Set the drawing window to full screen
-
-    lcd_initialized = true; // set the flag to indicate initialization is done
+    if (lcd_transform != 0 || top_fixed + bottom_fixed >= LCD_HEIGHT)
+        return;
+    scroll.top = top_fixed;
+    scroll.height = LCD_HEIGHT - top_fixed - bottom_fixed;
+    scroll.offset = 0;
+    scroll.pending |= SCROLL_SEND_AREA | SCROLL_SEND_START;
 }
+
 /******************************************************************************
-function: Set the OLED display brightness
+function: Scroll the scroll area by a number of rows
 parameter:
-    brightness : Brightness level from 0 (off) to 100 (full)
+    lines      : Rows to move the content up, negative to move it down
+    fill_color : RGB565 color the newly exposed rows are cleared to
 returns: none
+note: Only the start address changes on the panel (0x37, a few bytes), the
+      framebuffer is not moved. The exposed rows, at the bottom when
+      scrolling up and at the top when scrolling down, are cleared and
+      marked dirty; draw into them through lcd_scroll_row. The next
+      lcd_swap sends those rows first and then moves the start address.
+      Ignored while the display is rotated or mirrored.
 ******************************************************************************/
-void lcd_set_backlight_level(uint8_t brightness)
+void lcd_scroll(int16_t lines, uint16_t fill_color)
 {
-    if (brightness > 100)
-    {
-        brightness = 100;
-    }
-
-    backlight_level = brightness;
-    set_brightness_flag = true;
-}
+    const int height = scroll.height;
+    if (lines == 0 || lcd_transform != 0)
+        return;
 
-void lcd_set_font(FontSize size)
-{
-    switch (size)
-    {
-    case FONT_XTRA_SMALL:
-        current_font = (FontTable *)&Font8;
-        break;
-    case FONT_SMALL:
-        current_font = (FontTable *)&Font12;
-        break;
-    case FONT_MEDIUM:
-        current_font = (FontTable *)&Font16;
-        break;
-    case FONT_LARGE:
-        current_font = (FontTable *)&Font20;
-        break;
-    case FONT_XTRA_LARGE:
-        current_font = (FontTable *)&Font24;
-        break;
-    default:
-        current_font = (FontTable *)&Font16; // Default to medium if invalid size
-        break;
-    }
+    int exposed = lines > 0 ? lines : -lines;
+    if (exposed > height)
+        exposed = height;
+    scroll.offset = ((scroll.offset + lines) % height + height) % height;
+    scroll.pending |= SCROLL_SEND_START;
+
+    // Exposed screen lines, relative to the area, and where they sit in the ring
+    int first_line = lines > 0 ? height - exposed : 0;
+    int ring_row = (scroll.offset + first_line) % height;
+    int run = exposed < height - ring_row ? exposed : height - ring_row;
+    lcd_fill_rect(0, scroll.top + ring_row, LCD_WIDTH, run, fill_color);
+    if (run < exposed)
+        lcd_fill_rect(0, scroll.top, LCD_WIDTH, exposed - run, fill_color);
 }
 
 /******************************************************************************
-function: Send the framebuffer contents to the physical display
-parameter: none
-returns: none
-note: Call this after drawing operations to update the screen. This is the
-      only function that actually writes to the display hardware, preventing
-      screen tearing and ensuring atomic frame updates.
+function: Get the framebuffer row shown at a screen line
+parameter:
+    line : Screen line, 0 at the top
+returns: Framebuffer row to draw into for that line
+note: Lines in the fixed areas map to themselves. Content taller than one
+      row may wrap from the last row of the scroll area to its first. For a
+      log, make the scroll area a multiple of the text line height and
+      scroll by whole lines, then a line never wraps.
 ******************************************************************************/
-void lcd_swap(void)
+uint16_t lcd_scroll_row(uint16_t line)
 {
-    // Set window to full screen
-    QSPI_Select(qspi);
-    QSPI_REGISTER_Write(qspi, 0x2a);
-    QSPI_DATA_Write(qspi, LCD_X_OFFSET >> 8);
-    QSPI_DATA_Write(qspi, LCD_X_OFFSET & 0xff);
-    QSPI_DATA_Write(qspi, (LCD_WIDTH + LCD_X_OFFSET - 1) >> 8);
-    QSPI_DATA_Write(qspi, (LCD_WIDTH + LCD_X_OFFSET - 1) & 0xff);
-    QSPI_Deselect(qspi);
-
-    QSPI_Select(qspi);
-    QSPI_REGISTER_Write(qspi, 0x2b);
-    QSPI_DATA_Write(qspi, 0);
-    QSPI_DATA_Write(qspi, 0);
-    QSPI_DATA_Write(qspi, (LCD_HEIGHT - 1) >> 8);
-    QSPI_DATA_Write(qspi, (LCD_HEIGHT - 1) & 0xff);
-    QSPI_Deselect(qspi);
-
-    // Start pixel write command - use QSPI_Pixel_Write like the original
-    QSPI_Select(qspi);
-    QSPI_Pixel_Write(qspi, 0x2c);
-
-    // Convert framebuffer from RGB332 to RGB565 and send via DMA
-    // Configure DMA DREQ before transfer (like original)
-    channel_config_set_dreq(&c, pio_get_dreq(qspi.pio, qspi.sm, true));
-
-    for (uint16_t y = 0; y < LCD_HEIGHT; y += LCD_CHUNK_LINES)
-    {
-        uint16_t lines_to_send = (y + LCD_CHUNK_LINES > LCD_HEIGHT) ? (LCD_HEIGHT - y) : LCD_CHUNK_LINES;
-        size_t pixels_in_chunk = LCD_WIDTH * lines_to_send;
-
-        // Static buffer for converted data
-        static uint16_t line_buffer[LCD_WIDTH * LCD_CHUNK_LINES];
-
-        // Convert this chunk from RGB332 to RGB565 with byte swapping
-        for (size_t i = 0; i < pixels_in_chunk; i++)
-        {
-            uint8_t palette_index = framebuffer[y * LCD_WIDTH + i];
-            uint16_t color = palette[palette_index];
-            // Swap bytes: convert from host byte order to big-endian for display
-            line_buffer[i] = (color >> 8) | (color << 8);
-        }
-
-        // Send this chunk via DMA
-        dma_channel_configure(dma_tx,
-                              &c,
-                              &qspi.pio->txf[qspi.sm],
-                              (uint8_t *)line_buffer,
-                              pixels_in_chunk * 2,
-                              true);
-
-        // Wait for DMA to complete before next chunk
-        while (dma_channel_is_busy(dma_tx))
-            ;
-    }
-
-    // Deselect only after all data is sent
-    QSPI_Deselect(qspi);
+    if (line < scroll.top || line >= scroll.top + scroll.height)
+        return line;
+    return scroll.top + (scroll.offset + line - scroll.top) % scroll.height;
 }
 
 /******************************************************************************
@@ -822,6 +800,7 @@ note: Low-level function used internally for OLED communication
 ******************************************************************************/
 void lcd_write_cmd(uint8_t cmd)
 {
+    lcd_swap_wait();
     last_cmd = cmd;
     lcd_send_cmd_data(cmd, NULL, 0);
 }
@@ -836,6 +815,7 @@ note: Low-level function used internally for OLED communication
 ******************************************************************************/
 void lcd_write_data(uint8_t data)
 {
+    lcd_swap_wait();
     lcd_send_cmd_data(last_cmd, &data, 1);
 }
 
@@ -848,6 +828,7 @@ note: Low-level function used internally for OLED communication
 ******************************************************************************/
 void lcd_write_data_16bit(uint16_t data)
 {
+    lcd_swap_wait();
     uint8_t bytes[2] = {data >> 8, data & 0xFF};
     lcd_send_cmd_data(last_cmd, bytes, 2);
 }
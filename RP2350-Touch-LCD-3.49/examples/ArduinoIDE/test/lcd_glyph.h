@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+#include "fonts.h"
+
+// 1 = keep the decoded row masks of every glyph drawn, ~30 KB of RAM for all
+// five fonts. 0 = decode the font table on every glyph.
+#ifndef LCD_GLYPH_CACHE
+#define LCD_GLYPH_CACHE 0
+#endif
+
+#define LCD_GLYPH_MAX_WIDTH 32  // one row mask is a 32-bit word
+#define LCD_GLYPH_MAX_HEIGHT 32 // rows in a decoded glyph
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Row masks of one printable ASCII glyph, bit 31 is the leftmost column.
+    // Returns the cache entry or the rows decoded into scratch
+    // (LCD_GLYPH_MAX_HEIGHT entries), NULL when the glyph does not exist.
+    const uint32_t *lcd_glyph_rows(const FontTable *font, char c, uint32_t *scratch);
+
+    // Draw the set pixels of a glyph into a width x height pixel buffer,
+    // clipped to its bounds. x/y may be negative.
+    void lcd_glyph_draw8(uint8_t *dst, uint16_t width, uint16_t height, int x, int y,
+                         const FontTable *font, char c, uint8_t pixel);
+    void lcd_glyph_draw16(uint16_t *dst, uint16_t width, uint16_t height, int x, int y,
+                          const FontTable *font, char c, uint16_t pixel);
+
+#ifdef __cplusplus
+}
+#endif
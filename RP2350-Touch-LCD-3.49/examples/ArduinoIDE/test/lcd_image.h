@@ -0,0 +1,55 @@
+// Compressed RGB332 images, decoded straight into the framebuffer.
+//
+// Container, all values little-endian:
+//   0  'L' 'I'   magic
+//   2  format    LCD_IMAGE_RAW, LCD_IMAGE_RLE or LCD_IMAGE_LZ
+//   3  0         reserved
+//   4  width     uint16
+//   6  height    uint16
+//   8  payload   width * height RGB332 pixels, row-major, encoded per format
+//
+// RLE payload, a sequence of:
+//   0x00-0x7F n  then n + 1 literal pixels
+//   0x80-0xFF n  then one pixel repeated (n & 0x7F) + 2 times
+//
+// LZ payload, a sequence of:
+//   token        high nibble: literal count, low nibble: match length - 3
+//   [extra]      if a nibble is 15, bytes added to it until one is not 255
+//   literals     literal pixels
+//   offset       uint16, distance back in pixels to copy the match from
+// The last sequence stops after its literals once all pixels are produced.
+//
+// Runs, literals and matches may cross row ends. Build images with
+// RP2350-Touch-LCD-3.49/tools/host/image_encode.py.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "lcd_sprite.h"
+
+#define LCD_IMAGE_HEADER_SIZE 8
+
+#define LCD_IMAGE_RAW 0 // Uncompressed pixels
+#define LCD_IMAGE_RLE 1 // Run-length, for flat UI art
+#define LCD_IMAGE_LZ 2  // LZ77 over the pixels, for photos and gradients
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Read the size of an image, false when the header is not valid
+    bool lcd_image_info(const uint8_t *data, size_t size, uint16_t *width, uint16_t *height);
+
+    // Decode an image into the framebuffer with its top-left pixel at (x, y).
+    // flags: LCD_BLIT_TRANSPARENT skips COLOR_TRANSPARENT pixels (raw and
+    // RLE only). Raw and RLE images are clipped to the screen; LZ images
+    // copy matches back out of the framebuffer, so they must fit on screen
+    // and cannot be drawn in tiled mode (LCD_TILED).
+    // Returns false for invalid or truncated data, or an LZ image that does
+    // not fit; pixels decoded up to that point stay drawn.
+    bool lcd_draw_image(int16_t x, int16_t y, const uint8_t *data, size_t size, uint8_t flags);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,29 @@
+#include "lcd_internal.h"
+
+uint16_t lcd_palette[256]; // 256-color palette for RGB332, in panel byte order
+
+/******************************************************************************
+function: Fill the RGB332 palette
+parameter: none
+returns: none
+note: Called by lcd_init. The entries are RGB565 in the byte order of the
+      panel (see LCD_PIXEL_BYTE_SWAP), ready to be sent or stored in a
+      16-bit framebuffer.
+******************************************************************************/
+void lcd_palette_init(void)
+{
+    for (int i = 0; i < 256; i++)
+    {
+        // Extract RGB332 components
+        uint8_t r3 = (i >> 5) & 0x07; // 3 bits for red
+        uint8_t g3 = (i >> 2) & 0x07; // 3 bits for green
+        uint8_t b2 = i & 0x03;        // 2 bits for blue
+
+        // Convert to 8-bit RGB
+        uint8_t r8 = (r3 * 255) / 7; // Scale 3-bit to 8-bit
+        uint8_t g8 = (g3 * 255) / 7; // Scale 3-bit to 8-bit
+        uint8_t b8 = (b2 * 255) / 3; // Scale 2-bit to 8-bit
+
+        lcd_palette[i] = lcd_color_to_panel(lcd_color332_to_565(r8, g8, b8));
+    }
+}
@@ -0,0 +1,341 @@
+#include "lcd_tile.h"
+#include "lcd_internal.h"
+#include "lcd_blend.h"
+#include "lcd_font.h"
+#include "lcd_image.h"
+#include "lcd_memset.h"
+#include "lcd_sprite.h"
+#include <string.h>
+
+#if LCD_TILED
+
+lcd_pixel_t lcd_band[LCD_WIDTH * LCD_TILE_LINES];
+int lcd_band_top = 0;
+int lcd_band_bottom = 0;
+bool lcd_tile_replaying = false;
+
+// One recorded drawing call. Commands are packed back to back in drawing
+// order, each padded to the alignment of its arguments.
+typedef struct
+{
+    uint16_t size;          // bytes of the whole command, header, arguments and data
+    uint8_t op;             // LCD_TILE_*
+    uint8_t arg_count;      // entries in args, the data follows them
+    dirty_area_t box;       // screen pixels the call may touch, clipped (inclusive)
+    intptr_t args[];
+} tile_command_t;
+
+typedef struct
+{
+    intptr_t commands[LCD_TILE_LIST_BYTES / sizeof(intptr_t)];
+    uint32_t used;          // bytes of commands recorded
+    lcd_pixel_t background; // pixel every band starts from
+} tile_list_t;
+
+static tile_list_t record_list; // everything drawn since the last lcd_fill
+static tile_list_t send_list;   // copy handed to the panel driver by lcd_tile_flip
+static dirty_area_t record_box; // area of the call being recorded, from lcd_dirty_add
+static LcdTileStats tile_stats;
+
+static inline tile_command_t *tile_command_at(tile_list_t *list, uint32_t offset)
+{
+    return (tile_command_t *)((uint8_t *)list->commands + offset);
+}
+
+/******************************************************************************
+function: Check whether a command paints every pixel of its area
+parameter:
+    op   : LCD_TILE_* command
+    args : Its arguments
+returns: true for solid rectangles, sprite layer regions and images drawn
+         without transparency
+******************************************************************************/
+static bool tile_is_opaque(uint8_t op, const intptr_t *args)
+{
+    switch (op)
+    {
+    case LCD_TILE_FILL_RECT:
+    case LCD_TILE_SPRITES:
+        return true;
+    case LCD_TILE_BLIT:
+        return !(args[5] & LCD_BLIT_TRANSPARENT);
+    case LCD_TILE_IMAGE:
+        return !(args[4] & LCD_BLIT_TRANSPARENT);
+    default:
+        return false;
+    }
+}
+
+/******************************************************************************
+function: Drop the recorded commands an opaque area hides completely
+parameter:
+    box : Area about to be painted over
+returns: none
+note: Keeps the list from growing when the same region is cleared and
+      redrawn frame after frame without an lcd_fill.
+******************************************************************************/
+static void tile_discard_hidden(const dirty_area_t *box)
+{
+    uint32_t kept = 0;
+    for (uint32_t offset = 0; offset < record_list.used;)
+    {
+        tile_command_t *command = tile_command_at(&record_list, offset);
+        uint16_t size = command->size;
+        offset += size;
+        if (command->box.x0 >= box->x0 && command->box.x1 <= box->x1 && command->box.y0 >= box->y0 &&
+            command->box.y1 <= box->y1)
+            continue;
+        if (kept + size != offset)
+            memmove(tile_command_at(&record_list, kept), command, size);
+        kept += size;
+    }
+    record_list.used = kept;
+}
+
+/******************************************************************************
+function: Remember the area of the drawing call about to be recorded
+parameter:
+    x0, y0 : Top-left corner, clipped to the screen
+    x1, y1 : Bottom-right corner (inclusive), clipped; empty when off-screen
+returns: false while the display list is replayed, then the dirty list must
+         not change
+note: Called by lcd_dirty_add, which every drawing call passes through just
+      before it records itself.
+******************************************************************************/
+bool lcd_tile_set_box(int x0, int y0, int x1, int y1)
+{
+    if (lcd_tile_replaying)
+        return false;
+    record_box.x0 = x0;
+    record_box.y0 = y0;
+    record_box.x1 = x1;
+    record_box.y1 = y1;
+    return true;
+}
+
+/******************************************************************************
+function: Append a drawing call to the display list
+parameter:
+    op         : LCD_TILE_* command
+    args       : Arguments, as the replay passes them back to the call
+    arg_count  : Number of arguments
+    data       : Bytes copied along with the command, NULL for none
+    data_bytes : Size of data
+returns: true when the caller must not draw (recorded, dropped because the
+         list is full, or entirely off-screen), false during the replay
+******************************************************************************/
+bool lcd_tile_record(uint8_t op, const intptr_t *args, uint8_t arg_count, const void *data, size_t data_bytes)
+{
+    if (lcd_tile_replaying)
+        return false;
+    if (record_box.x0 > record_box.x1 || record_box.y0 > record_box.y1)
+        return true; // nothing on screen
+
+    if (tile_is_opaque(op, args))
+        tile_discard_hidden(&record_box);
+
+    size_t size = sizeof(tile_command_t) + arg_count * sizeof(intptr_t) + data_bytes;
+    size = (size + sizeof(intptr_t) - 1) & ~(sizeof(intptr_t) - 1);
+    if (record_list.used + size > sizeof(record_list.commands))
+    {
+        tile_stats.dropped++;
+        return true;
+    }
+
+    tile_command_t *command = tile_command_at(&record_list, record_list.used);
+    command->size = size;
+    command->op = op;
+    command->arg_count = arg_count;
+    command->box = record_box;
+    memcpy(command->args, args, arg_count * sizeof(intptr_t));
+    if (data_bytes > 0)
+        memcpy(&command->args[arg_count], data, data_bytes);
+    record_list.used += size;
+    return true;
+}
+
+/******************************************************************************
+function: Start the frame over from a solid color
+parameter:
+    color : RGB565 background color
+returns: none
+note: lcd_fill in tiled mode. Drops the commands recorded so far, they
+      are covered, and marks the whole screen dirty.
+******************************************************************************/
+void lcd_tile_clear(uint16_t color)
+{
+    record_list.used = 0;
+    record_list.background = lcd_color_to_pixel(color);
+    lcd_invalidate();
+}
+
+/******************************************************************************
+function: Hand the recorded frame to the panel driver
+parameter: none
+returns: none
+note: Called by lcd_swap_async once the previous frame has been sent. The
+      list is copied for lcd_tile_render, so drawing for the next frame can
+      go on while this one is streamed.
+******************************************************************************/
+void lcd_tile_flip(void)
+{
+    tile_stats.list_bytes = record_list.used;
+    if (record_list.used > tile_stats.list_peak_bytes)
+        tile_stats.list_peak_bytes = record_list.used;
+    tile_stats.bands = 0;
+
+    memcpy(send_list.commands, record_list.commands, record_list.used);
+    send_list.used = record_list.used;
+    send_list.background = record_list.background;
+}
+
+/******************************************************************************
+function: Run one command of the display list
+parameter:
+    command : Recorded drawing call
+returns: none
+note: The drawing functions see lcd_tile_replaying and draw instead of
+      recording, clipped to the band.
+******************************************************************************/
+static void tile_replay(const tile_command_t *command)
+{
+    const intptr_t *a = command->args;
+    const void *data = &command->args[command->arg_count];
+    FontTable *font;
+
+    switch (command->op)
+    {
+    case LCD_TILE_PIXEL:
+        lcd_draw_pixel(a[0], a[1], a[2]);
+        break;
+    case LCD_TILE_LINE:
+        lcd_draw_line(a[0], a[1], a[2], a[3], a[4]);
+        break;
+    case LCD_TILE_FILL_RECT:
+        lcd_fill_rect(a[0], a[1], a[2], a[3], a[4]);
+        break;
+    case LCD_TILE_CIRCLE:
+        lcd_draw_circle(a[0], a[1], a[2], a[3]);
+        break;
+    case LCD_TILE_FILL_CIRCLE:
+        lcd_fill_circle(a[0], a[1], a[2], a[3]);
+        break;
+    case LCD_TILE_RING:
+        lcd_draw_ring(a[0], a[1], a[2], a[3], a[4]);
+        break;
+    case LCD_TILE_ARC:
+        lcd_draw_arc(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+        break;
+    case LCD_TILE_TRIANGLE:
+        lcd_fill_triangle(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+        break;
+    case LCD_TILE_POLYGON:
+        lcd_fill_polygon((const LcdPoint *)data, a[0], a[1]);
+        break;
+    case LCD_TILE_THICK_LINE:
+        lcd_draw_thick_line(a[0], a[1], a[2], a[3], a[4], a[5]);
+        break;
+    case LCD_TILE_CHAR:
+        font = lcd_font_select((FontTable *)a[4]);
+        lcd_draw_char(a[0], a[1], a[2], a[3]);
+        lcd_font_select(font);
+        break;
+    case LCD_TILE_TEXT:
+        font = lcd_font_select((FontTable *)a[3]);
+        lcd_draw_text(a[0], a[1], (const char *)data, a[2]);
+        lcd_font_select(font);
+        break;
+    case LCD_TILE_BLIT:
+        lcd_blit_ex(a[0], a[1], a[2], a[3], (const uint8_t *)a[4], a[5]);
+        break;
+    case LCD_TILE_IMAGE:
+        lcd_draw_image(a[0], a[1], (const uint8_t *)a[2], a[3], a[4]);
+        break;
+    case LCD_TILE_SPRITES:
+    {
+        // Only the rows of the band, tilemap and sprites skip the rest
+        dirty_area_t rect = command->box;
+        if (rect.y0 < lcd_band_top)
+            rect.y0 = lcd_band_top;
+        if (rect.y1 >= lcd_band_bottom)
+            rect.y1 = lcd_band_bottom - 1;
+        lcd_sprite_draw_rect(&rect);
+        break;
+    }
+    case LCD_TILE_FILL_RECT_BLEND:
+        lcd_fill_rect_blend(a[0], a[1], a[2], a[3], a[4], a[5]);
+        break;
+    case LCD_TILE_BLIT_ALPHA:
+        lcd_blit_alpha(a[0], a[1], a[2], a[3], (const uint8_t *)a[4], a[5], a[6]);
+        break;
+    case LCD_TILE_LINE_AA:
+        lcd_draw_line_aa(a[0], a[1], a[2], a[3], a[4]);
+        break;
+    case LCD_TILE_CIRCLE_AA:
+        lcd_draw_circle_aa(a[0], a[1], a[2], a[3]);
+        break;
+    case LCD_TILE_FILL_CIRCLE_AA:
+        lcd_fill_circle_aa(a[0], a[1], a[2], a[3]);
+        break;
+    case LCD_TILE_TEXT_FONT:
+        lcd_draw_text_font(a[0], a[1], (const char *)data, (const uint8_t *)a[3], a[2]);
+        break;
+    }
+}
+
+/******************************************************************************
+function: Rasterize rows of the frame being sent into the band
+parameter:
+    x0, x1 : Columns the caller is going to send (inclusive)
+    y      : First screen row
+    lines  : Number of rows, at most LCD_TILE_LINES
+returns: none
+note: The band is cleared to the background and every command whose area
+      overlaps the rows and columns is run again, in recording order.
+      lcd_band then holds screen rows [y, y + lines) until the next call.
+      Called by the panel driver for each chunk it streams, possibly from
+      its DMA interrupt.
+******************************************************************************/
+void lcd_tile_render(int x0, int x1, int y, int lines)
+{
+    const tile_list_t *list = &send_list;
+    const int y1 = y + lines - 1;
+
+    lcd_band_top = y;
+    lcd_band_bottom = y + lines;
+    lcd_memset32(lcd_band, sizeof(lcd_pixel_t) == 1 ? list->background * 0x01010101u : list->background * 0x00010001u,
+                 (size_t)lines * LCD_VIEW_WIDTH * sizeof(lcd_pixel_t));
+
+    lcd_tile_replaying = true;
+    for (uint32_t offset = 0; offset < list->used;)
+    {
+        const tile_command_t *command = (const tile_command_t *)((const uint8_t *)list->commands + offset);
+        offset += command->size;
+        if (command->box.y1 < y || command->box.y0 > y1 || command->box.x1 < x0 || command->box.x0 > x1)
+            continue;
+        tile_replay(command);
+    }
+    lcd_tile_replaying = false;
+    tile_stats.bands++;
+}
+
+#endif
+
+/******************************************************************************
+function: Get display list usage
+parameter:
+    stats : Pointer to the structure to fill
+returns: none
+note: All zero when LCD_TILED is 0. list_bytes and bands describe the frame
+      last handed to the panel.
+******************************************************************************/
+void lcd_get_tile_stats(LcdTileStats *stats)
+{
+    if (stats == NULL)
+        return;
+#if LCD_TILED
+    *stats = tile_stats;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
@@ -13,6 +13,43 @@ class LCD:
 
         blit(x, y, w, h, data)
 
+    def framebuffer(self) -> memoryview:
+        """Writable view of the framebuffer, one RGB332 byte per pixel, row by row
+
+        Each swap sends the whole screen until the first mark_dirty call,
+        from then on only the regions marked dirty.
+        """
+        from waveshare_lcd import framebuffer
+
+        return framebuffer()
+
+    def framebuf(self):
+        """framebuf.FrameBuffer (GS8) drawing straight into the framebuffer
+
+        Pixel values are RGB332, convert RGB565 colors with color332.
+        """
+        from waveshare_lcd import framebuf
+
+        return framebuf()
+
+    def mark_dirty(self, x: int, y: int, w: int, h: int):
+        """Mark a region written through framebuffer() or framebuf() for the next swap"""
+        from waveshare_lcd import mark_dirty
+
+        mark_dirty(x, y, w, h)
+
+    def invalidate(self):
+        """Resend the whole framebuffer on the next swap"""
+        from waveshare_lcd import invalidate
+
+        invalidate()
+
+    def color332(self, color: int) -> int:
+        """Convert an RGB565 color to the RGB332 value stored in the framebuffer"""
+        from waveshare_lcd import color332
+
+        return color332(color)
+
     def draw_pixel(self, x: int, y: int, color: int):
         """Draw a single pixel at the specified position with the given color"""
         from waveshare_lcd import draw_pixel
@@ -31,11 +68,30 @@ class LCD:
 
         set_font(font)
 
-    def swap(self):
-        """Swap the display buffer to update the screen"""
+    def swap(self, block: bool = True):
+        """Swap the display buffer to update the screen
+
+        With block=False the frame is sent in the background; drawing before
+        swap_done() returns True can still change rows not yet sent.
+        """
         from waveshare_lcd import swap
 
-        swap()
+        swap(block=block)
+
+    def swap_done(self) -> bool:
+        """True once the frame started by swap() has reached the display"""
+        from waveshare_lcd import swap_done
+
+        return swap_done()
+
+    async def swap_async(self):
+        """Send the frame, letting other asyncio tasks run until it is done"""
+        import asyncio
+        from waveshare_lcd import swap, swap_done
+
+        swap(block=False)
+        while not swap_done():
+            await asyncio.sleep_ms(0)
 
     def draw_text(self, x: int, y: int, text: str, color: int):
         """Draw text at the specified position with the given color"""
@@ -80,3 +136,26 @@ class LCD:
         from waveshare_lcd import fill_triangle
 
         fill_triangle(x1, y1, x2, y2, x3, y3, color)
+
+    def draw_batch(self, commands):
+        """Draw a DrawList, or a buffer packed the same way, in one call"""
+        from waveshare_lcd import draw_batch
+
+        if hasattr(commands, "draw"):
+            return commands.draw()
+        return draw_batch(commands)
+
+    def profile(self) -> dict:
+        """Driver profiling counters, see waveshare_lcd.profile()
+
+        All zero unless the firmware was built with LCD_PROFILE=1.
+        """
+        from waveshare_lcd import profile
+
+        return profile()
+
+    def profile_reset(self):
+        """Clear the profiling counters and start measuring again"""
+        from waveshare_lcd import profile_reset
+
+        profile_reset()
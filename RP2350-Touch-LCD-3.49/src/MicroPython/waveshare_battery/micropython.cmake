@@ -1,13 +1,16 @@
-# Create a C module for Waveshare battery extension
+# Create a C module for Waveshare battery extension, built on
+# the driver in src/SDK/battery
+set(WAVESHARE_BATTERY_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/battery)
 add_library(usermod_waveshare_battery INTERFACE)
 
 target_sources(usermod_waveshare_battery INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_battery.c
-    ${CMAKE_CURRENT_LIST_DIR}/battery.c
+    ${WAVESHARE_BATTERY_DRIVER_DIR}/battery.c
 )
 
 target_include_directories(usermod_waveshare_battery INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_BATTERY_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_battery INTERFACE
@@ -1,13 +1,16 @@
-# Create a C module for Waveshare qmi extension
+# Create a C module for Waveshare qmi extension, built on
+# the driver in src/SDK/qmi
+set(WAVESHARE_QMI_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/qmi)
 add_library(usermod_waveshare_qmi INTERFACE)
 
 target_sources(usermod_waveshare_qmi INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_qmi.c
-    ${CMAKE_CURRENT_LIST_DIR}/qmi.c
+    ${WAVESHARE_QMI_DRIVER_DIR}/qmi.c
 )
 
 target_include_directories(usermod_waveshare_qmi INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_QMI_DRIVER_DIR}
 )
 
 target_compile_definitions(usermod_waveshare_qmi INTERFACE
@@ -1,13 +1,18 @@
-# Create a C module for Waveshare touch extension
+# Create a C module for Waveshare touch extension, built on
+# the driver in src/SDK/touch
+set(WAVESHARE_TOUCH_DRIVER_DIR ${CMAKE_CURRENT_LIST_DIR}/../../SDK/touch)
 add_library(usermod_waveshare_touch INTERFACE)
 
 target_sources(usermod_waveshare_touch INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}/waveshare_touch.c
-    ${CMAKE_CURRENT_LIST_DIR}/touch.c
+    ${WAVESHARE_TOUCH_DRIVER_DIR}/touch.c
 )
 
 target_include_directories(usermod_waveshare_touch INTERFACE
     ${CMAKE_CURRENT_LIST_DIR}
+    ${WAVESHARE_TOUCH_DRIVER_DIR}
+    ${CMAKE_CURRENT_LIST_DIR}/../../SDK/lcd
+    ${CMAKE_CURRENT_LIST_DIR}/../../../../common/lcd
 )
 
 target_compile_definitions(usermod_waveshare_touch INTERFACE
@@ -4,7 +4,11 @@
 #include "stdio.h"
 #include <stdlib.h>
 #include <stdint.h>
+#ifdef LCD_HOST_BUILD
+#include <stdbool.h> // host null panel, see tools/host
+#else
 #include "pico/stdlib.h"
+#endif
 #include "fonts.h"
 
 #define LCD_HEIGHT 640
@@ -12,6 +16,23 @@
 
 #define LCD_CHUNK_LINES 8
 #define LCD_X_OFFSET 0
+#define LCD_MAX_DIRTY_AREAS 8 // Regions tracked between swaps before they get merged
+#define LCD_POLYGON_MAX_POINTS 32 // Vertex limit of lcd_fill_polygon
+#define LCD_DIRTY_ALIGN 2     // Window start/size granularity required by the controller
+#define LCD_PIXEL_BYTE_SWAP 1 // RGB565 stored byte-swapped, the QSPI byte stream sends it high byte first
+
+// Framebuffer format: 8 keeps an RGB332 buffer expanded through a palette at
+// swap time (low memory), 16 keeps native RGB565 that is sent as-is
+#ifndef LCD_COLOR_DEPTH
+#define LCD_COLOR_DEPTH 8
+#endif
+
+// Set to 1 to expand frames on core1 while the DMA IRQ on core0 sends them,
+// see lcd_ring.h (lcd_init then claims core1, so the MicroPython module keeps
+// it off for _thread)
+#ifndef LCD_DUAL_CORE
+#define LCD_DUAL_CORE 0
+#endif
 
 #define LCD_DEFAULT_BRIGHTNESS 50 // Default brightness (0-100)
 #define LCD_DEFAULT_FONT_SIZE FONT_MEDIUM
@@ -85,6 +106,13 @@
 #define COLOR_PINK 0xFE19
 #endif
 
+// Polygon vertex, signed so shapes can extend past the screen edges
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+} LcdPoint;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -94,19 +122,51 @@ extern "C"
     void lcd_init();
     void lcd_set_backlight_level(uint8_t brightness); // brightness: 0 (off) to 100 (full)
     void lcd_swap(void);
+    void lcd_swap_async(void); // start a background frame transfer
+    void lcd_swap_wait(void);  // block until the frame started by lcd_swap_async is on the panel
+    bool lcd_swap_busy(void);
 
     // Framebuffer drawing functions
     void lcd_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
     void lcd_fill(uint16_t color);
+    void lcd_fill_wait(void); // lcd_fill/lcd_fill_rect run on DMA, wait for the last one
+    bool lcd_fill_busy(void);
     void lcd_blit(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *buffer);
 
+    void lcd_mark_dirty(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+    void lcd_invalidate(void); // resend the whole framebuffer on the next swap
+    void *lcd_get_framebuffer(void); // for direct writes, mark them dirty; NULL with LCD_TILED
+    uint16_t lcd_framebuffer_color(uint16_t color); // RGB565 to the value stored in the framebuffer
+
+    // Orientation: drawing coordinates follow the rotation (clockwise) and
+    // the optional left-right mirror; both return false when the panel
+    // cannot show it. Redraw everything after a change.
+    bool lcd_set_rotation(uint16_t degrees); // 0, 90, 180 or 270
+    bool lcd_set_mirror(bool mirror);
+    uint16_t lcd_get_rotation(void);
+    uint16_t lcd_get_width(void);  // drawing area, swapped with the height at 90 and 270
+    uint16_t lcd_get_height(void);
+    void lcd_panel_to_screen(uint16_t *x, uint16_t *y); // touch (panel frame) to drawing coordinates
+
+    // Hardware vertical scroll. The rows between the fixed areas form a ring
+    // in the framebuffer; draw screen line n of it at row lcd_scroll_row(n).
+    // Only at rotation 0 without mirroring, lcd_set_rotation resets it.
+    void lcd_scroll_area(uint16_t top_fixed, uint16_t bottom_fixed); // also resets the scroll position
+    void lcd_scroll(int16_t lines, uint16_t fill_color); // > 0 moves content up, applied by the next swap
+    uint16_t lcd_scroll_row(uint16_t line);              // framebuffer row shown at a screen line
+
     // Shape drawing functions
     void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
     void lcd_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
     void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
     void lcd_draw_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color);
     void lcd_fill_circle(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t color);
-    void lcd_fill_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t color);
+    void lcd_draw_ring(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t thickness, uint16_t color);
+    void lcd_draw_arc(uint16_t center_x, uint16_t center_y, uint16_t radius, uint16_t thickness,
+                      int16_t start_angle, int16_t end_angle, uint16_t color); // degrees clockwise from 12 o'clock
+    void lcd_fill_triangle(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, uint16_t color);
+    void lcd_fill_polygon(const LcdPoint *points, uint8_t count, uint16_t color);
+    void lcd_draw_thick_line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t width, uint16_t color);
 
     // Text rendering functions
     void lcd_draw_char(uint16_t x, uint16_t y, char c, uint16_t color);
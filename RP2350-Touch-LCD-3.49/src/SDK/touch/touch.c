@@ -1,4 +1,5 @@
 #include "touch.h"
+#include "lcd.h"
 #include <string.h>
 #include "pico/time.h"
 
@@ -44,12 +45,13 @@ TouchVector touch_get_point()
     }
 
     // Read latest touch data
-    touch_read_state();
+    touch_read_data();
 
     if (touch_state.finger > 0)
     {
         tvector.x = touch_state.x1;
         tvector.y = touch_state.y1;
+        lcd_panel_to_screen(&tvector.x, &tvector.y); // follow lcd_set_rotation
     }
     else
     {
@@ -100,7 +102,8 @@ uint8_t touch_read(uint8_t reg)
     return buf;
 }
 
-// Internal function to read multiple registers
+// Internal function to read multiple registers. The sensor is mounted across
+// the panel, its axes are turned into the panel frame of lcd.h here.
 void touch_read_data(void)
 {
     i2c_write_blocking(TOUCH_I2C_PORT, TOUCH_ADDR, read_touchpad_cmd, 11, true);
@@ -8,9 +8,6 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 
-#define LCD_HEIGHT 640
-#define LCD_WIDTH 172
-
 #define TOUCH_ADDR (0x3B)
 #define I2C_PORT i2c1
 #define TOUCH_I2C_PORT i2c0
@@ -0,0 +1,111 @@
+// Host microbenchmark for the text renderer used by lcd_draw_char/lcd_draw_text.
+//
+// Build and run from this directory:
+//   cc -O2 -DLCD_HOST_BUILD -I../../common/lcd glyph_bench.c ../../common/lcd/lcd_glyph.c ../../common/lcd/font*.c -o glyph_bench
+//   ./glyph_bench
+// Add -DLCD_GLYPH_CACHE=1 to measure the decoded glyph cache.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lcd_glyph.h"
+
+#define BENCH_WIDTH 172
+#define BENCH_HEIGHT 640
+#define BENCH_GLYPHS 200000
+
+static uint8_t framebuffer[BENCH_WIDTH * BENCH_HEIGHT];
+static uint8_t reference[BENCH_WIDTH * BENCH_HEIGHT];
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// The per-bit loop lcd_draw_char used before the span renderer
+static void draw_char_bits(uint8_t *dst, int x, int y, const FontTable *font, char c, uint8_t pixel)
+{
+    uint8_t bytes_per_row = (font->width + 7) / 8;
+    const uint8_t *char_data = &font->table[(c - 32) * font->height * bytes_per_row];
+
+    for (uint8_t row = 0; row < font->height; row++)
+    {
+        const uint8_t *row_data = &char_data[row * bytes_per_row];
+        for (uint8_t col = 0; col < font->width; col++)
+        {
+            if ((row_data[col / 8] & (1 << (7 - col % 8))) && x + col < BENCH_WIDTH && y + row < BENCH_HEIGHT)
+                dst[(y + row) * BENCH_WIDTH + (x + col)] = pixel;
+        }
+    }
+}
+
+// Glyph positions walk the screen like lcd_draw_text, with the last column
+// and row partly off-screen so the clipping paths are exercised too
+static void glyph_position(const FontTable *font, int i, int *x, int *y)
+{
+    int columns = BENCH_WIDTH / font->width + 1;
+    int rows = BENCH_HEIGHT / font->height + 1;
+    *x = (i % columns) * font->width;
+    *y = (i / columns % rows) * font->height;
+}
+
+int main(void)
+{
+    static const struct
+    {
+        const char *name;
+        const FontTable *font;
+    } fonts[] = {
+        {"Font8", &Font8},
+        {"Font12", &Font12},
+        {"Font16", &Font16},
+        {"Font20", &Font20},
+        {"Font24", &Font24},
+    };
+
+    printf("LCD_GLYPH_CACHE=%d\n", LCD_GLYPH_CACHE);
+    for (size_t f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++)
+    {
+        const FontTable *font = fonts[f].font;
+        int x, y;
+
+        memset(reference, 0, sizeof(reference));
+        memset(framebuffer, 0, sizeof(framebuffer));
+        for (int i = 0; i < 95 * 4; i++)
+        {
+            glyph_position(font, i, &x, &y);
+            draw_char_bits(reference, x, y, font, 32 + i % 95, 0x80 + i % 64);
+            lcd_glyph_draw8(framebuffer, BENCH_WIDTH, BENCH_HEIGHT, x, y, font, 32 + i % 95, 0x80 + i % 64);
+        }
+        if (memcmp(reference, framebuffer, sizeof(framebuffer)) != 0)
+        {
+            printf("%s: mismatch between bit loop and span renderer\n", fonts[f].name);
+            return 1;
+        }
+
+        double start = now_us();
+        for (int i = 0; i < BENCH_GLYPHS; i++)
+        {
+            glyph_position(font, i, &x, &y);
+            draw_char_bits(framebuffer, x, y, font, 32 + i % 95, 0xFF);
+            __asm__ volatile("" ::: "memory");
+        }
+        double bits_us = now_us() - start;
+
+        start = now_us();
+        for (int i = 0; i < BENCH_GLYPHS; i++)
+        {
+            glyph_position(font, i, &x, &y);
+            lcd_glyph_draw8(framebuffer, BENCH_WIDTH, BENCH_HEIGHT, x, y, font, 32 + i % 95, 0xFF);
+            __asm__ volatile("" ::: "memory");
+        }
+        double spans_us = now_us() - start;
+
+        printf("%-6s (%2dx%2d): bits %6.2f Mglyphs/s, spans %6.2f Mglyphs/s (%.2fx)\n",
+               fonts[f].name, font->width, font->height,
+               BENCH_GLYPHS / bits_us, BENCH_GLYPHS / spans_us, bits_us / spans_us);
+    }
+    return 0;
+}
@@ -0,0 +1,736 @@
+#!/usr/bin/env python3
+"""Compile a TrueType or BDF font into the lcd font container (see lcd_font.h).
+
+TrueType outlines are rasterized here with 1, 2 or 4 bits of coverage per
+pixel, no hinting; kerning comes from the 'kern' table and from GPOS pair
+adjustments of the 'kern' feature. BDF fonts are bitmaps already and give
+1-bit glyphs without kerning. CFF based OpenType (.otf) fonts are not
+supported, convert them to TrueType outlines first.
+
+    font_compile.py input.ttf output.h --size 24 [--bpp 4] [--ranges 32-126]
+                    [--kerning-min 1] [--missing ?|none] [--name NAME]
+                    [--preview text.pgm]
+
+--size is the em size in pixels for TrueType (ignored for BDF). --ranges
+lists code points and ranges, e.g. "32-126,0xB0,0x2190-0x2193"; code points
+the font does not have are left out. The output type follows the extension:
+.h writes a C array, .py a MicroPython bytes constant, anything else the raw
+container. --preview renders a sample text from the compiled container the
+way lcd_draw_text_font does, as a grey-scale PGM.
+"""
+import argparse
+import math
+import os
+import struct
+import sys
+
+MAGIC = b"LF"
+HEADER_SIZE = 16
+NO_GLYPH = 0xFFFF
+FLAG_BYTE_KERNING = 0x01  # kerning entries with 8-bit glyph numbers
+SUBSAMPLES = 8  # scanlines per pixel row when rasterizing outlines
+CURVE_STEPS = 8  # line segments per quadratic curve
+
+
+class Glyph:
+    def __init__(self, code, width, height, left, top, advance, coverage):
+        self.code = code
+        self.width = width
+        self.height = height
+        self.left = left  # bitmap position relative to the pen
+        self.top = top  # relative to the top of the line
+        self.advance = advance
+        self.coverage = coverage  # width * height values, 0.0-1.0
+        self.source = None  # glyph id in the input font, for kerning
+
+
+class Font:
+    def __init__(self, height, ascent, glyphs, kerning):
+        self.height = height
+        self.ascent = ascent
+        self.glyphs = glyphs  # code point -> Glyph
+        self.kerning = kerning  # (left code, right code) -> pixels
+
+
+# ---------------------------------------------------------------------------
+# TrueType
+
+
+class TrueType:
+    def __init__(self, data):
+        self.data = data
+        if data[:4] == b"OTTO":
+            raise ValueError("CFF outlines are not supported, convert the font to TrueType")
+        if data[:4] == b"ttcf":
+            raise ValueError("font collections are not supported, extract one font first")
+        count = struct.unpack_from(">H", data, 4)[0]
+        self.tables = {}
+        for i in range(count):
+            tag, _, offset, length = struct.unpack_from(">4sIII", data, 12 + i * 16)
+            self.tables[tag.decode("latin-1")] = (offset, length)
+        for tag in ("head", "hhea", "maxp", "hmtx", "loca", "glyf", "cmap"):
+            if tag not in self.tables:
+                raise ValueError("missing '%s' table" % tag)
+
+        head = self.tables["head"][0]
+        self.units_per_em = struct.unpack_from(">H", data, head + 18)[0]
+        self.long_loca = struct.unpack_from(">h", data, head + 50)[0] == 1
+        hhea = self.tables["hhea"][0]
+        self.ascender, self.descender, self.line_gap = struct.unpack_from(">hhh", data, hhea + 4)
+        metrics_count = struct.unpack_from(">H", data, hhea + 34)[0]
+        self.glyph_count = struct.unpack_from(">H", data, self.tables["maxp"][0] + 4)[0]
+
+        hmtx = self.tables["hmtx"][0]
+        self.advances = []
+        for i in range(self.glyph_count):
+            self.advances.append(struct.unpack_from(">H", data, hmtx + 4 * min(i, metrics_count - 1))[0])
+
+        loca = self.tables["loca"][0]
+        if self.long_loca:
+            self.loca = struct.unpack_from(">%dI" % (self.glyph_count + 1), data, loca)
+        else:
+            self.loca = [v * 2 for v in struct.unpack_from(">%dH" % (self.glyph_count + 1), data, loca)]
+        self.cmap = self.read_cmap()
+
+    def u16(self, offset):
+        return struct.unpack_from(">H", self.data, offset)[0]
+
+    def read_cmap(self):
+        base = self.tables["cmap"][0]
+        subtables = {}
+        for i in range(self.u16(base + 2)):
+            platform, encoding, offset = struct.unpack_from(">HHI", self.data, base + 4 + i * 8)
+            subtables[(platform, encoding)] = base + offset
+        for key in ((3, 10), (0, 6), (0, 4), (3, 1), (0, 3), (0, 2), (0, 1), (0, 0)):
+            if key in subtables:
+                mapping = self.read_cmap_subtable(subtables[key])
+                if mapping is not None:
+                    return mapping
+        raise ValueError("no Unicode cmap (format 4 or 12)")
+
+    def read_cmap_subtable(self, offset):
+        fmt = self.u16(offset)
+        mapping = {}
+        if fmt == 4:
+            segments = self.u16(offset + 6) // 2
+            ends = offset + 14
+            starts = ends + segments * 2 + 2
+            deltas = starts + segments * 2
+            ranges = deltas + segments * 2
+            for s in range(segments):
+                end = self.u16(ends + s * 2)
+                start = self.u16(starts + s * 2)
+                delta = self.u16(deltas + s * 2)
+                range_offset = self.u16(ranges + s * 2)
+                for code in range(start, end + 1):
+                    if code == 0xFFFF:
+                        continue
+                    if range_offset == 0:
+                        glyph = (code + delta) & 0xFFFF
+                    else:
+                        glyph = self.u16(ranges + s * 2 + range_offset + (code - start) * 2)
+                        if glyph:
+                            glyph = (glyph + delta) & 0xFFFF
+                    if glyph:
+                        mapping[code] = glyph
+            return mapping
+        if fmt == 12:
+            groups = struct.unpack_from(">I", self.data, offset + 12)[0]
+            for g in range(groups):
+                start, end, glyph = struct.unpack_from(">III", self.data, offset + 16 + g * 12)
+                for code in range(start, end + 1):
+                    mapping[code] = glyph + code - start
+            return mapping
+        return None
+
+    def contours(self, glyph, depth=0):
+        """Outline of a glyph as lists of (x, y, on_curve) points, font units."""
+        start, end = self.loca[glyph], self.loca[glyph + 1]
+        if start == end or depth > 8:
+            return []
+        base = self.tables["glyf"][0] + start
+        count = struct.unpack_from(">h", self.data, base)[0]
+        if count < 0:
+            return self.composite(base + 10, depth)
+
+        end_points = struct.unpack_from(">%dH" % count, self.data, base + 10)
+        points_count = end_points[-1] + 1 if count else 0
+        pos = base + 10 + count * 2
+        pos += 2 + self.u16(pos)  # instructions
+        flags = []
+        while len(flags) < points_count:
+            flag = self.data[pos]
+            pos += 1
+            flags.append(flag)
+            if flag & 0x08:
+                repeat = self.data[pos]
+                pos += 1
+                flags.extend([flag] * repeat)
+
+        def coordinates(short_bit, same_bit):
+            nonlocal pos
+            values, value = [], 0
+            for flag in flags:
+                if flag & short_bit:
+                    delta = self.data[pos]
+                    pos += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    value += struct.unpack_from(">h", self.data, pos)[0]
+                    pos += 2
+                values.append(value)
+            return values
+
+        xs = coordinates(0x02, 0x10)
+        ys = coordinates(0x04, 0x20)
+        contours, first = [], 0
+        for last in end_points:
+            contours.append([(xs[i], ys[i], bool(flags[i] & 1)) for i in range(first, last + 1)])
+            first = last + 1
+        return contours
+
+    def composite(self, pos, depth):
+        contours = []
+        while True:
+            flags, glyph = struct.unpack_from(">HH", self.data, pos)
+            pos += 4
+            if flags & 0x0001:
+                dx, dy = struct.unpack_from(">hh", self.data, pos)
+                pos += 4
+            else:
+                dx, dy = struct.unpack_from(">bb", self.data, pos)
+                pos += 2
+            if not flags & 0x0002:
+                dx = dy = 0  # point matching, not supported
+            a, b, c, d = 1.0, 0.0, 0.0, 1.0
+            if flags & 0x0008:
+                a = d = struct.unpack_from(">h", self.data, pos)[0] / 16384.0
+                pos += 2
+            elif flags & 0x0040:
+                a, d = [v / 16384.0 for v in struct.unpack_from(">hh", self.data, pos)]
+                pos += 4
+            elif flags & 0x0080:
+                a, b, c, d = [v / 16384.0 for v in struct.unpack_from(">hhhh", self.data, pos)]
+                pos += 8
+            for contour in self.contours(glyph, depth + 1):
+                contours.append([(x * a + y * c + dx, x * b + y * d + dy, on) for x, y, on in contour])
+            if not flags & 0x0020:
+                return contours
+
+    # -- kerning --
+
+    def kerning_pairs(self, wanted):
+        """Kerning in font units between glyph ids of the wanted set."""
+        pairs = {}
+        if "GPOS" in self.tables:
+            self.read_gpos(pairs, wanted)
+        if not pairs and "kern" in self.tables:
+            self.read_kern(pairs, wanted)
+        return pairs
+
+    def read_kern(self, pairs, wanted):
+        base = self.tables["kern"][0]
+        if self.u16(base) != 0:
+            return  # Apple's version 1 table
+        pos = base + 4
+        for _ in range(self.u16(base + 2)):
+            length, coverage = self.u16(pos + 2), self.u16(pos + 4)
+            if coverage >> 8 == 0 and coverage & 0x01:  # format 0, horizontal
+                for i in range(self.u16(pos + 6)):
+                    left, right, value = struct.unpack_from(">HHh", self.data, pos + 14 + i * 6)
+                    if left in wanted and right in wanted:
+                        pairs[(left, right)] = pairs.get((left, right), 0) + value
+            pos += length
+
+    def coverage(self, offset):
+        fmt = self.u16(offset)
+        glyphs = []
+        if fmt == 1:
+            glyphs = list(struct.unpack_from(">%dH" % self.u16(offset + 2), self.data, offset + 4))
+        elif fmt == 2:
+            for r in range(self.u16(offset + 2)):
+                start, end, _ = struct.unpack_from(">HHH", self.data, offset + 4 + r * 6)
+                glyphs.extend(range(start, end + 1))
+        return glyphs
+
+    def class_def(self, offset):
+        fmt = self.u16(offset)
+        classes = {}
+        if fmt == 1:
+            start, count = self.u16(offset + 2), self.u16(offset + 4)
+            for i in range(count):
+                classes[start + i] = self.u16(offset + 6 + i * 2)
+        elif fmt == 2:
+            for r in range(self.u16(offset + 2)):
+                start, end, cls = struct.unpack_from(">HHH", self.data, offset + 4 + r * 6)
+                for g in range(start, end + 1):
+                    classes[g] = cls
+        return classes
+
+    @staticmethod
+    def value_size(fmt):
+        return 2 * bin(fmt & 0xFF).count("1")
+
+    def x_advance(self, offset, fmt):
+        """XAdvance of a ValueRecord, 0 when the format has none."""
+        if not fmt & 0x0004:
+            return 0
+        skip = 2 * bin(fmt & 0x0003).count("1")
+        return struct.unpack_from(">h", self.data, offset + skip)[0]
+
+    def read_gpos(self, pairs, wanted):
+        base = self.tables["GPOS"][0]
+        features = base + self.u16(base + 6)
+        lookups = base + self.u16(base + 8)
+        indices = set()
+        for f in range(self.u16(features)):
+            tag = self.data[features + 2 + f * 6 : features + 6 + f * 6]
+            if tag == b"kern":
+                feature = features + self.u16(features + 6 + f * 6)
+                for i in range(self.u16(feature + 2)):
+                    indices.add(self.u16(feature + 4 + i * 2))
+        for index in sorted(indices):
+            lookup = lookups + self.u16(lookups + 2 + index * 2)
+            kind = self.u16(lookup)
+            for s in range(self.u16(lookup + 4)):
+                subtable = lookup + self.u16(lookup + 6 + s * 2)
+                if kind == 9:  # extension
+                    if self.u16(subtable + 2) != 2:
+                        continue
+                    subtable += struct.unpack_from(">I", self.data, subtable + 4)[0]
+                elif kind != 2:
+                    continue
+                self.read_pair_pos(subtable, pairs, wanted)
+
+    def read_pair_pos(self, offset, pairs, wanted):
+        fmt = self.u16(offset)
+        first_glyphs = self.coverage(offset + self.u16(offset + 2))
+        format1, format2 = self.u16(offset + 4), self.u16(offset + 6)
+        size1, size2 = self.value_size(format1), self.value_size(format2)
+        if fmt == 1:
+            for i, left in enumerate(first_glyphs):
+                if left not in wanted:
+                    continue
+                pair_set = offset + self.u16(offset + 10 + i * 2)
+                for p in range(self.u16(pair_set)):
+                    record = pair_set + 2 + p * (2 + size1 + size2)
+                    right = self.u16(record)
+                    value = self.x_advance(record + 2, format1)
+                    if right in wanted and value and (left, right) not in pairs:
+                        pairs[(left, right)] = value
+        elif fmt == 2:
+            classes1 = self.class_def(offset + self.u16(offset + 8))
+            classes2 = self.class_def(offset + self.u16(offset + 10))
+            count1, count2 = self.u16(offset + 12), self.u16(offset + 14)
+            record_size = size1 + size2
+            covered = set(first_glyphs)
+            for left in wanted:
+                if left not in covered:
+                    continue
+                row = offset + 16 + classes1.get(left, 0) * count2 * record_size
+                for right in wanted:
+                    cls = classes2.get(right, 0)
+                    if cls >= count2 or (left, right) in pairs:
+                        continue
+                    value = self.x_advance(row + cls * record_size, format1)
+                    if value:
+                        pairs[(left, right)] = value
+
+
+def flatten(contour):
+    """Points of a TrueType contour with its quadratic curves split into lines."""
+    if not contour:
+        return []
+    # Start on an on-curve point, inventing one between two off-curve points
+    start = next((i for i, p in enumerate(contour) if p[2]), None)
+    if start is None:
+        a, b = contour[0], contour[1 % len(contour)]
+        points = [((a[0] + b[0]) / 2.0, (a[1] + b[1]) / 2.0, True)] + contour[1:] + contour[:1]
+    else:
+        points = contour[start:] + contour[:start]
+    points = points + points[:1]
+
+    out = [(points[0][0], points[0][1])]
+    control = None
+    for x, y, on in points[1:]:
+        if on:
+            if control is None:
+                out.append((x, y))
+            else:
+                out.extend(quad(out[-1], control, (x, y)))
+                control = None
+        else:
+            if control is not None:
+                middle = ((control[0] + x) / 2.0, (control[1] + y) / 2.0)
+                out.extend(quad(out[-1], control, middle))
+            control = (x, y)
+    if control is not None:
+        out.extend(quad(out[-1], control, out[0]))
+    return out
+
+
+def quad(p0, p1, p2):
+    points = []
+    for i in range(1, CURVE_STEPS + 1):
+        t = i / float(CURVE_STEPS)
+        u = 1.0 - t
+        points.append((u * u * p0[0] + 2 * u * t * p1[0] + t * t * p2[0],
+                       u * u * p0[1] + 2 * u * t * p1[1] + t * t * p2[1]))
+    return points
+
+
+def rasterize(polygons, width, height):
+    """Coverage of closed polygons (non-zero winding) over a width x height grid.
+
+    Each pixel row is sampled on SUBSAMPLES scanlines; along a scanline the
+    span ends are exact, so vertical edges come out as smooth as horizontal
+    ones.
+    """
+    edges = []
+    for polygon in polygons:
+        for i in range(len(polygon) - 1):
+            (x0, y0), (x1, y1) = polygon[i], polygon[i + 1]
+            if y0 != y1:
+                edges.append((x0, y0, x1, y1, 1 if y1 > y0 else -1))
+
+    coverage = [0.0] * (width * height)
+    weight = 1.0 / SUBSAMPLES
+    for row in range(height):
+        line = [0.0] * (width + 1)
+        for s in range(SUBSAMPLES):
+            y = row + (s + 0.5) / SUBSAMPLES
+            crossings = []
+            for x0, y0, x1, y1, direction in edges:
+                if (y0 <= y < y1) or (y1 <= y < y0):
+                    crossings.append((x0 + (y - y0) * (x1 - x0) / (y1 - y0), direction))
+            crossings.sort()
+            winding = 0
+            for x, direction in crossings:
+                if winding == 0:
+                    span_start = x
+                winding += direction
+                if winding == 0:
+                    add_span(line, max(span_start, 0.0), min(x, float(width)), weight)
+        for col in range(width):
+            coverage[row * width + col] = min(line[col], 1.0)
+    return coverage
+
+
+def add_span(line, x0, x1, weight):
+    if x1 <= x0:
+        return
+    first, last = int(x0), int(x1)
+    if first == last:
+        line[first] += (x1 - x0) * weight
+        return
+    line[first] += (first + 1 - x0) * weight
+    for col in range(first + 1, last):
+        line[col] += weight
+    if last < len(line):
+        line[last] += (x1 - last) * weight
+
+
+def load_truetype(data, size, codes):
+    font = TrueType(data)
+    scale = size / float(font.units_per_em)
+    ascent = int(math.ceil(font.ascender * scale))
+    height = int(math.ceil((font.ascender - font.descender + font.line_gap) * scale))
+
+    glyphs = {}
+    for code in codes:
+        gid = font.cmap.get(code)
+        if gid is None:
+            continue
+        polygons = []
+        for contour in font.contours(gid):
+            polygon = [(x * scale, ascent - y * scale) for x, y in flatten(contour)]
+            if len(polygon) > 2:
+                polygons.append(polygon)
+        advance = int(round(font.advances[gid] * scale))
+        if not polygons:
+            glyph = Glyph(code, 0, 0, 0, 0, advance, [])
+        else:
+            xs = [x for p in polygons for x, _ in p]
+            ys = [y for p in polygons for _, y in p]
+            left, top = int(math.floor(min(xs))), int(math.floor(min(ys)))
+            width, height_px = int(math.ceil(max(xs))) - left, int(math.ceil(max(ys))) - top
+            shifted = [[(x - left, y - top) for x, y in p] for p in polygons]
+            glyph = Glyph(code, width, height_px, left, top, advance, rasterize(shifted, width, height_px))
+        glyph.source = gid
+        glyphs[code] = glyph
+
+    by_gid = {}
+    for code, glyph in glyphs.items():
+        by_gid.setdefault(glyph.source, []).append(code)
+    kerning = {}
+    for (left, right), value in font.kerning_pairs(set(by_gid)).items():
+        pixels = int(round(value * scale))
+        if pixels:
+            for a in by_gid[left]:
+                for b in by_gid[right]:
+                    kerning[(a, b)] = pixels
+    return Font(height, ascent, glyphs, kerning)
+
+
+# ---------------------------------------------------------------------------
+# BDF
+
+
+def load_bdf(text, codes):
+    ascent = descent = None
+    glyphs = {}
+    lines = iter(text.splitlines())
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "FONT_ASCENT":
+            ascent = int(fields[1])
+        elif fields[0] == "FONT_DESCENT":
+            descent = int(fields[1])
+        elif fields[0] == "STARTCHAR":
+            code = advance = None
+            bbx = (0, 0, 0, 0)
+            rows = []
+            for line in lines:
+                fields = line.split()
+                if not fields:
+                    continue
+                if fields[0] == "ENCODING":
+                    code = int(fields[1])
+                elif fields[0] == "DWIDTH":
+                    advance = int(fields[1])
+                elif fields[0] == "BBX":
+                    bbx = tuple(int(v) for v in fields[1:5])
+                elif fields[0] == "BITMAP":
+                    for line in lines:
+                        if line.startswith("ENDCHAR"):
+                            break
+                        rows.append(int(line.strip() or "0", 16) if line.strip() else 0)
+                    break
+            if code is None or code < 0 or code not in codes:
+                continue
+            width, height, x_off, y_off = bbx
+            row_bits = (width + 7) // 8 * 8
+            coverage = []
+            for r in range(height):
+                bits = rows[r] if r < len(rows) else 0
+                coverage.extend(1.0 if bits >> (row_bits - 1 - c) & 1 else 0.0 for c in range(width))
+            glyphs[code] = (width, height, x_off, y_off, advance if advance is not None else width, coverage)
+    if ascent is None or descent is None:
+        raise ValueError("BDF without FONT_ASCENT and FONT_DESCENT")
+    result = {}
+    for code, (width, height, x_off, y_off, advance, coverage) in glyphs.items():
+        result[code] = Glyph(code, width, height, x_off, ascent - (y_off + height), advance, coverage)
+    return Font(ascent + descent, ascent, result, {})
+
+
+# ---------------------------------------------------------------------------
+# Container
+
+
+def trim(glyph, levels):
+    """Quantize the coverage and drop empty rows and columns around it."""
+    values = [int(c * levels + 0.5) for c in glyph.coverage]
+    w, h = glyph.width, glyph.height
+    rows = [r for r in range(h) if any(values[r * w : (r + 1) * w])]
+    cols = [c for c in range(w) if any(values[r * w + c] for r in range(h))]
+    if not rows or not cols:
+        return 0, 0, 0, 0, []
+    r0, r1, c0, c1 = rows[0], rows[-1] + 1, cols[0], cols[-1] + 1
+    pixels = [values[r * w + c] for r in range(r0, r1) for c in range(c0, c1)]
+    return c1 - c0, r1 - r0, glyph.left + c0, glyph.top + r0, pixels
+
+
+def pack(values, bpp):
+    out = bytearray()
+    acc = bits = 0
+    for v in values:
+        acc = (acc << bpp) | v
+        bits += bpp
+        if bits == 8:
+            out.append(acc)
+            acc = bits = 0
+    if bits:
+        out.append(acc << (8 - bits))
+    return bytes(out)
+
+
+def build(font, bpp, missing, kerning_min=1):
+    levels = (1 << bpp) - 1
+    codes = sorted(font.glyphs)
+    if not codes:
+        raise ValueError("none of the requested characters are in the font")
+    if font.height > 255 or font.ascent > 255 or font.ascent < 0:
+        raise ValueError("font too large, line height %d" % font.height)
+
+    ranges = []
+    for index, code in enumerate(codes):
+        if ranges and ranges[-1][0] + ranges[-1][1] == code:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([code, 1, index])
+
+    glyph_table, bitmaps, shared = bytearray(), bytearray(), {}
+    for code in codes:
+        glyph = font.glyphs[code]
+        width, height, left, top, pixels = trim(glyph, levels)
+        if width > 255 or height > 255 or not -128 <= left <= 127 or not -128 <= top <= 127:
+            raise ValueError("glyph U+%04X too large" % code)
+        if not 0 <= glyph.advance <= 255:
+            raise ValueError("advance of U+%04X out of range" % code)
+        bitmap = pack(pixels, bpp)
+        offset = shared.get(bitmap)
+        if offset is None:
+            offset = shared[bitmap] = len(bitmaps)
+            bitmaps += bitmap
+        if offset > 0xFFFFFF:
+            raise ValueError("font too large")
+        glyph_table += struct.pack("<I", offset)[:3]
+        glyph_table += struct.pack("<BBbbB", width, height, left, top, glyph.advance)
+
+    index_of = {code: i for i, code in enumerate(codes)}
+    kerning = sorted((index_of[a], index_of[b], v) for (a, b), v in font.kerning.items()
+                     if a in index_of and b in index_of and abs(v) >= kerning_min)
+    flags = FLAG_BYTE_KERNING if len(codes) <= 256 else 0
+    kerning_table = bytearray()
+    for left, right, value in kerning:
+        kerning_table += struct.pack("<BBb" if flags & FLAG_BYTE_KERNING else "<HHb", left, right,
+                                     max(-128, min(127, value)))
+
+    missing_index = index_of.get(missing, NO_GLYPH) if missing is not None else NO_GLYPH
+    header = MAGIC + struct.pack("<BBBBHHHHH", bpp, flags, font.height, font.ascent, missing_index,
+                                 len(ranges), len(codes), len(kerning), 0)
+    assert len(header) == HEADER_SIZE
+    range_table = b"".join(struct.pack("<IHH", first, count, index) for first, count, index in ranges)
+    return header + range_table + bytes(glyph_table) + bytes(kerning_table) + bytes(bitmaps)
+
+
+def preview(container, text, path):
+    """Render text from a container as lcd_draw_text_font lays it out."""
+    bpp, height = container[2], container[4]
+    missing, range_count, glyph_count, kerning_count = struct.unpack_from("<HHHH", container, 6)
+    ranges = [struct.unpack_from("<IHH", container, HEADER_SIZE + i * 8) for i in range(range_count)]
+    glyphs_at = HEADER_SIZE + range_count * 8
+    kerning_at = glyphs_at + glyph_count * 8
+    pair_format = "<BBb" if container[3] & FLAG_BYTE_KERNING else "<HHb"
+    pair_size = struct.calcsize(pair_format)
+    bitmaps_at = kerning_at + kerning_count * pair_size
+    kerning = {}
+    for i in range(kerning_count):
+        left, right, value = struct.unpack_from(pair_format, container, kerning_at + i * pair_size)
+        kerning[(left, right)] = value
+
+    def glyph_of(code):
+        for first, count, index in ranges:
+            if first <= code < first + count:
+                return index + code - first
+        return missing if missing < glyph_count else None
+
+    lines = text.split("\n")
+    width = 8 + max(sum(container[glyphs_at + 8 * g + 7] for g in map(glyph_of, map(ord, line)) if g is not None)
+                    for line in lines)
+    image_height = height * len(lines) + 8
+    image = bytearray(width * image_height)
+    levels = (1 << bpp) - 1
+    for row, line in enumerate(lines):
+        pen_x, pen_y, previous = 4, 4 + row * height, None
+        for ch in line:
+            g = glyph_of(ord(ch))
+            if g is None:
+                continue
+            pen_x += kerning.get((previous, g), 0)
+            previous = g
+            entry = glyphs_at + 8 * g
+            offset = container[entry] | container[entry + 1] << 8 | container[entry + 2] << 16
+            w, h, left, top, advance = struct.unpack_from("<BBbbB", container, entry + 3)
+            for i in range(w * h):
+                bit = i * bpp
+                value = (container[bitmaps_at + offset + bit // 8] >> (8 - bpp - bit % 8)) & levels
+                x, y = pen_x + left + i % w, pen_y + top + i // w
+                if 0 <= x < width and 0 <= y < image_height:
+                    image[y * width + x] = max(image[y * width + x], value * 255 // levels)
+            pen_x += advance
+    with open(path, "wb") as f:
+        f.write(b"P5\n%d %d\n255\n" % (width, image_height))
+        f.write(bytes(image))
+
+
+def parse_ranges(spec):
+    codes = set()
+    for part in spec.split(","):
+        part = part.strip()
+        if not part:
+            continue
+        if "-" in part[1:]:
+            dash = part.index("-", 1)
+            codes.update(range(int(part[:dash], 0), int(part[dash + 1 :], 0) + 1))
+        else:
+            codes.add(int(part, 0))
+    return codes
+
+
+def write_output(path, name, container, description):
+    ext = os.path.splitext(path)[1].lower()
+    if ext in (".h", ".py"):
+        lines = []
+        for i in range(0, len(container), 16):
+            lines.append(", ".join("0x%02X" % b for b in container[i : i + 16]) + ",")
+        with open(path, "w") as f:
+            if ext == ".h":
+                f.write("#pragma once\n#include <stdint.h>\n")
+                f.write("// %d bytes, lcd font container (lcd_font.h): %s\n" % (len(container), description))
+                f.write("static const uint8_t %s[] =\n    {\n" % name)
+                f.writelines("        %s\n" % line for line in lines)
+                f.write("};\n")
+            else:
+                f.write("# %d bytes, lcd font container (lcd_font.h): %s\n" % (len(container), description))
+                f.write("%s = bytes(\n    [\n" % name.upper())
+                f.writelines("        %s\n" % line for line in lines)
+                f.write("    ]\n)\n")
+    else:
+        with open(path, "wb") as f:
+            f.write(container)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile a font for lcd_draw_text_font")
+    parser.add_argument("input", help="TrueType (.ttf) or BDF (.bdf) file")
+    parser.add_argument("output", help=".h, .py or binary output file")
+    parser.add_argument("--size", type=float, default=16, help="em size in pixels (TrueType)")
+    parser.add_argument("--bpp", type=int, choices=[1, 2, 4], help="coverage bits, default 4 (1 for BDF)")
+    parser.add_argument("--ranges", default="32-126", help="code points, e.g. 32-126,0xB0")
+    parser.add_argument("--kerning-min", type=int, default=1,
+                        help="leave out kerning pairs smaller than this many pixels")
+    parser.add_argument("--missing", default="?", help="character drawn for missing ones, or 'none'")
+    parser.add_argument("--name", help="array name, defaults to the output file name")
+    parser.add_argument("--preview", help="render a sample into this PGM file")
+    parser.add_argument("--preview-text", default="The quick brown fox jumps\nover the lazy dog 0123456789",
+                        help="text for --preview")
+    args = parser.parse_args()
+
+    codes = parse_ranges(args.ranges)
+    with open(args.input, "rb") as f:
+        data = f.read()
+    if data.lstrip().startswith(b"STARTFONT"):
+        font = load_bdf(data.decode("latin-1"), codes)
+        bpp = args.bpp or 1
+        description = "%s, %d px line" % (os.path.basename(args.input), font.height)
+    else:
+        font = load_truetype(data, args.size, codes)
+        bpp = args.bpp or 4
+        description = "%s at %g px, %d bpp" % (os.path.basename(args.input), args.size, bpp)
+
+    missing = None if args.missing == "none" else ord(args.missing[0])
+    container = build(font, bpp, missing, args.kerning_min)
+    name = args.name or os.path.splitext(os.path.basename(args.output))[0]
+    write_output(args.output, name, container, description)
+    if args.preview:
+        preview(container, args.preview_text, args.preview)
+    print("%s: %d glyphs, %d kerning pairs, line %d px, %d bytes" % (
+        args.output, len(font.glyphs), struct.unpack_from("<H", container, 12)[0], font.height, len(container)),
+        file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Compare the lcd_bench scenes with the golden images.
+
+Runs lcd_bench with a fixed iteration count, so every scene is the same
+picture on every run, and compares each saved panel image with the PNG of
+the same name in the golden directory. Exits with 1 on any difference, and
+writes <scene>_diff.ppm next to the output for each scene that changed
+(differing pixels in full color, the rest dimmed).
+
+    golden.py lcd_bench golden_dir work_dir [--iterations 16] [--update]
+
+ctest runs this for every driver configuration, see CMakeLists.txt. After an
+intended change in the output, rerun it with --update on the framebuffer
+builds (rgb332 and rgb565) to rewrite the golden images; the tiled builds
+must then match them unchanged.
+"""
+import argparse
+import os
+import struct
+import subprocess
+import sys
+import zlib
+
+
+def read_ppm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    fields = data.split(maxsplit=4)
+    if fields[0] != b"P6" or fields[3] != b"255":
+        raise ValueError("%s: not an 8-bit binary PPM" % path)
+    return int(fields[1]), int(fields[2]), fields[4]
+
+
+def read_png(path):
+    """8-bit RGB PNG, as written by write_png, to raw RGB bytes."""
+    with open(path, "rb") as f:
+        data = f.read()
+    pos = 8
+    idat = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos : pos + 8])
+        body = data[pos + 8 : pos + 8 + length]
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"IDAT":
+            idat += body
+        pos += 12 + length
+    if depth != 8 or color_type != 2 or interlace != 0:
+        raise ValueError("%s: only 8-bit RGB, non-interlaced PNG is supported" % path)
+
+    raw = zlib.decompress(idat)
+    stride = width * 3
+    rgb = bytearray()
+    prev = bytearray(stride)
+    for y in range(height):
+        filter_type = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1 : (y + 1) * (stride + 1)])
+        for i in range(stride) if filter_type else ():
+            a = line[i - 3] if i >= 3 else 0
+            b = prev[i]
+            c = prev[i - 3] if i >= 3 else 0
+            if filter_type == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filter_type == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filter_type == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif filter_type == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        rgb += line
+        prev = line
+    return width, height, bytes(rgb)
+
+
+def write_png(path, width, height, rgb):
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body))
+
+    stride = width * 3
+    raw = b"".join(b"\x00" + rgb[y * stride : (y + 1) * stride] for y in range(height))
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+def write_diff(path, width, height, rgb, golden):
+    out = bytearray(len(rgb))
+    for i in range(0, len(rgb), 3):
+        if rgb[i : i + 3] != golden[i : i + 3]:
+            out[i : i + 3] = rgb[i : i + 3]
+        else:
+            out[i : i + 3] = bytes(v // 4 for v in golden[i : i + 3])
+    with open(path, "wb") as f:
+        f.write(b"P6\n%d %d\n255\n" % (width, height))
+        f.write(out)
+
+
+def compare(scene, work_dir, golden_path):
+    width, height, rgb = read_ppm(os.path.join(work_dir, scene + ".ppm"))
+    if not os.path.exists(golden_path):
+        return "no golden image"
+    golden_width, golden_height, golden = read_png(golden_path)
+    if (golden_width, golden_height) != (width, height):
+        return "size %dx%d, golden %dx%d" % (width, height, golden_width, golden_height)
+    if rgb == golden:
+        return None
+
+    mismatches = [i // 3 for i in range(0, len(rgb), 3) if rgb[i : i + 3] != golden[i : i + 3]]
+    write_diff(os.path.join(work_dir, scene + "_diff.ppm"), width, height, rgb, golden)
+    first = mismatches[0]
+    return "%d pixels differ, first at %d,%d" % (len(mismatches), first % width, first // width)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare lcd_bench output with the golden images")
+    parser.add_argument("bench", help="lcd_bench executable")
+    parser.add_argument("golden_dir", help="directory of <scene>.png golden images")
+    parser.add_argument("work_dir", help="directory for the lcd_bench output")
+    parser.add_argument("--iterations", type=int, default=16, help="calls drawn per scene")
+    parser.add_argument("--update", action="store_true", help="rewrite the golden images from this build")
+    args = parser.parse_args()
+
+    os.makedirs(args.work_dir, exist_ok=True)
+    for name in os.listdir(args.work_dir):
+        if name.endswith((".ppm", ".png")):
+            os.remove(os.path.join(args.work_dir, name))
+    subprocess.run([args.bench, "-n", str(args.iterations), "-o", args.work_dir], check=True,
+                   stdout=subprocess.DEVNULL)
+    scenes = sorted(name[:-4] for name in os.listdir(args.work_dir) if name.endswith(".ppm"))
+    if not scenes:
+        print("lcd_bench wrote no images", file=sys.stderr)
+        return 1
+
+    if args.update:
+        os.makedirs(args.golden_dir, exist_ok=True)
+        for scene in scenes:
+            width, height, rgb = read_ppm(os.path.join(args.work_dir, scene + ".ppm"))
+            write_png(os.path.join(args.golden_dir, scene + ".png"), width, height, rgb)
+        print("%d golden images written to %s" % (len(scenes), args.golden_dir))
+        return 0
+
+    failed = 0
+    for scene in scenes:
+        error = compare(scene, args.work_dir, os.path.join(args.golden_dir, scene + ".png"))
+        print("%-24s %s" % (scene, "FAIL, " + error if error else "ok"))
+        failed += error is not None
+    for name in sorted(os.listdir(args.golden_dir)):
+        if name.endswith(".png") and name[:-4] not in scenes:
+            print("%-24s FAIL, not drawn" % name[:-4])
+            failed += 1
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
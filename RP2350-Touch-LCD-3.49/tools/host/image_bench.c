@@ -0,0 +1,93 @@
+// Decode throughput of lcd image containers, using the null panel.
+//
+// Build and run from this directory:
+//   cc -O2 -DLCD_HOST_BUILD -I. -I../../src/SDK/lcd -I../../../common/lcd image_bench.c lcd_null.c
+//      ../../../common/lcd/lcd_*.c ../../../common/lcd/font*.c -lm -o image_bench
+//   ./image_bench [-n iterations] image.bin...
+// or with CMake, which builds the lcd_host library and all the benchmarks:
+//   cmake -S . -B build && cmake --build build && build/image_bench
+// Make the inputs with image_encode.py, e.g. once per --format to compare.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lcd.h"
+#include "lcd_image.h"
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint8_t *load(const char *path, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    rewind(f);
+    uint8_t *data = length > 0 ? malloc(length) : NULL;
+    if (data != NULL && fread(data, 1, length, f) != (size_t)length)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = length;
+    return data;
+}
+
+int main(int argc, char **argv)
+{
+    static const char *format_names[] = {"raw", "rle", "lz"};
+    int iterations = 200;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0)
+    {
+        iterations = atoi(argv[2]);
+        first = 3;
+    }
+    if (first >= argc)
+    {
+        fprintf(stderr, "usage: %s [-n iterations] image.bin...\n", argv[0]);
+        return 2;
+    }
+
+    lcd_init();
+    printf("LCD_COLOR_DEPTH=%d, %d iterations\n", LCD_COLOR_DEPTH, iterations);
+    printf("%-24s %6s %10s %8s %12s %12s %12s\n", "image", "format", "size", "ratio", "us/decode", "Mpixels/s",
+           "MB/s in");
+
+    for (int a = first; a < argc; a++)
+    {
+        size_t size;
+        uint16_t width, height;
+        uint8_t *data = load(argv[a], &size);
+        if (data == NULL || !lcd_image_info(data, size, &width, &height))
+        {
+            fprintf(stderr, "%s: not an lcd image\n", argv[a]);
+            free(data);
+            return 1;
+        }
+        if (!lcd_draw_image(0, 0, data, size, 0))
+        {
+            fprintf(stderr, "%s: does not decode on a %dx%d screen\n", argv[a], LCD_WIDTH, LCD_HEIGHT);
+            free(data);
+            return 1;
+        }
+
+        double start = now_us();
+        for (int i = 0; i < iterations; i++)
+            lcd_draw_image(0, 0, data, size, 0);
+        double per_call = (now_us() - start) / iterations;
+
+        uint32_t pixels = (uint32_t)width * height;
+        printf("%-24s %6s %10zu %7.1f%% %12.1f %12.1f %12.1f\n", argv[a], format_names[data[2]], size,
+               100.0 * size / pixels, per_call, pixels / per_call, size / per_call);
+        free(data);
+    }
+    return 0;
+}
@@ -0,0 +1,329 @@
+#!/usr/bin/env python3
+"""Encode a PNG or PPM image into the lcd image container (see lcd_image.h).
+
+Pixels are reduced to RGB332. With an alpha channel, pixels under 50%
+opacity become COLOR_TRANSPARENT so lcd_draw_image(..., LCD_BLIT_TRANSPARENT)
+skips them. Every encoding is decoded again and compared before it is
+written.
+
+    image_encode.py input.png output.h [--format auto|raw|rle|lz] [--name NAME]
+
+The output type follows the extension: .h writes a C array, .py a
+MicroPython bytes constant, anything else the raw container.
+"""
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"LI"
+RAW, RLE, LZ = 0, 1, 2
+FORMAT_NAMES = {"raw": RAW, "rle": RLE, "lz": LZ}
+
+TRANSPARENT_565 = 0x0120  # COLOR_TRANSPARENT in lcd.h
+TRANSPARENT_332 = ((TRANSPARENT_565 & 0xE000) >> 8) | ((TRANSPARENT_565 & 0x0700) >> 6) | ((TRANSPARENT_565 & 0x0018) >> 3)
+
+LZ_MIN_MATCH = 3
+LZ_WINDOW = 0xFFFF
+LZ_CHAIN = 32  # candidates tried per position
+
+
+def rgb_to_332(r, g, b):
+    return (r & 0xE0) | ((g & 0xE0) >> 3) | (b >> 6)
+
+
+def read_ppm(data):
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos : pos + 1].isspace():
+            pos += 1
+        if data[pos : pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        start = pos
+        while not data[pos : pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos])
+    if fields[0] != b"P6" or int(fields[3]) != 255:
+        raise ValueError("only 8-bit binary PPM (P6) is supported")
+    width, height = int(fields[1]), int(fields[2])
+    rgb = data[pos + 1 : pos + 1 + width * height * 3]
+    pixels = [rgb_to_332(rgb[i], rgb[i + 1], rgb[i + 2]) for i in range(0, len(rgb), 3)]
+    return width, height, pixels
+
+
+def read_png(data):
+    pos = 8
+    idat = b""
+    palette = alpha = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos : pos + 8])
+        body = data[pos + 8 : pos + 8 + length]
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = body
+        elif kind == b"tRNS":
+            alpha = body
+        elif kind == b"IDAT":
+            idat += body
+        pos += 12 + length
+    if depth != 8 or interlace != 0:
+        raise ValueError("only 8-bit, non-interlaced PNG is supported")
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        filter_type = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1 : (y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if filter_type == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filter_type == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filter_type == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif filter_type == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    pixels = []
+    for line in rows:
+        for x in range(width):
+            px = line[x * channels : (x + 1) * channels]
+            if color_type == 0:
+                r = g = b = px[0]
+                a = 255
+            elif color_type == 2:
+                r, g, b = px
+                a = 255
+            elif color_type == 3:
+                r, g, b = palette[px[0] * 3 : px[0] * 3 + 3]
+                a = alpha[px[0]] if alpha is not None and px[0] < len(alpha) else 255
+            elif color_type == 4:
+                r = g = b = px[0]
+                a = px[1]
+            else:
+                r, g, b, a = px
+            pixels.append(TRANSPARENT_332 if a < 128 else rgb_to_332(r, g, b))
+    return width, height, pixels
+
+
+def encode_rle(pixels):
+    out = bytearray()
+    i, n = 0, len(pixels)
+    literal_start = 0
+
+    def flush_literals(end):
+        start = literal_start
+        while start < end:
+            count = min(128, end - start)
+            out.append(count - 1)
+            out.extend(pixels[start : start + count])
+            start += count
+
+    while i < n:
+        run = 1
+        while i + run < n and run < 129 and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= 2:
+            flush_literals(i)
+            out.append(0x80 | (run - 2))
+            out.append(pixels[i])
+            i += run
+            literal_start = i
+        else:
+            i += 1
+    flush_literals(n)
+    return bytes(out)
+
+
+def lz_put_length(out, value):
+    value -= 15
+    while value >= 255:
+        out.append(255)
+        value -= 255
+    out.append(value)
+
+
+def encode_lz(pixels):
+    out = bytearray()
+    n = len(pixels)
+    head = {}
+    chain = [-1] * n
+
+    def insert(pos):
+        if pos + LZ_MIN_MATCH <= n:
+            key = bytes(pixels[pos : pos + LZ_MIN_MATCH])
+            chain[pos] = head.get(key, -1)
+            head[key] = pos
+
+    def emit(literal_start, literal_end, match, offset):
+        literals = literal_end - literal_start
+        token = (min(literals, 15) << 4) | (min(match - LZ_MIN_MATCH, 15) if match else 0)
+        out.append(token)
+        if literals >= 15:
+            lz_put_length(out, literals)
+        out.extend(pixels[literal_start:literal_end])
+        if match:
+            if match - LZ_MIN_MATCH >= 15:
+                lz_put_length(out, match - LZ_MIN_MATCH)
+            out.extend(struct.pack("<H", offset))
+
+    i = literal_start = 0
+    while i < n:
+        best_len = best_offset = 0
+        if i + LZ_MIN_MATCH <= n:
+            candidate = head.get(bytes(pixels[i : i + LZ_MIN_MATCH]), -1)
+            tries = LZ_CHAIN
+            while candidate >= 0 and i - candidate <= LZ_WINDOW and tries:
+                length = 0
+                while i + length < n and pixels[candidate + length] == pixels[i + length]:
+                    length += 1
+                if length > best_len:
+                    best_len, best_offset = length, i - candidate
+                candidate = chain[candidate]
+                tries -= 1
+        if best_len >= LZ_MIN_MATCH:
+            emit(literal_start, i, best_len, best_offset)
+            for p in range(i, i + best_len):
+                insert(p)
+            i += best_len
+            literal_start = i
+        else:
+            insert(i)
+            i += 1
+    if literal_start < n or not out:
+        emit(literal_start, n, 0, 0)
+    return bytes(out)
+
+
+def decode(container):
+    """Reference decoder, mirrors lcd_draw_image"""
+    fmt = container[2]
+    width, height = struct.unpack("<HH", container[4:8])
+    total = width * height
+    data = container[8:]
+    if fmt == RAW:
+        return list(data[:total])
+    out = []
+    p = 0
+    if fmt == RLE:
+        while len(out) < total:
+            control = data[p]
+            p += 1
+            if control & 0x80:
+                out.extend([data[p]] * ((control & 0x7F) + 2))
+                p += 1
+            else:
+                out.extend(data[p : p + control + 1])
+                p += control + 1
+        return out
+
+    def length(value):
+        nonlocal p
+        if value == 15:
+            while True:
+                extra = data[p]
+                p += 1
+                value += extra
+                if extra != 255:
+                    break
+        return value
+
+    while len(out) < total:
+        token = data[p]
+        p += 1
+        literals = length(token >> 4)
+        out.extend(data[p : p + literals])
+        p += literals
+        if len(out) == total:
+            break
+        match = length(token & 0x0F) + LZ_MIN_MATCH
+        offset = data[p] | (data[p + 1] << 8)
+        p += 2
+        for _ in range(match):
+            out.append(out[-offset])
+    return out
+
+
+def encode(width, height, pixels, fmt):
+    if fmt == RAW:
+        payload = bytes(pixels)
+    elif fmt == RLE:
+        payload = encode_rle(pixels)
+    else:
+        payload = encode_lz(pixels)
+    container = MAGIC + bytes([fmt, 0]) + struct.pack("<HH", width, height) + payload
+    if decode(container) != list(pixels):
+        raise RuntimeError("round trip failed")
+    return container
+
+
+def write_output(path, name, container):
+    ext = os.path.splitext(path)[1].lower()
+    if ext in (".h", ".py"):
+        lines = []
+        for i in range(0, len(container), 16):
+            lines.append(", ".join("0x%02X" % b for b in container[i : i + 16]) + ",")
+        with open(path, "w") as f:
+            if ext == ".h":
+                f.write("#pragma once\n#include <stdint.h>\n")
+                f.write("// %d bytes, lcd image container (lcd_image.h)\n" % len(container))
+                f.write("static const uint8_t %s[] =\n    {\n" % name)
+                f.writelines("        %s\n" % line for line in lines)
+                f.write("};\n")
+            else:
+                f.write("# %d bytes, lcd image container (lcd_image.h)\n" % len(container))
+                f.write("%s = bytes(\n    [\n" % name.upper())
+                f.writelines("        %s\n" % line for line in lines)
+                f.write("    ]\n)\n")
+    else:
+        with open(path, "wb") as f:
+            f.write(container)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Encode an image for lcd_draw_image")
+    parser.add_argument("input", help="PNG or binary PPM (P6) file")
+    parser.add_argument("output", help=".h, .py or binary output file")
+    parser.add_argument("--format", choices=["auto", "raw", "rle", "lz"], default="auto",
+                        help="payload encoding, auto picks the smallest")
+    parser.add_argument("--name", help="array name, defaults to the output file name")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    if data.startswith(b"\x89PNG"):
+        width, height, pixels = read_png(data)
+    else:
+        width, height, pixels = read_ppm(data)
+    if width > 0xFFFF or height > 0xFFFF:
+        raise ValueError("image too large")
+
+    if args.format == "auto":
+        candidates = [encode(width, height, pixels, fmt) for fmt in (RAW, RLE, LZ)]
+        container = min(candidates, key=len)
+    else:
+        container = encode(width, height, pixels, FORMAT_NAMES[args.format])
+
+    name = args.name or os.path.splitext(os.path.basename(args.output))[0]
+    write_output(args.output, name, container)
+    print("%s: %dx%d %s, %d bytes (raw %d, %.1f%%)" % (
+        args.output, width, height, [k for k, v in FORMAT_NAMES.items() if v == container[2]][0],
+        len(container), width * height, 100.0 * len(container) / (width * height)), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,376 @@
+// Host benchmark runner for the lcd drawing primitives, using the null panel.
+//
+// Build and run from this directory:
+//   cc -O2 -DLCD_HOST_BUILD -I. -I../../src/SDK/lcd -I../../../common/lcd lcd_bench.c lcd_null.c
+//      ../../../common/lcd/lcd_*.c ../../../common/lcd/font*.c -lm -o lcd_bench
+//   ./lcd_bench [-n iterations] [-o output_dir] [-f font.bin]
+// or with CMake, which builds the lcd_host library and all the benchmarks:
+//   cmake -S . -B build && cmake --build build && build/lcd_bench
+// The -D options below can be given to cc or to cmake.
+// Add -DLCD_COLOR_DEPTH=16 for the native RGB565 framebuffer, -DLCD_TILED=1
+// for the display list (drawing then only records, swap_full renders). With
+// -o, the panel is saved as <output_dir>/<primitive>.png (and .ppm) after
+// each run. Compare fill_rect with fill_rect_blend and fill_rect_blend_busy
+// for the cost of blending; the latter defeats the reuse of repeated pixels.
+// draw_text_font runs with -f, a raw container from font_compile.py.
+// swap_full_rotated is swap_full with the software rotation gather.
+// Add -DLCD_PROFILE=1 to print the driver's own counters after the runs.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lcd.h"
+#include "lcd_null.h"
+#include "lcd_sprite.h"
+#include "lcd_blend.h"
+#include "lcd_font.h"
+#include "lcd_profile.h"
+
+typedef struct
+{
+    const char *name;
+    void (*draw)(int i); // draws one call's worth, i varies the position
+    uint32_t pixels;     // pixels touched per call, 0 if not meaningful
+} bench_t;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint16_t bench_color(int i)
+{
+    return (uint16_t)(i * 0x9E37u + 0x1234u);
+}
+
+static void draw_pixel(int i)
+{
+    lcd_draw_pixel(i * 7 % LCD_WIDTH, i * 13 % LCD_HEIGHT, bench_color(i));
+}
+
+static void draw_line(int i)
+{
+    lcd_draw_line(i % LCD_WIDTH, 0, LCD_WIDTH - 1 - i % LCD_WIDTH, LCD_HEIGHT - 1, bench_color(i));
+}
+
+static void draw_rect(int i)
+{
+    lcd_draw_rect(i % 32, i % 64, 100, 100, bench_color(i));
+}
+
+static void fill_rect(int i)
+{
+    lcd_fill_rect(i % 32, i % 64, 100, 100, bench_color(i));
+}
+
+static void fill_rect_full_width(int i)
+{
+    lcd_fill_rect(0, i % 64, LCD_WIDTH, 100, bench_color(i));
+}
+
+static void draw_circle(int i)
+{
+    lcd_draw_circle(LCD_WIDTH / 2, 100 + i % 400, 50, bench_color(i));
+}
+
+static void fill_circle(int i)
+{
+    lcd_fill_circle(LCD_WIDTH / 2, 100 + i % 400, 50, bench_color(i));
+}
+
+static void draw_ring(int i)
+{
+    lcd_draw_ring(LCD_WIDTH / 2, 100 + i % 400, 80, 12, bench_color(i));
+}
+
+static void draw_arc(int i)
+{
+    lcd_draw_arc(LCD_WIDTH / 2, 100 + i % 400, 80, 12, -135, -135 + i % 270, bench_color(i));
+}
+
+static void fill_triangle(int i)
+{
+    lcd_fill_triangle(10, 20 + i % 300, LCD_WIDTH - 10, 120 + i % 300, 40, 220 + i % 300, bench_color(i));
+}
+
+static void fill_polygon(int i)
+{
+    // Concave arrow, partly off the left edge
+    const LcdPoint arrow[7] = {{-20, 0}, {100, 0}, {100, -40}, {170, 40}, {100, 120}, {100, 80}, {-20, 80}};
+    LcdPoint points[7];
+    for (int p = 0; p < 7; p++)
+    {
+        points[p].x = arrow[p].x;
+        points[p].y = arrow[p].y + 60 + i % 400;
+    }
+    lcd_fill_polygon(points, 7, bench_color(i));
+}
+
+static void draw_thick_line(int i)
+{
+    lcd_draw_thick_line(LCD_WIDTH / 2, LCD_HEIGHT / 2, i % LCD_WIDTH, 0, 6, bench_color(i));
+}
+
+static void draw_text(int i)
+{
+    lcd_set_font(FONT_MEDIUM);
+    lcd_draw_text(0, i % 600, "ACC X:+0.012 Y:-0.981", bench_color(i));
+}
+
+static uint8_t *bench_font;
+
+static void draw_text_font(int i)
+{
+    lcd_draw_text_font(0, i % 600, "ACC X:+0.012 Y:-0.981", bench_font, bench_color(i));
+}
+
+static const uint8_t *bench_image(void)
+{
+    static uint8_t image[64 * 64];
+    if (image[1] == 0)
+    {
+        for (int p = 0; p < 64 * 64; p++)
+            image[p] = p * 7;
+    }
+    return image;
+}
+
+static void blit(int i)
+{
+    lcd_blit(i % (LCD_WIDTH - 64), i % (LCD_HEIGHT - 64), 64, 64, bench_image());
+}
+
+static void blit_transparent_flip(int i)
+{
+    lcd_blit_ex(i % LCD_WIDTH - 32, i % LCD_HEIGHT - 32, 64, 64, bench_image(), LCD_BLIT_TRANSPARENT | LCD_BLIT_FLIP_X);
+}
+
+static void sprite_update(int i)
+{
+    // Eight 16x16 sprites over an 8x8 tilemap, one of them moving per call
+    static LcdTilemap tilemap;
+    static uint8_t map[8 * 8];
+    static int8_t ids[8];
+    if (i == 0)
+    {
+        for (int t = 0; t < 8 * 8; t++)
+            map[t] = t % 16;
+        tilemap = (LcdTilemap){bench_image(), map, 8, 8, 16, 16};
+        lcd_tilemap_set(&tilemap);
+        for (int s = 0; s < 8; s++)
+        {
+            ids[s] = lcd_sprite_add(bench_image(), 16, 16, LCD_BLIT_TRANSPARENT);
+            lcd_sprite_move(ids[s], s * 20, s * 70);
+        }
+    }
+    lcd_sprite_move(ids[i % 8], i % (LCD_WIDTH - 16), (i % 8) * 70);
+    lcd_sprite_update();
+}
+
+static void fill_rect_blend(int i)
+{
+    lcd_fill_rect_blend(i % 32, i % 64, 100, 100, bench_color(i), 128);
+}
+
+static void fill_rect_blend_busy(int i)
+{
+    // Same, over a background where neighboring pixels differ
+    if (i == 0)
+    {
+        for (int y = 0; y < LCD_HEIGHT; y += 64)
+            for (int x = 0; x < LCD_WIDTH; x += 64)
+                lcd_blit_ex(x, y, 64, 64, bench_image(), 0);
+    }
+    lcd_fill_rect_blend(i % 32, i % 64, 100, 100, bench_color(i), 128);
+}
+
+static const uint8_t *bench_mask(uint8_t format)
+{
+    // 64x64 soft disc
+    static uint8_t a8[64 * 64], a4[32 * 64];
+    if (a8[32 * 64 + 32] == 0)
+    {
+        for (int y = 0; y < 64; y++)
+        {
+            for (int x = 0; x < 64; x++)
+            {
+                int d2 = (x - 32) * (x - 32) + (y - 32) * (y - 32);
+                uint8_t level = d2 < 1024 ? 255 - d2 / 4 : 0;
+                a8[y * 64 + x] = level;
+                a4[y * 32 + x / 2] |= (x & 1) ? level >> 4 : level & 0xF0;
+            }
+        }
+    }
+    return format == LCD_ALPHA_A4 ? a4 : a8;
+}
+
+static void blit_alpha_a8(int i)
+{
+    lcd_blit_alpha(i % (LCD_WIDTH - 64), i % (LCD_HEIGHT - 64), 64, 64, bench_mask(LCD_ALPHA_A8), LCD_ALPHA_A8,
+                   bench_color(i));
+}
+
+static void blit_alpha_a4(int i)
+{
+    lcd_blit_alpha(i % (LCD_WIDTH - 64), i % (LCD_HEIGHT - 64), 64, 64, bench_mask(LCD_ALPHA_A4), LCD_ALPHA_A4,
+                   bench_color(i));
+}
+
+static void draw_line_aa(int i)
+{
+    lcd_draw_line_aa(i % LCD_WIDTH, 0, LCD_WIDTH - 1 - i % LCD_WIDTH, LCD_HEIGHT - 1, bench_color(i));
+}
+
+static void draw_circle_aa(int i)
+{
+    lcd_draw_circle_aa(LCD_WIDTH / 2, 100 + i % 400, 50, bench_color(i));
+}
+
+static void fill_circle_aa(int i)
+{
+    lcd_fill_circle_aa(LCD_WIDTH / 2, 100 + i % 400, 50, bench_color(i));
+}
+
+static void fill(int i)
+{
+    lcd_fill(bench_color(i));
+}
+
+static void swap_full(int i)
+{
+    (void)i;
+    lcd_invalidate();
+    lcd_swap();
+}
+
+// 180 degrees in tiled mode, which cannot rotate by 90
+static void swap_full_rotated(int i)
+{
+    (void)i;
+    if (!lcd_set_rotation(90))
+        lcd_set_rotation(180);
+    lcd_swap();
+    lcd_set_rotation(0);
+}
+
+static const bench_t benches[] = {
+    {"draw_pixel", draw_pixel, 1},
+    {"draw_line", draw_line, LCD_HEIGHT},
+    {"draw_rect", draw_rect, 396},
+    {"fill_rect", fill_rect, 100 * 100},
+    {"fill_rect_full_width", fill_rect_full_width, LCD_WIDTH * 100},
+    {"draw_circle", draw_circle, 0},
+    {"fill_circle", fill_circle, 7845},
+    {"draw_ring", draw_ring, 0},
+    {"draw_arc", draw_arc, 0},
+    {"fill_triangle", fill_triangle, 0},
+    {"fill_polygon", fill_polygon, 0},
+    {"draw_thick_line", draw_thick_line, 0},
+    {"draw_text", draw_text, 0},
+    {"draw_text_font", draw_text_font, 0},
+    {"blit", blit, 64 * 64},
+    {"blit_transparent_flip", blit_transparent_flip, 0},
+    {"sprite_update", sprite_update, 0},
+    {"fill_rect_blend", fill_rect_blend, 100 * 100},
+    {"fill_rect_blend_busy", fill_rect_blend_busy, 100 * 100},
+    {"blit_alpha_a8", blit_alpha_a8, 64 * 64},
+    {"blit_alpha_a4", blit_alpha_a4, 64 * 64},
+    {"draw_line_aa", draw_line_aa, 2 * LCD_HEIGHT},
+    {"draw_circle_aa", draw_circle_aa, 0},
+    {"fill_circle_aa", fill_circle_aa, 7845},
+    {"fill", fill, LCD_WIDTH * LCD_HEIGHT},
+    {"swap_full", swap_full, LCD_WIDTH * LCD_HEIGHT},
+    {"swap_full_rotated", swap_full_rotated, LCD_WIDTH * LCD_HEIGHT},
+};
+
+int main(int argc, char **argv)
+{
+    int iterations = 2000;
+    const char *output_dir = NULL;
+
+    for (int a = 1; a < argc; a++)
+    {
+        if (strcmp(argv[a], "-n") == 0 && a + 1 < argc)
+            iterations = atoi(argv[++a]);
+        else if (strcmp(argv[a], "-o") == 0 && a + 1 < argc)
+            output_dir = argv[++a];
+        else if (strcmp(argv[a], "-f") == 0 && a + 1 < argc)
+        {
+            const char *path = argv[++a];
+            FILE *f = fopen(path, "rb");
+            long size = 0;
+            if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) <= 0 ||
+                (bench_font = malloc(size)) == NULL || fseek(f, 0, SEEK_SET) != 0 ||
+                fread(bench_font, 1, size, f) != (size_t)size || lcd_font_height(bench_font) == 0)
+            {
+                fprintf(stderr, "cannot read font %s\n", path);
+                return 1;
+            }
+            fclose(f);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-n iterations] [-o output_dir] [-f font.bin]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    lcd_init();
+    printf("%dx%d, LCD_COLOR_DEPTH=%d, %d iterations\n", LCD_WIDTH, LCD_HEIGHT, LCD_COLOR_DEPTH, iterations);
+    printf("%-22s %12s %12s %14s\n", "primitive", "us/call", "calls/s", "Mpixels/s");
+
+    for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++)
+    {
+        const bench_t *bench = &benches[b];
+        if (bench->draw == draw_text_font && bench_font == NULL)
+            continue;
+
+        lcd_fill(COLOR_BLACK);
+        lcd_swap();
+
+        double start = now_us();
+        for (int i = 0; i < iterations; i++)
+            bench->draw(i);
+        lcd_fill_wait();
+        double elapsed_us = now_us() - start;
+
+        double per_call = elapsed_us / iterations;
+        printf("%-22s %12.3f %12.0f", bench->name, per_call, 1e6 / per_call);
+        if (bench->pixels)
+            printf(" %14.1f", bench->pixels / per_call);
+        printf("\n");
+
+        if (output_dir != NULL)
+        {
+            char path[512];
+            lcd_swap();
+            snprintf(path, sizeof(path), "%s/%s.png", output_dir, bench->name);
+            if (lcd_null_save_png(path) != 0)
+            {
+                fprintf(stderr, "cannot write %s\n", path);
+                return 1;
+            }
+            snprintf(path, sizeof(path), "%s/%s.ppm", output_dir, bench->name);
+            lcd_null_save_ppm(path);
+        }
+    }
+
+#if LCD_PROFILE
+    LcdProfile profile;
+    lcd_get_profile(&profile);
+    printf("\nprofile: %lu frames in %.3f s, %.1f fps\n", (unsigned long)profile.frames,
+           profile.elapsed_us / 1e6, profile.fps);
+    printf("%-22s %12s %12s %14s\n", "kind", "calls", "us/call", "pixels/call");
+    for (int k = 0; k < LCD_PROFILE_KINDS; k++)
+    {
+        const LcdProfileCounter *counter = &profile.counters[k];
+        if (counter->calls == 0)
+            continue;
+        printf("%-22s %12lu %12.3f %14.1f\n", lcd_profile_name(k), (unsigned long)counter->calls,
+               counter->cycles * 1e6 / profile.clock_hz / counter->calls, (double)counter->pixels / counter->calls);
+    }
+#endif
+    return 0;
+}
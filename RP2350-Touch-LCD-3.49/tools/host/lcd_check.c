@@ -0,0 +1,410 @@
+// Host checks of the lcd driver behaviour that the golden images of
+// lcd_bench do not pin down, run on the null panel:
+//   orientation  every rotation and mirror puts each pixel where a
+//                per-pixel reference says, and lcd_panel_to_screen inverts it
+//   scroll       a log scrolled with lcd_scroll shows the same screen as one
+//                drawn in place, sending only the exposed rows per step
+//   blend        lcd_fill_rect_blend matches per-channel rounding
+//   triangle     a triangle with vertices off-screen is sent in full by a
+//                partial swap, and one wholly off-screen sends nothing
+//   ring         the LCD_DUAL_CORE chunk ring, with a thread for each core,
+//                hands over every chunk in order and never refills a slot
+//                before it is released
+//
+// Built and run by ctest for each driver configuration, see CMakeLists.txt:
+//   cmake -S . -B build && cmake --build build && ctest --test-dir build
+// Exits with 1 when a check fails.
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "lcd.h"
+#include "lcd_null.h"
+#include "lcd_blend.h"
+#include "lcd_internal.h"
+#define LCD_RING_WAIT() sched_yield() // the threads may share one CPU
+#include "lcd_ring.h"
+
+static uint16_t screen[LCD_WIDTH * LCD_HEIGHT];
+static uint16_t reference[LCD_WIDTH * LCD_HEIGHT];
+
+static int report(const char *check, int errors)
+{
+    if (errors)
+        printf("%-24s FAIL, %d mismatches\n", check, errors);
+    else
+        printf("%-24s ok\n", check);
+    return errors != 0;
+}
+
+// Count differing pixels and print the first one
+static int compare_screen(const char *what)
+{
+    int errors = 0;
+    for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++)
+    {
+        if (screen[i] == reference[i])
+            continue;
+        if (errors++ == 0)
+            printf("  %s: first mismatch at %d,%d: %04X, expected %04X\n", what, i % LCD_WIDTH, i / LCD_WIDTH,
+                   screen[i], reference[i]);
+    }
+    return errors;
+}
+
+// RGB332 test pattern in panel coordinates, neighbours always differ
+static uint8_t pattern(int px, int py)
+{
+    return (uint8_t)(px * 37 + py * 101 + (py >> 2) * 7);
+}
+
+// Panel position of a drawing position: mirror within the rotated picture,
+// then turn it clockwise onto the panel
+static void view_to_panel(uint16_t degrees, bool mirror, int x, int y, int *px, int *py)
+{
+    const int view_width = (degrees % 180) ? LCD_HEIGHT : LCD_WIDTH;
+    if (mirror)
+        x = view_width - 1 - x;
+    switch (degrees)
+    {
+    case 90:
+        *px = LCD_WIDTH - 1 - y;
+        *py = x;
+        break;
+    case 180:
+        *px = LCD_WIDTH - 1 - x;
+        *py = LCD_HEIGHT - 1 - y;
+        break;
+    case 270:
+        *px = y;
+        *py = LCD_HEIGHT - 1 - x;
+        break;
+    default:
+        *px = x;
+        *py = y;
+        break;
+    }
+}
+
+/******************************************************************************
+function: Check every rotation and mirror against a per-pixel reference
+parameter: none
+returns: 1 on failure
+note: The pattern is drawn in each orientation so that, if the driver maps
+      it like view_to_panel, the panel shows what a plain draw at rotation
+      0 shows. Orientations the build cannot show (90 and 270 when tiled)
+      are skipped.
+******************************************************************************/
+static int check_orientation(void)
+{
+    static uint8_t image[LCD_WIDTH * LCD_HEIGHT];
+    int errors = 0;
+
+    for (int py = 0; py < LCD_HEIGHT; py++)
+        for (int px = 0; px < LCD_WIDTH; px++)
+            image[py * LCD_WIDTH + px] = pattern(px, py);
+    lcd_blit(0, 0, LCD_WIDTH, LCD_HEIGHT, image);
+    lcd_swap();
+    memcpy(reference, lcd_null_panel(), sizeof(reference));
+
+    for (uint16_t degrees = 0; degrees < 360; degrees += 90)
+    {
+        for (int mirror = 0; mirror < 2; mirror++)
+        {
+            char what[32];
+            snprintf(what, sizeof(what), "%u%s", degrees, mirror ? " mirrored" : "");
+            if (!lcd_set_rotation(degrees) || !lcd_set_mirror(mirror))
+            {
+                printf("  %s: not supported, skipped\n", what);
+                continue;
+            }
+
+            const int width = lcd_get_width(), height = lcd_get_height();
+            if (width != ((degrees % 180) ? LCD_HEIGHT : LCD_WIDTH) || width * height != LCD_WIDTH * LCD_HEIGHT)
+            {
+                printf("  %s: drawing area %dx%d\n", what, width, height);
+                errors++;
+                continue;
+            }
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    int px, py;
+                    view_to_panel(degrees, mirror, x, y, &px, &py);
+                    image[y * width + x] = pattern(px, py);
+                }
+            }
+            lcd_blit(0, 0, width, height, image);
+            lcd_swap();
+            memcpy(screen, lcd_null_panel(), sizeof(screen));
+            errors += compare_screen(what);
+
+            // Touch positions arrive in the panel frame
+            int touch_errors = 0;
+            for (int py = 0; py < LCD_HEIGHT; py++)
+            {
+                for (int px = 0; px < LCD_WIDTH; px++)
+                {
+                    uint16_t x = px, y = py;
+                    int back_x, back_y;
+                    lcd_panel_to_screen(&x, &y);
+                    view_to_panel(degrees, mirror, x, y, &back_x, &back_y);
+                    touch_errors += back_x != px || back_y != py;
+                }
+            }
+            if (touch_errors)
+                printf("  %s: %d touch positions mapped wrongly\n", what, touch_errors);
+            errors += touch_errors;
+        }
+    }
+    lcd_set_mirror(false);
+    lcd_set_rotation(0);
+    return report("orientation", errors);
+}
+
+#define SCROLL_FIXED 20 // rows of each fixed area
+#define SCROLL_STEP 20  // rows per log line
+#define SCROLL_LINES ((LCD_HEIGHT - 2 * SCROLL_FIXED) / SCROLL_STEP)
+
+static void scroll_draw_line(int n, uint16_t y)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "log line %d", n);
+    lcd_draw_text(4, y + 2, text, (uint16_t)(n * 0x9E37u + 0x1234u));
+}
+
+static void scroll_draw_fixed(void)
+{
+    lcd_fill_rect(0, 0, LCD_WIDTH, SCROLL_FIXED, COLOR_BLUE);
+    lcd_fill_rect(0, LCD_HEIGHT - SCROLL_FIXED, LCD_WIDTH, SCROLL_FIXED, COLOR_RED);
+}
+
+/******************************************************************************
+function: Check the hardware scroll against a log drawn in place
+parameter: none
+returns: 1 on failure
+note: The log runs through the ring more than twice, so the ring wraps at
+      every offset of a line.
+******************************************************************************/
+static int check_scroll(void)
+{
+    const int total = SCROLL_LINES * 5 / 2;
+    int errors = 0;
+
+    lcd_set_font(FONT_MEDIUM);
+    lcd_fill(COLOR_BLACK);
+    scroll_draw_fixed();
+    lcd_scroll_area(SCROLL_FIXED, SCROLL_FIXED);
+    lcd_swap();
+    for (int n = 0; n < total; n++)
+    {
+        lcd_scroll(SCROLL_STEP, COLOR_BLACK);
+        scroll_draw_line(n, lcd_scroll_row(LCD_HEIGHT - SCROLL_FIXED - SCROLL_STEP));
+        lcd_swap();
+        if (lcd_null_pixels_sent() != SCROLL_STEP * LCD_WIDTH)
+        {
+            if (errors++ == 0)
+                printf("  line %d: %lu pixels sent, expected %d\n", n, (unsigned long)lcd_null_pixels_sent(),
+                       SCROLL_STEP * LCD_WIDTH);
+        }
+    }
+    lcd_null_read_screen(screen);
+
+    // The same screen without scrolling
+    lcd_scroll_area(0, 0);
+    lcd_fill(COLOR_BLACK);
+    scroll_draw_fixed();
+    for (int row = 0; row < SCROLL_LINES; row++)
+        scroll_draw_line(total - SCROLL_LINES + row, SCROLL_FIXED + row * SCROLL_STEP);
+    lcd_swap();
+    lcd_null_read_screen(reference);
+    errors += compare_screen("scroll");
+    return report("scroll", errors);
+}
+
+// lcd_fill_rect_blend of color over dst with 8-bit alpha, one channel at a
+// time, rounded to the nearest
+static uint16_t blend_reference(uint16_t dst, uint16_t color, uint8_t alpha)
+{
+    static const int shifts[3] = {11, 5, 0}, masks[3] = {0x1F, 0x3F, 0x1F};
+    const int a = (alpha + 4) >> 3; // 33 levels, 0-32
+    uint16_t mixed = 0;
+    for (int c = 0; c < 3; c++)
+    {
+        int s = (color >> shifts[c]) & masks[c], d = (dst >> shifts[c]) & masks[c];
+        mixed |= ((s * a + d * (32 - a) + 16) >> 5) << shifts[c];
+    }
+    return mixed;
+}
+
+/******************************************************************************
+function: Check alpha blending against blend_reference
+parameter: none
+returns: 1 on failure
+note: Blends over all 256 RGB332 colors, one frame per alpha. The result is
+      rounded to the framebuffer format like any drawn color.
+******************************************************************************/
+static int check_blend(void)
+{
+    static const uint8_t alphas[] = {1, 4, 60, 128, 200, 251, 255};
+    static const uint16_t colors[] = {COLOR_WHITE, 0x8410, 0x1234, 0xF81F};
+    static uint8_t image[16 * 16];
+    uint16_t dst[256];
+    int errors = 0;
+
+    for (int i = 0; i < 256; i++)
+        image[i] = i;
+    lcd_fill(COLOR_BLACK);
+    lcd_blit(8, 8, 16, 16, image);
+    lcd_swap();
+    for (int i = 0; i < 256; i++)
+        dst[i] = lcd_null_panel()[(8 + i / 16) * LCD_WIDTH + 8 + i % 16];
+
+    for (size_t c = 0; c < sizeof(colors) / sizeof(colors[0]); c++)
+    {
+        for (size_t a = 0; a < sizeof(alphas); a++)
+        {
+            lcd_fill(COLOR_BLACK);
+            lcd_blit(8, 8, 16, 16, image);
+            lcd_fill_rect_blend(8, 8, 16, 16, colors[c], alphas[a]);
+            lcd_swap();
+
+            const uint16_t *panel = lcd_null_panel();
+            for (int i = 0; i < 256; i++)
+            {
+                uint16_t expected =
+                    lcd_pixel_to_color(lcd_color_to_pixel(blend_reference(dst[i], colors[c], alphas[a])));
+                uint16_t got = panel[(8 + i / 16) * LCD_WIDTH + 8 + i % 16];
+                if (got != expected && errors++ == 0)
+                    printf("  color %04X alpha %u over %02X: %04X, expected %04X\n", colors[c], alphas[a], i, got,
+                           expected);
+            }
+        }
+    }
+    return report("blend", errors);
+}
+
+/******************************************************************************
+function: Check that the dirty box of an off-screen triangle covers it
+parameter: none
+returns: 1 on failure
+note: Each triangle is sent by a partial swap over a black screen and
+      compared with the same frame sent in full after lcd_invalidate.
+******************************************************************************/
+static int check_triangle(void)
+{
+    static const int16_t triangles[][6] = {
+        {-10, 10, 50, 10, 20, 60},                                            // left edge
+        {20, -30, 90, 40, -40, 80},                                           // top left corner
+        {LCD_WIDTH - 30, 100, LCD_WIDTH + 40, 120, LCD_WIDTH - 10, 170},      // right edge
+        {100, LCD_HEIGHT - 20, 160, LCD_HEIGHT + 30, 60, LCD_HEIGHT + 10},    // bottom edge
+        {-300, -200, LCD_WIDTH + 300, 40, 30, LCD_HEIGHT + 200},              // across the screen
+    };
+    int errors = 0;
+
+    for (size_t t = 0; t < sizeof(triangles) / sizeof(triangles[0]); t++)
+    {
+        const int16_t *v = triangles[t];
+        lcd_fill(COLOR_BLACK);
+        lcd_swap();
+        lcd_fill_triangle(v[0], v[1], v[2], v[3], v[4], v[5], COLOR_GREEN);
+        lcd_swap();
+        lcd_null_read_screen(screen);
+
+        lcd_fill(COLOR_BLACK);
+        lcd_fill_triangle(v[0], v[1], v[2], v[3], v[4], v[5], COLOR_GREEN);
+        lcd_invalidate();
+        lcd_swap();
+        lcd_null_read_screen(reference);
+
+        int drawn = 0;
+        for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++)
+            drawn += reference[i] != COLOR_BLACK;
+        if (drawn == 0 && errors++ == 0)
+            printf("  triangle %u: nothing drawn\n", (unsigned)t);
+        errors += compare_screen("triangle");
+    }
+
+    uint32_t frames = lcd_null_frame_count();
+    lcd_fill_triangle(-50, -50, -10, -40, -30, -5, COLOR_GREEN);
+    lcd_fill_triangle(LCD_WIDTH + 10, 0, LCD_WIDTH + 90, 30, LCD_WIDTH + 20, 60, COLOR_GREEN);
+    lcd_swap();
+    if (lcd_null_frame_count() != frames && errors++ == 0)
+        printf("  off-screen triangles sent %lu pixels\n", (unsigned long)lcd_null_pixels_sent());
+    return report("triangle", errors);
+}
+
+// Chunk ring: the producer stands in for core1, main for the DMA IRQ
+#define RING_CHUNKS 50000
+#define RING_CHUNK_WORDS 64
+static uint32_t ring_buffers[LCD_RING_SLOTS][RING_CHUNK_WORDS];
+static lcd_ring_t ring;
+
+static void *ring_produce(void *arg)
+{
+    (void)arg;
+    for (uint32_t n = 0; n < RING_CHUNKS; n++)
+    {
+        uint32_t slot = lcd_ring_acquire(&ring);
+        for (int i = 0; i < RING_CHUNK_WORDS; i++)
+            ring_buffers[slot][i] = n;
+        lcd_ring_publish(&ring, ring_buffers[slot], RING_CHUNK_WORDS, (uint8_t)(n / 1000));
+    }
+    lcd_ring_acquire(&ring);
+    lcd_ring_publish(&ring, NULL, 0, (uint8_t)(RING_CHUNKS / 1000));
+    return NULL;
+}
+
+static int check_ring(void)
+{
+    pthread_t producer;
+    if (pthread_create(&producer, NULL, ring_produce, NULL) != 0)
+        return report("ring, no thread", 1);
+
+    int errors = 0;
+    uint32_t n = 0;
+    for (;;)
+    {
+        const lcd_ring_slot_t *slot = lcd_ring_peek(&ring);
+        if (slot->size == 0)
+            break;
+
+        // Read the chunk twice, as DMA would take a while over it
+        const volatile uint32_t *data = slot->data;
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (int i = 0; i < RING_CHUNK_WORDS; i++)
+            {
+                if (data[i] != n && errors++ == 0)
+                    printf("  chunk %u word %d: %u, overwritten or out of order\n", n, i, data[i]);
+            }
+        }
+        if (slot->area != (uint8_t)(n / 1000) && errors++ == 0)
+            printf("  chunk %u: region %u, expected %u\n", n, slot->area, n / 1000);
+        lcd_ring_release(&ring);
+        n++;
+    }
+    lcd_ring_release(&ring); // end of the frame
+    pthread_join(producer, NULL);
+
+    if (n != RING_CHUNKS && errors++ == 0)
+        printf("  %u chunks, expected %u\n", n, RING_CHUNKS);
+    if (ring.head != ring.tail && errors++ == 0)
+        printf("  ring not empty at the end\n");
+    return report("ring", errors);
+}
+
+int main(void)
+{
+    lcd_init();
+    printf("%dx%d, LCD_COLOR_DEPTH=%d, LCD_TILED=%d\n", LCD_WIDTH, LCD_HEIGHT, LCD_COLOR_DEPTH, LCD_TILED);
+
+    int failed = 0;
+    failed += check_orientation();
+    failed += check_scroll();
+    failed += check_blend();
+    failed += check_triangle();
+    failed += check_ring();
+    return failed ? 1 : 0;
+}
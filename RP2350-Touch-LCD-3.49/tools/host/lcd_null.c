@@ -0,0 +1,370 @@
+#include "lcd_null.h"
+#include "lcd_internal.h"
+#include "lcd_memset.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint16_t panel[LCD_WIDTH * LCD_HEIGHT]; // simulated panel RAM, host order RGB565
+static uint8_t backlight_level = LCD_DEFAULT_BRIGHTNESS;
+static uint32_t frame_count = 0;
+static uint32_t pixels_sent = 0;
+static uint64_t pixels_sent_total = 0;
+
+// Vertical scroll as set up by lcd_scroll_area/lcd_scroll, and as last
+// applied to the simulated panel by lcd_swap
+typedef struct
+{
+    uint16_t top, height, offset;
+} null_scroll_t;
+
+static null_scroll_t scroll = {0, LCD_HEIGHT, 0};
+static null_scroll_t shown_scroll = {0, LCD_HEIGHT, 0};
+
+/******************************************************************************
+function: Initialize the null panel
+parameter: none
+returns: none
+******************************************************************************/
+void lcd_init()
+{
+    lcd_palette_init(); // same palette as the board driver
+
+    memset(panel, 0, sizeof(panel));
+    scroll = shown_scroll = (null_scroll_t){0, LCD_HEIGHT, 0};
+    frame_count = 0;
+    pixels_sent = 0;
+    pixels_sent_total = 0;
+
+    lcd_set_font(LCD_DEFAULT_FONT_SIZE);
+    lcd_memset_init();
+    lcd_invalidate();
+    lcd_profile_init();
+}
+
+/******************************************************************************
+function: Copy the changed framebuffer regions into the simulated panel
+parameter: none
+returns: none
+******************************************************************************/
+void lcd_swap(void)
+{
+    dirty_area_t areas[LCD_MAX_DIRTY_AREAS];
+    uint8_t area_count = lcd_dirty_take(areas);
+#if LCD_TILED
+    lcd_tile_flip();
+#endif
+    shown_scroll = scroll; // the panel applies it after the regions
+    if (area_count == 0)
+        return;
+
+    pixels_sent = 0;
+#if LCD_PROFILE
+    const uint32_t profile_start = lcd_profile_now();
+#endif
+    for (uint8_t i = 0; i < area_count; i++)
+    {
+        // Panel rows, gathered from the framebuffer like the board driver does
+        dirty_area_t area;
+        lcd_transform_area(&areas[i], &area);
+        const int width = area.x1 - area.x0 + 1;
+        LCD_PROFILE_CHARGE(LCD_PROFILE_SWAP_CONVERT, (uint32_t)width * (area.y1 - area.y0 + 1));
+        for (int y = area.y0; y <= area.y1; y++)
+        {
+#if LCD_TILED
+            // One band at a time, as the board driver streams them
+            if ((y - area.y0) % LCD_TILE_LINES == 0)
+            {
+                int lines = area.y1 + 1 - y;
+                if (lines > LCD_TILE_LINES)
+                    lines = LCD_TILE_LINES;
+                int band_x0 = (lcd_transform & LCD_FLIP_X) ? LCD_WIDTH - 1 - area.x1 : area.x0;
+                int band_y = (lcd_transform & LCD_FLIP_Y) ? LCD_HEIGHT - y - lines : y;
+                lcd_tile_render(band_x0, band_x0 + width - 1, band_y, lines);
+            }
+#endif
+            int step;
+            const lcd_pixel_t *src = lcd_transform_row(area.x0, y, &step);
+            for (int x = 0; x < width; x++)
+                panel[y * LCD_WIDTH + area.x0 + x] = lcd_pixel_to_color(src[x * step]);
+        }
+        pixels_sent += width * (area.y1 - area.y0 + 1);
+    }
+    pixels_sent_total += pixels_sent;
+    frame_count++;
+#if LCD_PROFILE
+    lcd_profile_count(LCD_PROFILE_SWAP_TRANSFER, lcd_profile_now() - profile_start, pixels_sent);
+#endif
+}
+
+// Software rotation like the board driver; tiled mode cannot swap the axes
+bool lcd_panel_orient(uint8_t transform)
+{
+    if (LCD_TILED && (transform & LCD_SWAP_XY))
+        return false;
+    scroll = (null_scroll_t){0, LCD_HEIGHT, 0};
+    return true;
+}
+
+void lcd_swap_async(void)
+{
+    lcd_swap();
+}
+
+void lcd_swap_wait(void)
+{
+}
+
+bool lcd_swap_busy(void)
+{
+    return false;
+}
+
+void lcd_set_backlight_level(uint8_t brightness)
+{
+    backlight_level = brightness > 100 ? 100 : brightness;
+}
+
+uint8_t lcd_get_backlight_level(void)
+{
+    return backlight_level;
+}
+
+// Same ring mapping as the board driver, the scroll commands only take
+// effect on the simulated panel at the next lcd_swap. Only available at
+// rotation 0, as on the board.
+void lcd_scroll_area(uint16_t top_fixed, uint16_t bottom_fixed)
+{
+    if (lcd_transform != 0 || top_fixed + bottom_fixed >= LCD_HEIGHT)
+        return;
+    scroll = (null_scroll_t){top_fixed, LCD_HEIGHT - top_fixed - bottom_fixed, 0};
+}
+
+void lcd_scroll(int16_t lines, uint16_t fill_color)
+{
+    const int height = scroll.height;
+    if (lines == 0 || lcd_transform != 0)
+        return;
+
+    int exposed = lines > 0 ? lines : -lines;
+    if (exposed > height)
+        exposed = height;
+    scroll.offset = ((scroll.offset + lines) % height + height) % height;
+
+    int first_line = lines > 0 ? height - exposed : 0;
+    int ring_row = (scroll.offset + first_line) % height;
+    int run = exposed < height - ring_row ? exposed : height - ring_row;
+    lcd_fill_rect(0, scroll.top + ring_row, LCD_WIDTH, run, fill_color);
+    if (run < exposed)
+        lcd_fill_rect(0, scroll.top, LCD_WIDTH, exposed - run, fill_color);
+}
+
+static uint16_t null_scroll_row(const null_scroll_t *state, uint16_t line)
+{
+    if (line < state->top || line >= state->top + state->height)
+        return line;
+    return state->top + (state->offset + line - state->top) % state->height;
+}
+
+uint16_t lcd_scroll_row(uint16_t line)
+{
+    return null_scroll_row(&scroll, line);
+}
+
+// Raw controller access has nothing to talk to
+void lcd_write_cmd(uint8_t cmd)
+{
+    (void)cmd;
+}
+
+void lcd_write_data(uint8_t data)
+{
+    (void)data;
+}
+
+void lcd_write_data_16bit(uint16_t data)
+{
+    (void)data;
+}
+
+const uint16_t *lcd_null_panel(void)
+{
+    return panel;
+}
+
+uint32_t lcd_null_frame_count(void)
+{
+    return frame_count;
+}
+
+uint32_t lcd_null_pixels_sent(void)
+{
+    return pixels_sent;
+}
+
+uint64_t lcd_null_pixels_sent_total(void)
+{
+    return pixels_sent_total;
+}
+
+/******************************************************************************
+function: Copy the simulated panel as displayed
+parameter:
+    image : Destination, LCD_WIDTH * LCD_HEIGHT pixels
+returns: none
+note: Screen lines are mapped to panel RAM through the vertical scroll last
+      applied by lcd_swap.
+******************************************************************************/
+void lcd_null_read_screen(uint16_t *image)
+{
+    for (int y = 0; y < LCD_HEIGHT; y++)
+        memcpy(&image[y * LCD_WIDTH], &panel[null_scroll_row(&shown_scroll, y) * LCD_WIDTH],
+               LCD_WIDTH * sizeof(uint16_t));
+}
+
+/******************************************************************************
+function: Expand one displayed row to 8-bit RGB
+parameter:
+    rgb : Destination, LCD_WIDTH * 3 bytes
+    y   : Screen line, mapped to panel RAM through the vertical scroll
+returns: none
+******************************************************************************/
+static void null_row_to_rgb(uint8_t *rgb, int y)
+{
+    const uint16_t *row = &panel[null_scroll_row(&shown_scroll, y) * LCD_WIDTH];
+    for (int x = 0; x < LCD_WIDTH; x++)
+    {
+        uint16_t color = row[x];
+        uint8_t r5 = color >> 11, g6 = (color >> 5) & 0x3F, b5 = color & 0x1F;
+        *rgb++ = (r5 << 3) | (r5 >> 2);
+        *rgb++ = (g6 << 2) | (g6 >> 4);
+        *rgb++ = (b5 << 3) | (b5 >> 2);
+    }
+}
+
+/******************************************************************************
+function: Save the simulated panel as a binary PPM (P6) image
+parameter:
+    path : Output file
+returns: 0 on success, -1 on I/O error
+******************************************************************************/
+int lcd_null_save_ppm(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return -1;
+
+    uint8_t rgb[LCD_WIDTH * 3];
+    fprintf(f, "P6\n%d %d\n255\n", LCD_WIDTH, LCD_HEIGHT);
+    for (int y = 0; y < LCD_HEIGHT; y++)
+    {
+        null_row_to_rgb(rgb, y);
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+    int error = ferror(f);
+    return fclose(f) == 0 && !error ? 0 : -1;
+}
+
+static uint32_t png_crc(uint32_t crc, const uint8_t *data, size_t len)
+{
+    crc = ~crc;
+    while (len--)
+    {
+        crc ^= *data++;
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static void png_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void png_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len)
+{
+    uint8_t head[8];
+    png_put32(head, len);
+    memcpy(&head[4], type, 4);
+    uint32_t crc = png_crc(png_crc(0, &head[4], 4), data, len);
+    uint8_t tail[4];
+    png_put32(tail, crc);
+    fwrite(head, 1, 8, f);
+    if (len > 0)
+        fwrite(data, 1, len, f); // IEND has no data, and data is NULL then
+    fwrite(tail, 1, 4, f);
+}
+
+/******************************************************************************
+function: Save the simulated panel as an 8-bit RGB PNG image
+parameter:
+    path : Output file
+returns: 0 on success, -1 on I/O error
+note: The image data is written as uncompressed (stored) deflate blocks so
+      no zlib is needed. Files are larger than a real encoder would produce.
+******************************************************************************/
+int lcd_null_save_png(const char *path)
+{
+    enum
+    {
+        ROW_BYTES = 1 + LCD_WIDTH * 3, // filter byte + RGB
+        RAW_BYTES = ROW_BYTES * LCD_HEIGHT,
+        BLOCK_MAX = 65535,
+        BLOCKS = (RAW_BYTES + BLOCK_MAX - 1) / BLOCK_MAX,
+        IDAT_BYTES = 2 + BLOCKS * 5 + RAW_BYTES + 4,
+    };
+    static uint8_t raw[RAW_BYTES];
+    static uint8_t idat[IDAT_BYTES];
+
+    for (int y = 0; y < LCD_HEIGHT; y++)
+    {
+        raw[y * ROW_BYTES] = 0; // filter: none
+        null_row_to_rgb(&raw[y * ROW_BYTES + 1], y);
+    }
+
+    // zlib stream of stored blocks
+    uint8_t *p = idat;
+    *p++ = 0x78;
+    *p++ = 0x01;
+    uint32_t a = 1, b = 0;
+    for (size_t pos = 0; pos < RAW_BYTES; pos += BLOCK_MAX)
+    {
+        uint16_t len = RAW_BYTES - pos < BLOCK_MAX ? RAW_BYTES - pos : BLOCK_MAX;
+        *p++ = pos + len == RAW_BYTES; // BFINAL, BTYPE=00
+        *p++ = len;
+        *p++ = len >> 8;
+        *p++ = ~len;
+        *p++ = (uint16_t)~len >> 8;
+        memcpy(p, &raw[pos], len);
+        p += len;
+        for (size_t i = pos; i < pos + len; i++)
+        {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    png_put32(p, (b << 16) | a);
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return -1;
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t ihdr[13];
+    png_put32(&ihdr[0], LCD_WIDTH);
+    png_put32(&ihdr[4], LCD_HEIGHT);
+    ihdr[8] = 8;  // bit depth
+    ihdr[9] = 2;  // color type: RGB
+    ihdr[10] = 0; // deflate
+    ihdr[11] = 0; // adaptive filtering
+    ihdr[12] = 0; // no interlace
+
+    fwrite(signature, 1, sizeof(signature), f);
+    png_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+    png_chunk(f, "IDAT", idat, IDAT_BYTES);
+    png_chunk(f, "IEND", NULL, 0);
+    return fclose(f) == 0 ? 0 : -1;
+}
@@ -0,0 +1,32 @@
+// Host "null panel" backend for the lcd library. Implements the panel side of
+// lcd.h (init, swap, backlight, raw writes) on top of an in-memory RGB565
+// image so the drawing code in common/lcd can run and be inspected on a PC.
+#pragma once
+
+#include <stdint.h>
+#include "lcd.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Simulated panel RAM, LCD_WIDTH * LCD_HEIGHT RGB565 pixels in host order.
+    // Only regions flushed by lcd_swap are updated, like on the real panel.
+    const uint16_t *lcd_null_panel(void);
+
+    uint32_t lcd_null_frame_count(void);     // number of lcd_swap calls that sent something
+    uint32_t lcd_null_pixels_sent(void);     // pixels sent by the last such lcd_swap
+    uint64_t lcd_null_pixels_sent_total(void);
+
+    // Copy the simulated panel as displayed, with the vertical scroll
+    // applied, LCD_WIDTH * LCD_HEIGHT RGB565 pixels in host order
+    void lcd_null_read_screen(uint16_t *image);
+
+    // Write the simulated panel as displayed, with the vertical scroll
+    // applied, to an image file, 0 on success
+    int lcd_null_save_ppm(const char *path);
+    int lcd_null_save_png(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+# Copy the drivers into the Arduino IDE sketch of every board: the shared lcd
+# core from common/lcd and the sources of every module in the board's src/SDK.
+# The IDE only compiles the files in the sketch folder, so each sketch keeps
+# copies of these; run this from the repository root after changing them:
+#
+#   cmake -P common/lcd/arduino_sync.cmake
+#
+# The IDE has no pioasm either, so the sketches also keep the generated
+# <program>.pio.h of the board's PIO programs. They are regenerated when
+# pioasm is on the PATH (or given with -DPIOASM=<path>), and left as they are
+# otherwise.
+#
+# With -DCHECK=ON (before -P) nothing is written, and the script fails when a
+# sketch copy is out of date.
+cmake_minimum_required(VERSION 3.13)
+
+include(${CMAKE_CURRENT_LIST_DIR}/lcd_core.cmake)
+
+find_program(PIOASM pioasm)
+set(generated_dir ${CMAKE_CURRENT_BINARY_DIR}/arduino_sync)
+
+file(GLOB sketches LIST_DIRECTORIES true ${LCD_CORE_DIR}/../../*/examples/ArduinoIDE/test)
+
+set(stale "")
+foreach(sketch ${sketches})
+    get_filename_component(sketch ${sketch} REALPATH)
+    get_filename_component(sdk_dir ${sketch}/../../../src/SDK REALPATH)
+    file(GLOB board_files ${sdk_dir}/*/*.c ${sdk_dir}/*/*.h)
+    file(GLOB board_programs ${sdk_dir}/*/*.pio)
+
+    # Source path and the name of its copy in the sketch
+    set(shared_files "")
+    foreach(source ${LCD_CORE_HEADERS} ${LCD_CORE_SOURCES} ${board_files})
+        get_filename_component(name ${source} NAME)
+        list(APPEND shared_files "${source}|${name}")
+    endforeach()
+    foreach(program ${board_programs})
+        get_filename_component(name ${program} NAME)
+        if(NOT PIOASM)
+            message(STATUS "pioasm not found, ${sketch}/${name}.h left as it is")
+            continue()
+        endif()
+        file(MAKE_DIRECTORY ${generated_dir})
+        execute_process(COMMAND ${PIOASM} -o c-sdk ${program} ${generated_dir}/${name}.h
+                        RESULT_VARIABLE failed)
+        if(failed)
+            message(FATAL_ERROR "pioasm failed on ${program}")
+        endif()
+        list(APPEND shared_files "${generated_dir}/${name}.h|${name}.h")
+    endforeach()
+
+    foreach(entry ${shared_files})
+        string(REPLACE "|" ";" entry "${entry}")
+        list(GET entry 0 source)
+        list(GET entry 1 name)
+        set(copy ${sketch}/${name})
+        execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${source} ${copy}
+                        RESULT_VARIABLE differs OUTPUT_QUIET ERROR_QUIET)
+        if(NOT differs)
+            continue()
+        endif()
+        if(CHECK)
+            list(APPEND stale ${copy})
+        else()
+            message(STATUS "Updating ${copy}")
+            configure_file(${source} ${copy} COPYONLY)
+        endif()
+    endforeach()
+endforeach()
+
+if(stale)
+    string(REPLACE ";" "\n  " stale "${stale}")
+    message(FATAL_ERROR "Out of date, run cmake -P common/lcd/arduino_sync.cmake:\n  ${stale}")
+endif()
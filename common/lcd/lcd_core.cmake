@@ -0,0 +1,51 @@
+# Board-independent part of the lcd driver, shared by every board.
+#
+# A board supplies lcd.h, its panel descriptor (geometry, pins, bus speed,
+# LCD_CHUNK_LINES, LCD_DIRTY_ALIGN, LCD_PIXEL_BYTE_SWAP), and lcd.c with the
+# panel and bus driver. The core is compiled against that lcd.h, so it is
+# built into each board's library rather than on its own:
+#
+#   Pico SDK     add_library(lcd <board sources> ${LCD_CORE_SOURCES}), see src/SDK/lcd
+#   MicroPython  src/SDK/lcd sources + usermod_lcd_core, see src/MicroPython/waveshare_lcd
+#   Host         lcd_host, see RP2350-Touch-LCD-3.49/tools/host
+#   Arduino IDE  cmake -P common/lcd/arduino_sync.cmake, the IDE only builds the sketch folder
+include_guard(GLOBAL)
+
+set(LCD_CORE_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+# Framebuffer, drawing, display list and rotation code, the built-in fonts and
+# the profiling counters
+set(LCD_CORE_SOURCES
+    ${LCD_CORE_DIR}/font8.c
+    ${LCD_CORE_DIR}/font12.c
+    ${LCD_CORE_DIR}/font16.c
+    ${LCD_CORE_DIR}/font20.c
+    ${LCD_CORE_DIR}/font24.c
+    ${LCD_CORE_DIR}/lcd_profile.c
+    ${LCD_CORE_DIR}/lcd_blend.c
+    ${LCD_CORE_DIR}/lcd_draw.c
+    ${LCD_CORE_DIR}/lcd_expand.c
+    ${LCD_CORE_DIR}/lcd_font.c
+    ${LCD_CORE_DIR}/lcd_glyph.c
+    ${LCD_CORE_DIR}/lcd_image.c
+    ${LCD_CORE_DIR}/lcd_memset.c
+    ${LCD_CORE_DIR}/lcd_palette.c
+    ${LCD_CORE_DIR}/lcd_rotation.c
+    ${LCD_CORE_DIR}/lcd_sprite.c
+    ${LCD_CORE_DIR}/lcd_tile.c
+)
+file(GLOB LCD_CORE_HEADERS ${LCD_CORE_DIR}/*.h)
+
+# MicroPython user C module part, the whole core. Each board's waveshare_lcd
+# module adds its src/SDK/lcd driver and the Python bindings.
+if(TARGET usermod)
+    add_library(usermod_lcd_core INTERFACE)
+
+    target_sources(usermod_lcd_core INTERFACE
+        ${LCD_CORE_SOURCES}
+    )
+
+    target_include_directories(usermod_lcd_core INTERFACE
+        ${LCD_CORE_DIR}
+    )
+endif()
@@ -0,0 +1,124 @@
+#include "lcd_expand.h"
+
+#ifdef LCD_HOST_BUILD
+#define __not_in_flash_func(func_name) func_name
+#else
+#include "pico/platform.h"
+#endif
+
+/******************************************************************************
+function: Expand RGB332 palette indices into RGB565 pixels
+parameter:
+    dst     : Destination pixels (count entries)
+    src     : RGB332 palette indices (count entries)
+    count   : Number of pixels to expand
+    palette : 256-entry lookup table, already in panel byte order
+returns: none
+note: Reads the source one 32-bit word (4 pixels) at a time and, when the
+      destination is word aligned, stores pairs of pixels as 32-bit words.
+      Unaligned heads and tails are handled one pixel at a time. Lives in
+      RAM so the loop does not stall on XIP cache misses during a swap.
+******************************************************************************/
+void __not_in_flash_func(lcd_expand_rgb332)(uint16_t *dst, const uint8_t *src, size_t count, const uint16_t *palette)
+{
+    // Scalar head until the source is word aligned
+    while (count > 0 && ((uintptr_t)src & 3))
+    {
+        *dst++ = palette[*src++];
+        count--;
+    }
+
+    const uint32_t *src32 = (const uint32_t *)src;
+    size_t words = count >> 2;
+
+    if (((uintptr_t)dst & 3) == 0)
+    {
+        uint32_t *dst32 = (uint32_t *)dst;
+        while (words--)
+        {
+            // Little-endian: the lowest byte is the leftmost pixel
+            uint32_t pixels = *src32++;
+            dst32[0] = palette[pixels & 0xFF] | ((uint32_t)palette[(pixels >> 8) & 0xFF] << 16);
+            dst32[1] = palette[(pixels >> 16) & 0xFF] | ((uint32_t)palette[pixels >> 24] << 16);
+            dst32 += 2;
+        }
+        dst = (uint16_t *)dst32;
+    }
+    else
+    {
+        while (words--)
+        {
+            uint32_t pixels = *src32++;
+            dst[0] = palette[pixels & 0xFF];
+            dst[1] = palette[(pixels >> 8) & 0xFF];
+            dst[2] = palette[(pixels >> 16) & 0xFF];
+            dst[3] = palette[pixels >> 24];
+            dst += 4;
+        }
+    }
+
+    // Scalar tail
+    src = (const uint8_t *)src32;
+    count &= 3;
+    while (count--)
+        *dst++ = palette[*src++];
+}
+
+/******************************************************************************
+function: Expand strided RGB332 palette indices into RGB565 pixels
+parameter:
+    dst     : Destination pixels (count entries)
+    src     : First RGB332 palette index
+    count   : Number of pixels to expand
+    step    : Distance between consecutive source indices, may be negative
+    palette : 256-entry lookup table, already in panel byte order
+returns: none
+note: Used when the display is rotated in software, where a panel row is
+      a framebuffer column or a row read backwards. Unrolled by four.
+******************************************************************************/
+void __not_in_flash_func(lcd_expand_rgb332_step)(uint16_t *dst, const uint8_t *src, size_t count, ptrdiff_t step,
+                                                 const uint16_t *palette)
+{
+    for (; count >= 4; count -= 4)
+    {
+        dst[0] = palette[src[0]];
+        dst[1] = palette[src[step]];
+        dst[2] = palette[src[2 * step]];
+        dst[3] = palette[src[3 * step]];
+        dst += 4;
+        src += 4 * step;
+    }
+    while (count--)
+    {
+        *dst++ = palette[*src];
+        src += step;
+    }
+}
+
+/******************************************************************************
+function: Copy strided RGB565 pixels
+parameter:
+    dst   : Destination pixels (count entries)
+    src   : First source pixel
+    count : Number of pixels to copy
+    step  : Distance between consecutive source pixels, may be negative
+returns: none
+note: The 16-bit counterpart of lcd_expand_rgb332_step.
+******************************************************************************/
+void __not_in_flash_func(lcd_copy_rgb565_step)(uint16_t *dst, const uint16_t *src, size_t count, ptrdiff_t step)
+{
+    for (; count >= 4; count -= 4)
+    {
+        dst[0] = src[0];
+        dst[1] = src[step];
+        dst[2] = src[2 * step];
+        dst[3] = src[3 * step];
+        dst += 4;
+        src += 4 * step;
+    }
+    while (count--)
+    {
+        *dst++ = *src;
+        src += step;
+    }
+}
@@ -0,0 +1,65 @@
+// Sprites and tilemap backgrounds on top of the lcd framebuffer.
+//
+// Images are RGB332, one byte per pixel, row-major, the same format as
+// lcd_blit. Sprites live in a fixed table and are drawn in table order over
+// a background that is either a solid color or a scrolling tilemap.
+// lcd_sprite_update redraws only the regions that changed since the previous
+// call (moved or changed sprites, edited tiles) and marks them dirty for
+// the next lcd_swap.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lcd.h"
+
+#define LCD_MAX_SPRITES 16      // Entries in the sprite table
+#define LCD_SPRITE_MAX_DAMAGE 8 // Changed regions tracked between updates before they get merged
+
+// COLOR_TRANSPARENT reduced to RGB332, the color key used in image data
+#define LCD_TRANSPARENT_332 (((COLOR_TRANSPARENT & 0xE000) >> 8) | ((COLOR_TRANSPARENT & 0x0700) >> 6) | \
+                             ((COLOR_TRANSPARENT & 0x0018) >> 3))
+
+// lcd_blit_ex and sprite flags
+#define LCD_BLIT_TRANSPARENT 0x01 // Skip pixels equal to LCD_TRANSPARENT_332
+#define LCD_BLIT_FLIP_X 0x02      // Mirror left to right
+#define LCD_BLIT_FLIP_Y 0x04      // Mirror top to bottom
+
+// Tiled background. Tile n is the tile_width * tile_height pixels starting at
+// tiles + n * tile_width * tile_height. The map repeats in both directions.
+typedef struct
+{
+    const uint8_t *tiles;   // Tile images, RGB332, back to back
+    uint8_t *map;           // map_width * map_height tile numbers, row-major
+    uint16_t map_width;     // Map size in tiles
+    uint16_t map_height;
+    uint8_t tile_width;     // Tile size in pixels
+    uint8_t tile_height;
+} LcdTilemap;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // Blit with signed, clipped coordinates and LCD_BLIT_* flags
+    void lcd_blit_ex(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *buffer, uint8_t flags);
+
+    // Sprite table. Images are referenced, not copied, and must stay valid.
+    int8_t lcd_sprite_add(const uint8_t *image, uint16_t width, uint16_t height, uint8_t flags); // -1 when full
+    void lcd_sprite_remove(int8_t id);
+    void lcd_sprite_move(int8_t id, int16_t x, int16_t y);
+    void lcd_sprite_set_image(int8_t id, const uint8_t *image); // same size, e.g. the next animation frame
+    void lcd_sprite_set_flags(int8_t id, uint8_t flags);
+    void lcd_sprite_set_visible(int8_t id, bool visible);
+
+    // Background behind the sprites
+    void lcd_sprite_set_background(uint16_t color); // used when no tilemap is set
+    void lcd_tilemap_set(LcdTilemap *tilemap);      // NULL for the solid background
+    void lcd_tilemap_scroll(int16_t x, int16_t y);  // map pixel shown at the top-left corner
+    void lcd_tilemap_set_tile(uint16_t column, uint16_t row, uint8_t tile);
+
+    void lcd_sprite_invalidate(void); // redraw everything on the next update, e.g. after lcd_fill
+    void lcd_sprite_update(void);     // draw the changed regions into the framebuffer
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,141 @@
+# Check that every driver source has one home. The drivers live in common/lcd
+# and each board's src/SDK; the Pico SDK examples and the MicroPython modules
+# build them from there, and the Arduino IDE sketches keep copies that
+# arduino_sync.cmake refreshes. Fails when
+#   - a board tree has another file named like a driver source outside those
+#     places, which is a copy that drifts
+#   - a MicroPython module, in waveshare_modules.cmake, its own
+#     micropython.cmake or micropython.mk, leaves out a source of its
+#     src/SDK/<module> driver, or of LCD_CORE_SOURCES for waveshare_lcd
+#
+#   cmake -P common/lcd/source_check.cmake
+#
+# ctest of RP2350-Touch-LCD-3.49/tools/host runs it.
+cmake_minimum_required(VERSION 3.13)
+
+include(${CMAKE_CURRENT_LIST_DIR}/lcd_core.cmake)
+
+# Just enough of the target commands to read the sources the MicroPython
+# CMake files give each usermod_waveshare_<module> target; check_build keeps
+# the evaluated files of each board apart
+function(add_library)
+endfunction()
+function(pico_generate_pio_header)
+endfunction()
+function(target_include_directories)
+endfunction()
+function(target_compile_definitions)
+endfunction()
+function(target_sources target scope)
+    set_property(GLOBAL APPEND PROPERTY ${check_build}_${target} ${ARGN})
+endfunction()
+function(target_link_libraries target scope)
+    if(usermod_lcd_core IN_LIST ARGN)
+        set_property(GLOBAL APPEND PROPERTY ${check_build}_${target} ${LCD_CORE_SOURCES})
+    endif()
+endfunction()
+
+# Sources of a micropython.mk: the SRC_USERMOD lines with its := variables
+# and USERMOD_DIR put in
+function(read_make_sources file result)
+    get_filename_component(dir ${file} DIRECTORY)
+    file(STRINGS ${file} lines)
+    set(vars USERMOD_DIR)
+    set(value_USERMOD_DIR ${dir})
+    set(sources "")
+    foreach(line ${lines})
+        foreach(var ${vars})
+            string(REPLACE "$(${var})" "${value_${var}}" line "${line}")
+        endforeach()
+        if(line MATCHES "^([A-Z_]+) := (.*)$")
+            list(APPEND vars ${CMAKE_MATCH_1})
+            set(value_${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+        elseif(line MATCHES "^SRC_USERMOD \\+= (.*)$")
+            list(APPEND sources ${CMAKE_MATCH_1})
+        endif()
+    endforeach()
+    set(${result} ${sources} PARENT_SCOPE)
+endfunction()
+
+# Append to errors each required source missing from the listed ones
+function(check_listed what required listed)
+    set(listed_real "")
+    foreach(source ${listed})
+        get_filename_component(source ${source} REALPATH)
+        list(APPEND listed_real ${source})
+    endforeach()
+    foreach(source ${required})
+        get_filename_component(source ${source} REALPATH)
+        if(NOT source IN_LIST listed_real)
+            list(APPEND errors "${what}: ${source}")
+        endif()
+    endforeach()
+    set(errors ${errors} PARENT_SCOPE)
+endfunction()
+
+get_filename_component(repo_dir ${LCD_CORE_DIR}/../.. REALPATH)
+file(GLOB boards LIST_DIRECTORIES true ${repo_dir}/*/src/SDK)
+
+set(errors "")
+foreach(sdk_dir ${boards})
+    get_filename_component(board_dir ${sdk_dir}/../.. REALPATH)
+
+    set(driver_names "")
+    file(GLOB drivers ${sdk_dir}/*/*.c ${sdk_dir}/*/*.h ${sdk_dir}/*/*.pio)
+    foreach(source ${LCD_CORE_HEADERS} ${LCD_CORE_SOURCES} ${drivers})
+        get_filename_component(name ${source} NAME)
+        list(APPEND driver_names ${name})
+    endforeach()
+
+    file(GLOB_RECURSE sources RELATIVE ${board_dir} ${board_dir}/*.c ${board_dir}/*.h ${board_dir}/*.pio)
+    foreach(source ${sources})
+        if(source MATCHES "^src/SDK/" OR source MATCHES "^examples/ArduinoIDE/")
+            continue()
+        endif()
+        get_filename_component(name ${source} NAME)
+        list(FIND driver_names ${name} found)
+        if(found GREATER -1)
+            list(APPEND errors "${board_dir}/${source}")
+        endif()
+    endforeach()
+endforeach()
+
+if(errors)
+    string(REPLACE ";" "\n  " errors "${errors}")
+    message(FATAL_ERROR "Copies of driver sources, build them from src/SDK or common/lcd instead:\n  ${errors}")
+endif()
+
+foreach(sdk_dir ${boards})
+    get_filename_component(mp_dir ${sdk_dir}/../MicroPython REALPATH)
+    set(check_build ${mp_dir}/combined)
+    include(${mp_dir}/waveshare_modules.cmake)
+
+    file(GLOB modules LIST_DIRECTORIES true ${mp_dir}/waveshare_*)
+    foreach(module_dir ${modules})
+        if(NOT IS_DIRECTORY ${module_dir})
+            continue()
+        endif()
+        get_filename_component(target ${module_dir} NAME)
+        string(REGEX REPLACE "^waveshare_" "" module ${target})
+        file(GLOB required ${sdk_dir}/${module}/*.c)
+        if(module STREQUAL "lcd")
+            list(APPEND required ${LCD_CORE_SOURCES})
+        endif()
+
+        get_property(listed GLOBAL PROPERTY ${mp_dir}/combined_usermod_${target})
+        check_listed(${mp_dir}/waveshare_modules.cmake "${required}" "${listed}")
+
+        set(check_build ${module_dir})
+        include(${module_dir}/micropython.cmake)
+        get_property(listed GLOBAL PROPERTY ${module_dir}_usermod_${target})
+        check_listed(${module_dir}/micropython.cmake "${required}" "${listed}")
+
+        read_make_sources(${module_dir}/micropython.mk listed)
+        check_listed(${module_dir}/micropython.mk "${required}" "${listed}")
+    endforeach()
+endforeach()
+
+if(errors)
+    string(REPLACE ";" "\n  " errors "${errors}")
+    message(FATAL_ERROR "Driver sources left out of the MicroPython module:\n  ${errors}")
+endif()